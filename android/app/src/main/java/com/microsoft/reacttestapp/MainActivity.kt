@@ -27,6 +27,7 @@ import com.microsoft.reacttestapp.component.ComponentListAdapter
 import com.microsoft.reacttestapp.component.ComponentViewModel
 import com.microsoft.reacttestapp.manifest.Component
 import com.microsoft.reacttestapp.manifest.ManifestProvider
+import com.microsoft.reacttestapp.react.AppKeyTracker
 import com.microsoft.reacttestapp.react.AppRegistry
 import com.microsoft.reacttestapp.react.BundleSource
 
@@ -40,6 +41,7 @@ class MainActivity : ReactActivity() {
         HandlerCompat.createAsync(Looper.getMainLooper())
     }
 
+    private val appKeyTracker = AppKeyTracker()
     private lateinit var componentListAdapter: ComponentListAdapter
     private var isTopResumedActivity = false
 
@@ -81,11 +83,14 @@ class MainActivity : ReactActivity() {
                             override fun onReactContextInitialized(context: ReactContext) {
                                 (context as? ReactApplicationContext)?.runOnJSQueueThread {
                                     val appKeys = AppRegistry.getAppKeys(context)
+                                    val changes = appKeyTracker.update(appKeys)
                                     val viewModels = appKeys.map { appKey ->
                                         ComponentViewModel(appKey, appKey, null, null)
                                     }
                                     mainThreadHandler.post {
-                                        componentListAdapter.setComponents(viewModels)
+                                        if (changes.isNotEmpty()) {
+                                            componentListAdapter.applyChanges(viewModels, changes)
+                                        }
                                         if (isTopResumedActivity && viewModels.count() == 1) {
                                             startComponent(viewModels[0])
                                         }
@@ -121,6 +126,11 @@ class MainActivity : ReactActivity() {
         }
     }
 
+    override fun onDestroy() {
+        appKeyTracker.close()
+        super.onDestroy()
+    }
+
     override fun onTopResumedActivityChanged(isTopResumedActivity: Boolean) {
         super.onTopResumedActivityChanged(isTopResumedActivity)
         this.isTopResumedActivity = isTopResumedActivity
@@ -141,7 +151,11 @@ class MainActivity : ReactActivity() {
     }
 
     internal fun reloadJSFromServer(bundleURL: String) {
-        componentListAdapter.clear()
+        // With `AppRegistry`, the list is kept and updated once the new bundle
+        // has registered its components
+        if (!useAppRegistry) {
+            componentListAdapter.clear()
+        }
         testApp.reloadJSFromServer(this, bundleURL)
     }
 
@@ -157,9 +171,6 @@ class MainActivity : ReactActivity() {
     }
 
     private fun reload(bundleSource: BundleSource) {
-        if (useAppRegistry) {
-            componentListAdapter.clear()
-        }
         testApp.reactNativeHost.reload(this, bundleSource)
     }
 
@@ -7,7 +7,9 @@ import android.view.MenuItem
 import androidx.fragment.app.Fragment
 import com.facebook.react.ReactActivity
 import com.facebook.react.ReactActivityDelegate
+import com.facebook.react.bridge.ReactApplicationContext
 import com.microsoft.reacttestapp.BuildConfig
+import com.microsoft.reacttestapp.react.MemoryMonitor
 
 class ComponentActivity : ReactActivity() {
 
@@ -58,6 +60,18 @@ class ComponentActivity : ReactActivity() {
         } ?: loadApp(componentName)
     }
 
+    override fun onDestroy() {
+        val componentName = intent.extras?.getString(COMPONENT_NAME, null)
+        if (componentName != null && reactNativeHost.hasInstance()) {
+            val context = reactNativeHost.reactInstanceManager.currentReactContext
+            (context as? ReactApplicationContext)?.let {
+                MemoryMonitor.checkComponentMemory(it, componentName)
+            }
+        }
+
+        super.onDestroy()
+    }
+
     // Activity overrides
 
     override fun getSystemService(name: String): Any? {
@@ -7,6 +7,7 @@ import android.widget.TextView
 import androidx.annotation.UiThread
 import androidx.recyclerview.widget.RecyclerView
 import com.microsoft.reacttestapp.R
+import com.microsoft.reacttestapp.react.AppKeyTracker
 
 class ComponentListAdapter(
     private val layoutInflater: LayoutInflater,
@@ -14,6 +15,29 @@ class ComponentListAdapter(
     private val listener: (ComponentViewModel, Int) -> Unit
 ) : RecyclerView.Adapter<ComponentListAdapter.ComponentViewHolder>() {
 
+    /**
+     * Replaces the list with [components], notifying only the items affected
+     * by [changes]. Falls back to a full refresh if [changes] do not apply to
+     * the current list.
+     */
+    @UiThread
+    fun applyChanges(components: List<ComponentViewModel>, changes: List<AppKeyTracker.Change>) {
+        val removed = changes.count { it is AppKeyTracker.Change.Remove }
+        val inserted = changes.size - removed
+        if (this.components.size != components.size - inserted + removed) {
+            setComponents(components)
+            return
+        }
+
+        this.components = components
+        changes.forEach { change ->
+            when (change) {
+                is AppKeyTracker.Change.Insert -> notifyItemInserted(change.index)
+                is AppKeyTracker.Change.Remove -> notifyItemRemoved(change.index)
+            }
+        }
+    }
+
     @UiThread
     fun clear() {
         val itemCount = components.size
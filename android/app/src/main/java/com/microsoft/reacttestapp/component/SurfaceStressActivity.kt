@@ -0,0 +1,120 @@
+package com.microsoft.reacttestapp.component
+
+import android.os.Bundle
+import android.util.Log
+import android.view.ViewTreeObserver
+import android.widget.GridLayout
+import android.widget.ScrollView
+import com.facebook.react.ReactActivity
+import com.facebook.react.ReactRootView
+import com.microsoft.reacttestapp.BuildConfig
+import com.microsoft.reacttestapp.react.SurfaceStress
+import com.microsoft.reacttestapp.testApp
+
+/**
+ * Mounts one component on many surfaces at once, sharing one React instance,
+ * and logs the mount time of each surface and the memory they take up:
+ *
+ *     adb shell am start -n com.microsoft.reacttestapp/.component.SurfaceStressActivity \
+ *         --ei surfaces 16 --es component <slug or app key>
+ *
+ * The first component in the manifest is mounted if none is specified.
+ */
+class SurfaceStressActivity : ReactActivity() {
+
+    companion object {
+        private const val TAG = "SurfaceStress"
+        private const val EXTRA_COMPONENT = "component"
+        private const val EXTRA_SURFACES = "surfaces"
+        private const val DEFAULT_SURFACES = 8
+        private const val SURFACE_SIZE_DP = 120
+    }
+
+    private val rootViews = mutableListOf<ReactRootView>()
+    private var surfaceStress: SurfaceStress? = null
+
+    override fun onCreate(savedInstanceState: Bundle?) {
+        super.onCreate(savedInstanceState)
+
+        // Surfaces are started through `ReactInstanceManager`, which is not
+        // used in bridgeless mode
+        if (BuildConfig.REACTAPP_USE_BRIDGELESS) {
+            Log.e(TAG, "Surface stress mode is not available in bridgeless mode")
+            finish()
+            return
+        }
+
+        val requested = intent.getStringExtra(EXTRA_COMPONENT)
+        val components = testApp.manifest.components ?: listOf()
+        val component = if (requested == null) {
+            components.firstOrNull()
+        } else {
+            components.find { it.slug == requested || it.appKey == requested }
+        }
+        val appKey = component?.appKey ?: requested
+        if (appKey == null) {
+            Log.e(TAG, "No component to mount")
+            finish()
+            return
+        }
+
+        val surfaces = intent.getIntExtra(EXTRA_SURFACES, DEFAULT_SURFACES).coerceAtLeast(1)
+        title = "$appKey × $surfaces"
+
+        val size = (SURFACE_SIZE_DP * resources.displayMetrics.density).toInt()
+        val grid = GridLayout(this).apply {
+            columnCount = (resources.displayMetrics.widthPixels / size).coerceAtLeast(1)
+        }
+        setContentView(ScrollView(this).apply { addView(grid) })
+
+        // Create the tracker last so that setting up the activity is not measured
+        val tracker = SurfaceStress(component?.slug ?: appKey, surfaces)
+        surfaceStress = tracker
+
+        val reactInstanceManager = reactNativeHost.reactInstanceManager
+        repeat(surfaces) { surface ->
+            val rootView = ReactRootView(this)
+            rootView.setIsFabric(BuildConfig.REACTAPP_USE_FABRIC)
+
+            // The root view gets its first child once the component has mounted
+            rootView.viewTreeObserver.addOnGlobalLayoutListener(
+                object : ViewTreeObserver.OnGlobalLayoutListener {
+                    override fun onGlobalLayout() {
+                        if (rootView.childCount > 0) {
+                            rootView.viewTreeObserver.removeOnGlobalLayoutListener(this)
+                            tracker.onMounted(surface)?.let { Log.i(TAG, it) }
+                        }
+                    }
+                }
+            )
+
+            grid.addView(
+                rootView,
+                GridLayout.LayoutParams().apply {
+                    width = size
+                    height = size
+                }
+            )
+            rootView.startReactApplication(
+                reactInstanceManager,
+                appKey,
+                component?.initialProperties
+            )
+            rootViews.add(rootView)
+        }
+    }
+
+    override fun onDestroy() {
+        // Surfaces that have not mounted yet are reported as such
+        surfaceStress?.let {
+            it.finish()?.let { result -> Log.i(TAG, result) }
+            it.close()
+        }
+        surfaceStress = null
+
+        rootViews.forEach { it.unmountReactApplication() }
+        rootViews.clear()
+
+        super.onDestroy()
+    }
+}
@@ -13,6 +13,7 @@ data class Component(
     val initialProperties: Bundle?,
     val presentationStyle: String?,
     val slug: String?,
+    val bundleSegment: String?,
 )
 
 data class Manifest(
@@ -22,4 +23,5 @@ data class Manifest(
     val bundleRoot: String?,
     val singleApp: String?,
     val components: List<Component>?,
+    val engine: Bundle?,
 )
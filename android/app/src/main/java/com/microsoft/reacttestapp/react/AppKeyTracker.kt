@@ -0,0 +1,55 @@
+package com.microsoft.reacttestapp.react
+
+import com.facebook.soloader.SoLoader
+import java.io.Closeable
+
+/**
+ * Tracks the app keys registered in `AppRegistry` across reloads, so that only
+ * the components that actually changed need to be updated.
+ *
+ * The corresponding C++ implementation is in `android/app/src/main/jni/AppKeyTracker.cpp`
+ */
+class AppKeyTracker : Closeable {
+    companion object {
+        init {
+            SoLoader.loadLibrary("reacttestapp_appmodules")
+        }
+    }
+
+    sealed class Change {
+        data class Insert(val index: Int) : Change()
+        data class Remove(val index: Int) : Change()
+    }
+
+    private var handle = create()
+
+    /**
+     * Replaces the tracked app keys and returns the changes that turn the
+     * previous list into [appKeys]: removals first, from the highest index
+     * down, then insertions from the lowest index up.
+     */
+    @Synchronized
+    fun update(appKeys: Array<String>): List<Change> {
+        if (handle == 0L) {
+            return listOf()
+        }
+
+        return update(handle, appKeys).map {
+            if (it >= 0) Change.Insert(it) else Change.Remove(-it - 1)
+        }
+    }
+
+    @Synchronized
+    override fun close() {
+        if (handle != 0L) {
+            destroy(handle)
+            handle = 0L
+        }
+    }
+
+    private external fun create(): Long
+
+    private external fun destroy(handle: Long)
+
+    private external fun update(handle: Long, appKeys: Array<String>): IntArray
+}
@@ -0,0 +1,48 @@
+package com.microsoft.reacttestapp.react
+
+import android.util.Log
+import com.facebook.react.bridge.ReactApplicationContext
+import com.facebook.soloader.SoLoader
+
+/**
+ * The corresponding C++ implementation is in `android/app/src/main/jni/MemoryMonitor.cpp`
+ */
+class MemoryMonitor {
+    companion object {
+        private const val TAG = "MemoryMonitor"
+
+        init {
+            SoLoader.loadLibrary("reacttestapp_appmodules")
+        }
+
+        /**
+         * Records the JS heap size and native RSS high-water mark after
+         * [component] was presented. If a memory budget was set with
+         * `adb shell setprop debug.reacttestapp.jsheapbudget <MB>` or
+         * `debug.reacttestapp.rssbudget <MB>` and is exceeded, a heap snapshot
+         * is written to the app's cache directory.
+         */
+        fun checkComponentMemory(context: ReactApplicationContext, component: String) {
+            val snapshotDirectory = context.cacheDir.absolutePath
+            context.runOnJSQueueThread {
+                val jsContext = context.javaScriptContextHolder?.get()
+                if (jsContext == null || jsContext == 0L) {
+                    return@runOnJSQueueThread
+                }
+
+                val snapshot = MemoryMonitor().checkComponentMemory(
+                    jsContext,
+                    component,
+                    snapshotDirectory
+                ) ?: return@runOnJSQueueThread
+                Log.w(TAG, "$component exceeded its memory budget; heap snapshot: $snapshot")
+            }
+        }
+    }
+
+    private external fun checkComponentMemory(
+        jsiPtr: Long,
+        component: String,
+        snapshotDirectory: String
+    ): String?
+}
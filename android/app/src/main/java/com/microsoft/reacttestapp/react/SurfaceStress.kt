@@ -0,0 +1,51 @@
+package com.microsoft.reacttestapp.react
+
+import com.facebook.soloader.SoLoader
+import java.io.Closeable
+
+/**
+ * Collects mount times and memory while [component] is mounted on [surfaces]
+ * surfaces at once. Surfaces are expected to be created right after this
+ * object. Results are returned as JSON.
+ *
+ * The corresponding C++ implementation is in `android/app/src/main/jni/SurfaceStress.cpp`
+ */
+class SurfaceStress(component: String, surfaces: Int) : Closeable {
+    companion object {
+        init {
+            SoLoader.loadLibrary("reacttestapp_appmodules")
+        }
+    }
+
+    private var handle = create(component, surfaces)
+
+    /**
+     * Reports that [surface] has mounted. Returns the result once every
+     * surface has mounted.
+     */
+    @Synchronized
+    fun onMounted(surface: Int): String? = if (handle == 0L) null else onMounted(handle, surface)
+
+    /**
+     * Ends the run before every surface has mounted. Returns the result
+     * unless the run had already completed.
+     */
+    @Synchronized
+    fun finish(): String? = if (handle == 0L) null else finish(handle)
+
+    @Synchronized
+    override fun close() {
+        if (handle != 0L) {
+            destroy(handle)
+            handle = 0L
+        }
+    }
+
+    private external fun create(component: String, surfaces: Int): Long
+
+    private external fun destroy(handle: Long)
+
+    private external fun onMounted(handle: Long, surface: Int): String?
+
+    private external fun finish(handle: Long): String?
+}
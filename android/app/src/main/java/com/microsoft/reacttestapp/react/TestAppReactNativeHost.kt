@@ -8,6 +8,7 @@ import android.content.Intent
 import android.net.Uri
 import android.os.Bundle
 import com.facebook.hermes.reactexecutor.HermesExecutorFactory
+import com.facebook.hermes.reactexecutor.RuntimeConfig
 import com.facebook.react.PackageList
 import com.facebook.react.ReactInstanceManager
 import com.facebook.react.ReactPackage
@@ -20,6 +21,7 @@ import com.microsoft.reacttestapp.MainActivity
 import com.microsoft.reacttestapp.R
 import com.microsoft.reacttestapp.compat.ReactInstanceEventListener
 import com.microsoft.reacttestapp.compat.ReactNativeHostCompat
+import com.microsoft.reacttestapp.testApp
 import java.lang.ref.WeakReference
 import java.util.Collections.synchronizedList
 import java.util.concurrent.CountDownLatch
@@ -48,6 +50,21 @@ class TestAppReactNativeHost(
     application: Application,
     private val reactBundleNameProvider: ReactBundleNameProvider
 ) : ReactNativeHostCompat(application) {
+
+    companion object {
+        // Little-endian encoding of Hermes' bytecode file magic, 0x1F1903C103BC1FC6
+        private val HERMES_BYTECODE_MAGIC = byteArrayOf(
+            0xC6.toByte(),
+            0x1F,
+            0xBC.toByte(),
+            0x03,
+            0xC1.toByte(),
+            0x03,
+            0x19,
+            0x1F
+        )
+    }
+
     val jsExecutorName: String
         get() = javaScriptExecutorFactory.toString()
 
@@ -160,6 +177,19 @@ class TestAppReactNativeHost(
         val reactInstanceManager = super.createReactInstanceManager()
         addCustomDevOptions(reactInstanceManager.devSupportManager)
 
+        val engine = application.testApp.manifest.engine
+        if (engine != null) {
+            // Every reload creates new threads, so the policies must be
+            // applied to each new context
+            reactInstanceManager.addReactInstanceEventListener(
+                object : ReactInstanceEventListener {
+                    override fun onReactContextInitialized(context: ReactContext) {
+                        ThreadPolicy.applyTo(context, engine)
+                    }
+                }
+            )
+        }
+
         synchronized(reactInstanceEventListeners) {
             val i = reactInstanceEventListeners.iterator()
             while (i.hasNext()) {
@@ -170,14 +200,32 @@ class TestAppReactNativeHost(
         return reactInstanceManager
     }
 
-    override fun getJavaScriptExecutorFactory(): JavaScriptExecutorFactory = HermesExecutorFactory()
+    override fun getJavaScriptExecutorFactory(): JavaScriptExecutorFactory {
+        // Hermes only exposes the maximum heap size through `RuntimeConfig`;
+        // the remaining engine settings cannot be applied on Android.
+        val maxHeapSizeMB = application.testApp.manifest.engine?.getInt("maxHeapSizeMB") ?: 0
+        if (maxHeapSizeMB <= 0) {
+            return HermesExecutorFactory()
+        }
+
+        val config = RuntimeConfig()
+        config.heapSizeMB = maxHeapSizeMB.toLong()
+        return HermesExecutorFactory(config)
+    }
 
     override fun getJSMainModuleName() = "index"
 
     // We may not always have (or need) a JS bundle, but
     // `ReactNativeHost.createReactInstanceManager` asserts it so we need to
     // return something.
-    override fun getBundleAssetName() = reactBundleNameProvider.bundleName ?: "main.android.bundle"
+    override fun getBundleAssetName(): String {
+        val bundleName = reactBundleNameProvider.bundleName ?: return "main.android.bundle"
+        val bytecodeOnly = application.testApp.manifest.engine?.getBoolean("bytecodeOnly") ?: false
+        if (bytecodeOnly && source == BundleSource.Disk && !isHermesBytecode(bundleName)) {
+            error("'$bundleName' is not Hermes bytecode, but 'engine.bytecodeOnly' is set")
+        }
+        return bundleName
+    }
 
     override fun getUseDeveloperSupport() = source == BundleSource.Server
 
@@ -201,6 +249,12 @@ class TestAppReactNativeHost(
         }
     }
 
+    private fun isHermesBytecode(assetName: String): Boolean {
+        val header = ByteArray(HERMES_BYTECODE_MAGIC.size)
+        val length = application.assets.open(assetName).use { it.read(header) }
+        return length == header.size && header.contentEquals(HERMES_BYTECODE_MAGIC)
+    }
+
     private fun isPackagerRunning(context: Context): Boolean {
         if (!hasInstance()) {
             // Return early otherwise we will get in an initialization loop.
@@ -0,0 +1,54 @@
+package com.microsoft.reacttestapp.react
+
+import android.os.Bundle
+import android.util.Log
+import com.facebook.react.bridge.ReactContext
+import com.facebook.soloader.SoLoader
+
+/**
+ * The corresponding C++ implementation is in `android/app/src/main/jni/ThreadPolicy.cpp`
+ */
+class ThreadPolicy {
+    companion object {
+        private const val TAG = "ThreadPolicy"
+
+        init {
+            SoLoader.loadLibrary("reacttestapp_appmodules")
+        }
+
+        /**
+         * Applies the `jsThread` and `nativeModulesThread` scheduling policies
+         * from the `engine` section of the app manifest to the threads of
+         * [context].
+         */
+        fun applyTo(context: ReactContext, engine: Bundle?) {
+            engine?.getBundle("jsThread")?.let { policy ->
+                context.runOnJSQueueThread { applyToCurrentThread("JS", policy) }
+            }
+            engine?.getBundle("nativeModulesThread")?.let { policy ->
+                context.runOnNativeModulesQueueThread {
+                    applyToCurrentThread("native modules", policy)
+                }
+            }
+        }
+
+        private fun applyToCurrentThread(thread: String, policy: Bundle) {
+            @Suppress("DEPRECATION")
+            val affinity = (policy.getSerializable("affinity") as? ArrayList<*>)
+                ?.filterIsInstance<Int>()
+                ?.toIntArray()
+            val failures = ThreadPolicy().applyToCurrentThread(
+                policy.getString("priority"),
+                policy.getString("qos"),
+                affinity
+            )
+            failures.forEach { Log.w(TAG, "Failed to apply $thread thread policy: $it") }
+        }
+    }
+
+    private external fun applyToCurrentThread(
+        priority: String?,
+        qos: String?,
+        affinity: IntArray?
+    ): Array<String>
+}
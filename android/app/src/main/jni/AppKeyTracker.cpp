@@ -0,0 +1,56 @@
+#include "AppKeyTracker.h"
+
+#include <string>
+#include <vector>
+
+#include "common/AppKeyDiff.h"
+
+using ReactTestApp::AppKeyChange;
+using ReactTestApp::AppKeyTracker;
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL Java_com_microsoft_reacttestapp_react_AppKeyTracker_create(JNIEnv *,
+                                                                                   jobject)
+{
+    return reinterpret_cast<jlong>(new AppKeyTracker);
+}
+
+JNIEXPORT void JNICALL Java_com_microsoft_reacttestapp_react_AppKeyTracker_destroy(JNIEnv *,
+                                                                                   jobject,
+                                                                                   jlong handle)
+{
+    delete reinterpret_cast<AppKeyTracker *>(handle);
+}
+
+JNIEXPORT jintArray JNICALL Java_com_microsoft_reacttestapp_react_AppKeyTracker_update(
+    JNIEnv *env, jobject, jlong handle, jobjectArray appKeys)
+{
+    auto numKeys = env->GetArrayLength(appKeys);
+    std::vector<std::string> keys;
+    keys.reserve(numKeys);
+    for (jsize i = 0; i < numKeys; ++i) {
+        auto appKey = static_cast<jstring>(env->GetObjectArrayElement(appKeys, i));
+        auto chars = env->GetStringUTFChars(appKey, nullptr);
+        keys.emplace_back(chars);
+        env->ReleaseStringUTFChars(appKey, chars);
+        env->DeleteLocalRef(appKey);
+    }
+
+    // Insertions are encoded as their index, removals as `-(index + 1)`
+    auto tracker = reinterpret_cast<AppKeyTracker *>(handle);
+    auto changes = tracker->Update(std::move(keys));
+    std::vector<jint> encoded;
+    encoded.reserve(changes.size());
+    for (auto &&change : changes) {
+        auto index = static_cast<jint>(change.index);
+        encoded.push_back(change.kind == AppKeyChange::Kind::Insert ? index : -(index + 1));
+    }
+
+    auto numChanges = static_cast<jsize>(encoded.size());
+    auto result = env->NewIntArray(numChanges);
+    env->SetIntArrayRegion(result, 0, numChanges, encoded.data());
+    return result;
+}
+
+}  // extern "C"
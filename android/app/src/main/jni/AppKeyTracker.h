@@ -0,0 +1,20 @@
+#ifndef ANDROID_JNI_APPKEYTRACKER_
+#define ANDROID_JNI_APPKEYTRACKER_
+
+#include <jni.h>
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL Java_com_microsoft_reacttestapp_react_AppKeyTracker_create(JNIEnv *env,
+                                                                                   jobject thiz);
+
+JNIEXPORT void JNICALL Java_com_microsoft_reacttestapp_react_AppKeyTracker_destroy(JNIEnv *env,
+                                                                                   jobject thiz,
+                                                                                   jlong handle);
+
+JNIEXPORT jintArray JNICALL Java_com_microsoft_reacttestapp_react_AppKeyTracker_update(
+    JNIEnv *env, jobject thiz, jlong handle, jobjectArray appKeys);
+
+}  // extern "C"
+
+#endif  // ANDROID_JNI_APPKEYTRACKER_
@@ -1,6 +1,8 @@
 #include "AppRegistry.h"
 
 #include "common/AppRegistry.h"
+#include "common/LiveObjects.h"
+#include "common/Metrics.h"
 
 extern "C" {
 
@@ -8,6 +10,9 @@ JNIEXPORT jobjectArray JNICALL Java_com_microsoft_reacttestapp_react_AppRegistry
     JNIEnv *env, jclass clazz, jlong jsiPtr)
 {
     auto runtime = reinterpret_cast<facebook::jsi::Runtime *>(jsiPtr);
+    ReactTestApp::TrackRuntimeLifetime(*runtime);
+    ReactTestApp::InstallMetrics(*runtime);
+
     auto appKeys = ReactTestApp::GetAppKeys(*runtime);
     auto numKeys = static_cast<int>(appKeys.size());
     auto result = env->NewObjectArray(numKeys, env->FindClass("java/lang/String"), nullptr);
@@ -10,12 +10,18 @@
 #include <CoreComponentsRegistry.h>
 #endif  // __has_include(<react/fabric/CoreComponentsRegistry.h>)
 
+#include <chrono>
+
+#include <android/log.h>
+
 #include <DefaultComponentsRegistry.h>
 
 #include <react/renderer/componentregistry/ComponentDescriptorProviderRegistry.h>
 #include <react/renderer/componentregistry/ComponentDescriptorRegistry.h>
 #include <react/renderer/components/rncore/ComponentDescriptors.h>
 
+#include "common/MemoryMonitor.h"
+
 using facebook::react::ComponentDescriptorParameters;
 using facebook::react::ComponentDescriptorProviderRegistry;
 using facebook::react::ComponentDescriptorRegistry;
@@ -26,6 +32,15 @@ using facebook::react::EventDispatcher;
 using facebook::react::UnimplementedNativeViewComponentDescriptor;
 using ReactTestApp::ComponentsRegistry;
 
+namespace
+{
+    long long ResidentKilobytes()
+    {
+        auto memory = ReactTestApp::SampleProcessMemory();
+        return memory ? static_cast<long long>(memory->residentBytes / 1024) : 0;
+    }
+}  // namespace
+
 void ComponentsRegistry::registerNatives()
 {
     registerHybrid({makeNativeMethod("initHybrid", ComponentsRegistry::initHybrid)});
@@ -49,6 +64,12 @@ ComponentsRegistry::initHybrid(facebook::jni::alias_ref<jclass>, ComponentFactor
         -> ComponentDescriptorRegistry::Shared {
         auto providerRegistry = CoreComponentsRegistry::sharedProviderRegistry();
 
+        // Descriptors capture the event dispatcher and context container at
+        // construction, so every call builds a new registry; only log what
+        // that costs
+        auto const residentBefore = ResidentKilobytes();
+        auto const start = std::chrono::steady_clock::now();
+
         auto registry = providerRegistry->createComponentDescriptorRegistry(
             {eventDispatcher, contextContainer});
 
@@ -58,6 +79,14 @@ ComponentsRegistry::initHybrid(facebook::jni::alias_ref<jclass>, ComponentFactor
             std::make_shared<UnimplementedNativeViewComponentDescriptor>(
                 ComponentDescriptorParameters{eventDispatcher, contextContainer, nullptr}));
 
+        auto const duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        __android_log_print(ANDROID_LOG_INFO,
+                            "ReactTestApp",
+                            "Built component descriptor registry in %lld us (RSS %+lld KiB)",
+                            static_cast<long long>(duration.count()),
+                            ResidentKilobytes() - residentBefore);
+
         return registry;
     };
 
@@ -0,0 +1,49 @@
+#include "MemoryMonitor.h"
+
+#include <string>
+
+#include <sys/system_properties.h>
+
+#include "common/MemoryMonitor.h"
+
+namespace
+{
+    std::string GetString(JNIEnv *env, jstring str)
+    {
+        auto chars = env->GetStringUTFChars(str, nullptr);
+        std::string result{chars};
+        env->ReleaseStringUTFChars(str, chars);
+        return result;
+    }
+
+    ReactTestApp::MemoryBudget const &GetMemoryBudget()
+    {
+        static auto const budget = [] {
+            char jsHeap[PROP_VALUE_MAX] = {};
+            __system_property_get("debug.reacttestapp.jsheapbudget", jsHeap);
+            char resident[PROP_VALUE_MAX] = {};
+            __system_property_get("debug.reacttestapp.rssbudget", resident);
+            return ReactTestApp::MemoryBudget::Parse(jsHeap, resident);
+        }();
+        return budget;
+    }
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jstring JNICALL
+Java_com_microsoft_reacttestapp_react_MemoryMonitor_checkComponentMemory(JNIEnv *env,
+                                                                         jclass,
+                                                                         jlong jsiPtr,
+                                                                         jstring component,
+                                                                         jstring snapshotDirectory)
+{
+    auto runtime = reinterpret_cast<facebook::jsi::Runtime *>(jsiPtr);
+    auto snapshot = ReactTestApp::CheckComponentMemory(*runtime,
+                                                       GetString(env, component),
+                                                       GetMemoryBudget(),
+                                                       GetString(env, snapshotDirectory));
+    return snapshot.has_value() ? env->NewStringUTF(snapshot->c_str()) : nullptr;
+}
+
+}  // extern "C"
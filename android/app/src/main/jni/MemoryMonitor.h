@@ -0,0 +1,17 @@
+#ifndef ANDROID_JNI_MEMORYMONITOR_
+#define ANDROID_JNI_MEMORYMONITOR_
+
+#include <jni.h>
+
+extern "C" {
+
+JNIEXPORT jstring JNICALL
+Java_com_microsoft_reacttestapp_react_MemoryMonitor_checkComponentMemory(JNIEnv *env,
+                                                                         jclass clazz,
+                                                                         jlong jsiPtr,
+                                                                         jstring component,
+                                                                         jstring snapshotDirectory);
+
+}  // extern "C"
+
+#endif  // ANDROID_JNI_MEMORYMONITOR_
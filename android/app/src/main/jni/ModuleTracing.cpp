@@ -0,0 +1,423 @@
+#include "ModuleTracing.h"
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include <android/log.h>
+#include <android/trace.h>
+#include <sys/system_properties.h>
+
+#include <jsi/jsi.h>
+
+#include "common/CallStats.h"
+#include "common/LiveObjects.h"
+#include "common/ModuleTrace.h"
+
+using facebook::jsi::Function;
+using facebook::jsi::PropNameID;
+using facebook::jsi::Runtime;
+using facebook::jsi::Value;
+using facebook::react::CallInvoker;
+using facebook::react::TurboModule;
+using ReactTestApp::CallStats;
+using ReactTestApp::ModuleTraceReplayer;
+using ReactTestApp::ModuleTraceWriter;
+
+namespace
+{
+    struct ModuleTraceConfig {
+        std::shared_ptr<ModuleTraceWriter> writer;
+        std::shared_ptr<ModuleTraceReplayer> replayer;
+    };
+
+    std::string GetSystemProperty(char const *name)
+    {
+        char value[PROP_VALUE_MAX] = {};
+        __system_property_get(name, value);
+        return value;
+    }
+
+    ModuleTraceConfig const &GetModuleTraceConfig()
+    {
+        static ModuleTraceConfig const config = [] {
+            ModuleTraceConfig result;
+
+            constexpr std::string_view kRecord = "record:";
+            constexpr std::string_view kReplay = "replay:";
+            auto const value = GetSystemProperty("debug.reacttestapp.moduletrace");
+            std::string_view mode{value};
+            if (mode.substr(0, kRecord.size()) == kRecord) {
+                auto writer =
+                    std::make_shared<ModuleTraceWriter>(std::string{mode.substr(kRecord.size())});
+                if (writer->IsOpen()) {
+                    result.writer = std::move(writer);
+                } else {
+                    __android_log_print(ANDROID_LOG_WARN,
+                                        "ReactTestApp",
+                                        "Failed to open module trace for recording: %s",
+                                        value.c_str() + kRecord.size());
+                }
+            } else if (mode.substr(0, kReplay.size()) == kReplay) {
+                auto replayer = std::make_shared<ModuleTraceReplayer>();
+                if (replayer->Load(std::string{mode.substr(kReplay.size())})) {
+                    result.replayer = std::move(replayer);
+                } else {
+                    // Modules are not replayed, so make sure the run is not
+                    // mistaken for a replay
+                    __android_log_print(ANDROID_LOG_ERROR,
+                                        "ReactTestApp",
+                                        "Failed to load module trace, calling modules instead: %s",
+                                        value.c_str() + kReplay.size());
+                }
+            }
+
+            return result;
+        }();
+        return config;
+    }
+
+    /**
+     * Call statistics shared by all instrumented modules of a React instance.
+     * The statistics are written to disk when the last module goes away,
+     * i.e. when the instance is torn down or reloaded.
+     */
+    class ModuleStatsSession
+    {
+    public:
+        explicit ModuleStatsSession(std::string path) : path_(std::move(path))
+        {
+        }
+
+        ~ModuleStatsSession()
+        {
+            std::ofstream(path_, std::ios::trunc) << stats_.DumpJSON();
+        }
+
+        CallStats &Stats()
+        {
+            return stats_;
+        }
+
+        bool SizesArguments() const
+        {
+            static bool const enabled =
+                GetSystemProperty("debug.reacttestapp.modulestats.args") == "1";
+            return enabled;
+        }
+
+        static std::shared_ptr<ModuleStatsSession> Get()
+        {
+            static auto const path = GetSystemProperty("debug.reacttestapp.modulestats");
+            if (path.empty()) {
+                return nullptr;
+            }
+
+            static std::mutex mutex;
+            static std::weak_ptr<ModuleStatsSession> current;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto session = current.lock();
+            if (session == nullptr) {
+                session = std::make_shared<ModuleStatsSession>(path);
+                current = session;
+            }
+            return session;
+        }
+
+    private:
+        std::string path_;
+        CallStats stats_;
+    };
+
+    using MethodFunction = std::shared_ptr<Function>;
+
+    /**
+     * Forwards everything to the wrapped module, but lets subclasses intercept
+     * method calls.
+     */
+    class ForwardingTurboModule : public TurboModule
+    {
+    public:
+        ForwardingTurboModule(std::string const &name,
+                              std::shared_ptr<CallInvoker> const &jsInvoker,
+                              std::shared_ptr<TurboModule> module)
+            : TurboModule(name, jsInvoker), module_(std::move(module))
+        {
+        }
+
+        Value get(Runtime &runtime, PropNameID const &propName) override
+        {
+            // Wrappers are created once per method; like `TurboModule`'s own
+            // JS representation, they are held until the module goes away,
+            // which React Native does before tearing down the runtime
+            auto method = propName.utf8(runtime);
+            auto cached = wrappers_.find(method);
+            if (cached != wrappers_.end()) {
+                return Value(runtime, cached->second);
+            }
+
+            auto value = module_->get(runtime, propName);
+            if (!value.isObject() || !value.getObject(runtime).isFunction(runtime)) {
+                return value;
+            }
+
+            auto function =
+                std::make_shared<Function>(value.getObject(runtime).getFunction(runtime));
+            auto wrapper = Wrap(runtime, propName, method, std::move(function));
+            Value result(runtime, wrapper);
+            wrappers_.emplace(std::move(method), std::move(wrapper));
+            return result;
+        }
+
+        void set(Runtime &runtime, PropNameID const &name, Value const &value) override
+        {
+            wrappers_.erase(name.utf8(runtime));
+            module_->set(runtime, name, value);
+        }
+
+        std::vector<PropNameID> getPropertyNames(Runtime &runtime) override
+        {
+            return module_->getPropertyNames(runtime);
+        }
+
+    protected:
+        std::shared_ptr<TurboModule> module_;
+
+        virtual Function Wrap(Runtime &,
+                              PropNameID const &propName,
+                              std::string method,
+                              MethodFunction function) = 0;
+
+    private:
+        std::unordered_map<std::string, Function> wrappers_;
+    };
+
+    class RecordingTurboModule : public ForwardingTurboModule
+    {
+    public:
+        RecordingTurboModule(std::string const &name,
+                             std::shared_ptr<CallInvoker> const &jsInvoker,
+                             std::shared_ptr<TurboModule> module,
+                             std::shared_ptr<ModuleTraceWriter> writer)
+            : ForwardingTurboModule(name, jsInvoker, std::move(module)), writer_(std::move(writer))
+        {
+        }
+
+    protected:
+        Function Wrap(Runtime &runtime,
+                      PropNameID const &propName,
+                      std::string method,
+                      MethodFunction function) override
+        {
+            return Function::createFromHostFunction(
+                runtime,
+                propName,
+                0,
+                [writer = writer_, module = name_, method = std::move(method), function](
+                    Runtime &runtime, Value const &, Value const *args, size_t count) -> Value {
+                    using namespace ReactTestApp::ModuleTrace;
+
+                    std::string encodedArgs;
+                    EncodeValues(runtime, args, count, encodedArgs);
+
+                    auto const start = std::chrono::steady_clock::now();
+                    auto result = function->call(runtime, args, count);
+                    auto const duration = std::chrono::steady_clock::now() - start;
+
+                    std::string encodedResult;
+                    EncodeValue(runtime, result, encodedResult);
+                    auto seq =
+                        writer->RecordCall(module, method, encodedArgs, encodedResult, duration);
+
+                    if (encodedResult.front() == kPromise) {
+                        // Record the resolved value once the promise settles. Rejections are
+                        // not recorded; those calls fall through to the real module on replay.
+                        auto promise = result.getObject(runtime);
+                        auto onFulfilled = Function::createFromHostFunction(
+                            runtime,
+                            PropNameID::forAscii(runtime, "onFulfilled"),
+                            1,
+                            [writer, seq, start](
+                                Runtime &runtime, Value const &, Value const *args, size_t count) {
+                                std::string encoded;
+                                EncodeValue(
+                                    runtime, count > 0 ? args[0] : Value::undefined(), encoded);
+                                writer->RecordResolve(
+                                    seq, encoded, std::chrono::steady_clock::now() - start);
+                                return Value::undefined();
+                            });
+                        auto onRejected = Function::createFromHostFunction(
+                            runtime,
+                            PropNameID::forAscii(runtime, "onRejected"),
+                            1,
+                            [](Runtime &, Value const &, Value const *, size_t) {
+                                return Value::undefined();
+                            });
+                        promise.getPropertyAsFunction(runtime, "then")
+                            .callWithThis(runtime, promise, onFulfilled, onRejected);
+                    }
+
+                    return result;
+                });
+        }
+
+    private:
+        std::shared_ptr<ModuleTraceWriter> writer_;
+    };
+
+    class ReplayingTurboModule : public ForwardingTurboModule
+    {
+    public:
+        ReplayingTurboModule(std::string const &name,
+                             std::shared_ptr<CallInvoker> const &jsInvoker,
+                             std::shared_ptr<TurboModule> module,
+                             std::shared_ptr<ModuleTraceReplayer> replayer)
+            : ForwardingTurboModule(name, jsInvoker, std::move(module)),
+              replayer_(std::move(replayer))
+        {
+        }
+
+    protected:
+        Function Wrap(Runtime &runtime,
+                      PropNameID const &propName,
+                      std::string method,
+                      MethodFunction function) override
+        {
+            return Function::createFromHostFunction(
+                runtime,
+                propName,
+                0,
+                [replayer = replayer_, module = name_, method = std::move(method), function](
+                    Runtime &runtime, Value const &, Value const *args, size_t count) -> Value {
+                    using namespace ReactTestApp::ModuleTrace;
+
+                    std::string encodedArgs;
+                    EncodeValues(runtime, args, count, encodedArgs);
+
+                    // Calls that weren't recorded, or whose results can't be reproduced, are
+                    // forwarded to the real module
+                    auto call = replayer->Next(module, method, encodedArgs);
+                    if (!call.has_value() || call->result.front() == kUnsupported) {
+                        return function->call(runtime, args, count);
+                    }
+
+                    if (call->result.front() != kPromise) {
+                        std::string_view result = call->result;
+                        return DecodeValue(runtime, result);
+                    }
+
+                    if (!call->resolution.has_value()) {
+                        return function->call(runtime, args, count);
+                    }
+
+                    std::string_view resolution = *call->resolution;
+                    auto promise = runtime.global().getPropertyAsObject(runtime, "Promise");
+                    return promise.getPropertyAsFunction(runtime, "resolve")
+                        .callWithThis(runtime, promise, DecodeValue(runtime, resolution));
+                });
+        }
+
+    private:
+        std::shared_ptr<ModuleTraceReplayer> replayer_;
+    };
+
+    class InstrumentedTurboModule : public ForwardingTurboModule
+    {
+    public:
+        InstrumentedTurboModule(std::string const &name,
+                                std::shared_ptr<CallInvoker> const &jsInvoker,
+                                std::shared_ptr<TurboModule> module,
+                                std::shared_ptr<ModuleStatsSession> session)
+            : ForwardingTurboModule(name, jsInvoker, std::move(module)),
+              session_(std::move(session))
+        {
+        }
+
+    protected:
+        Function Wrap(Runtime &runtime,
+                      PropNameID const &propName,
+                      std::string method,
+                      MethodFunction function) override
+        {
+            auto const id = session_->Stats().Intern(name_, method);
+            return Function::createFromHostFunction(
+                runtime,
+                propName,
+                0,
+                [session = session_,
+                 id,
+                 sizeArguments = session_->SizesArguments(),
+                 section = name_ + '.' + method,
+                 function](Runtime &runtime, Value const &, Value const *args, size_t count)
+                    -> Value {
+                    using namespace ReactTestApp::ModuleTrace;
+
+                    // Encoding walks every argument, so only do it if asked to
+                    std::string encodedArgs;
+                    if (sizeArguments) {
+                        EncodeValues(runtime, args, count, encodedArgs);
+                    }
+
+                    ATrace_beginSection(section.c_str());
+                    auto const start = std::chrono::steady_clock::now();
+                    auto result = function->call(runtime, args, count);
+                    auto const duration = std::chrono::steady_clock::now() - start;
+                    ATrace_endSection();
+
+                    session->Stats().RecordCall(id, encodedArgs.size(), duration);
+
+                    if (result.isObject() &&
+                        result.getObject(runtime).hasProperty(runtime, "then")) {
+                        auto onSettled = Function::createFromHostFunction(
+                            runtime,
+                            PropNameID::forAscii(runtime, "onSettled"),
+                            1,
+                            [session, id, start](Runtime &, Value const &, Value const *, size_t) {
+                                session->Stats().RecordAsync(
+                                    id, std::chrono::steady_clock::now() - start);
+                                return Value::undefined();
+                            });
+                        auto promise = result.getObject(runtime);
+                        promise.getPropertyAsFunction(runtime, "then")
+                            .callWithThis(runtime, promise, onSettled, onSettled);
+                    }
+
+                    return result;
+                });
+        }
+
+    private:
+        std::shared_ptr<ModuleStatsSession> session_;
+    };
+}  // namespace
+
+std::shared_ptr<TurboModule>
+ReactTestApp::WithModuleTrace(std::string const &name,
+                              std::shared_ptr<TurboModule> module,
+                              std::shared_ptr<CallInvoker> const &jsInvoker)
+{
+    if (module == nullptr) {
+        return module;
+    }
+
+    auto const &config = GetModuleTraceConfig();
+    if (config.writer != nullptr) {
+        module = std::make_shared<RecordingTurboModule>(
+            name, jsInvoker, std::move(module), config.writer);
+    } else if (config.replayer != nullptr) {
+        module = std::make_shared<ReplayingTurboModule>(
+            name, jsInvoker, std::move(module), config.replayer);
+    }
+
+    if (auto session = ModuleStatsSession::Get()) {
+        module = std::make_shared<InstrumentedTurboModule>(
+            name, jsInvoker, std::move(module), std::move(session));
+    }
+
+    // Track the outermost module since that is the one React Native holds on to
+    static auto &liveModules = GetLiveObjectCounter("turboModules");
+    return TrackLifetime(std::move(module), liveModules);
+}
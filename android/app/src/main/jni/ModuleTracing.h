@@ -0,0 +1,36 @@
+#ifndef REACTTESTAPP_JNI_MODULETRACING_H_
+#define REACTTESTAPP_JNI_MODULETRACING_H_
+
+#include <memory>
+#include <string>
+
+#include <ReactCommon/CallInvoker.h>
+#include <ReactCommon/TurboModule.h>
+
+namespace ReactTestApp
+{
+    /**
+     * Wraps `module` so that its calls are recorded to, or replayed from, a
+     * module trace. This is enabled by setting the system property
+     * `debug.reacttestapp.moduletrace` to `record:<path>` or `replay:<path>`,
+     * e.g.:
+     *
+     *   adb shell setprop debug.reacttestapp.moduletrace \
+     *     record:/data/data/com.microsoft.reacttest/files/modules.trace
+     *
+     * Independently, setting `debug.reacttestapp.modulestats` to a path
+     * collects per-method call counts and latency histograms. These are
+     * written to the path as JSON when the React instance is torn down, and
+     * calls show up as sections in system traces. Argument sizes are only
+     * collected if `debug.reacttestapp.modulestats.args` is also set to 1,
+     * since measuring them means encoding every argument of every call.
+     *
+     * Returns `module` unchanged if neither is enabled.
+     */
+    std::shared_ptr<facebook::react::TurboModule>
+    WithModuleTrace(std::string const &name,
+                    std::shared_ptr<facebook::react::TurboModule> module,
+                    std::shared_ptr<facebook::react::CallInvoker> const &jsInvoker);
+}  // namespace ReactTestApp
+
+#endif  // REACTTESTAPP_JNI_MODULETRACING_H_
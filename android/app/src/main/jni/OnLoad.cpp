@@ -10,12 +10,15 @@
 #include <ReactCommon/CallInvoker.h>
 
 #include "AutolinkingCompat.h"
+#include "ModuleTracing.h"
+#include "common/ModuleProviderCache.h"
 
 using facebook::react::CallInvoker;
 using facebook::react::DefaultComponentsRegistry;
 using facebook::react::DefaultTurboModuleManagerDelegate;
 using facebook::react::JavaTurboModule;
 using facebook::react::TurboModule;
+using ReactTestApp::ModuleProviderCache;
 
 namespace
 {
@@ -23,7 +26,10 @@ namespace
                                                    const std::shared_ptr<CallInvoker> &jsInvoker)
     {
 #if __has_include(<ReactCommon/CxxReactPackage.h>)
-        return autolinking_cxxModuleProvider(name, jsInvoker);
+        static ModuleProviderCache cache;
+        auto module = cache.Resolve(
+            name, [&]() { return autolinking_cxxModuleProvider(name, jsInvoker); });
+        return ReactTestApp::WithModuleTrace(name, std::move(module), jsInvoker);
 #else
         return nullptr;
 #endif  // __has_include(<ReactCommon/CxxReactPackage.h>)
@@ -32,15 +38,16 @@ namespace
     std::shared_ptr<TurboModule> javaModuleProvider(const std::string &name,
                                                     const JavaTurboModule::InitParams &params)
     {
+        static ModuleProviderCache cache;
+        auto module = cache.Resolve(
+            name,
 #if __has_include(<autolinking.h>)  // >= 0.75
-        // We first try to look up core modules
-        if (auto module = rncore_ModuleProvider(name, params)) {
-            return module;
-        }
+            // We first try to look up core modules
+            [&]() { return rncore_ModuleProvider(name, params); },
 #endif  // __has_include(<autolinking.h>)
-
-        // And we fallback to the module providers autolinked by RN CLI
-        return autolinking_ModuleProvider(name, params);
+            // And we fallback to the module providers autolinked by RN CLI
+            [&]() { return autolinking_ModuleProvider(name, params); });
+        return ReactTestApp::WithModuleTrace(name, std::move(module), params.jsInvoker);
     }
 }  // namespace
 
@@ -0,0 +1,81 @@
+#include "SurfaceStress.h"
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "common/SurfaceStress.h"
+
+using ReactTestApp::SurfaceStressResult;
+using ReactTestApp::SurfaceStressTracker;
+
+namespace
+{
+    /**
+     * Keeps the result around so that it can be returned from the call that
+     * completed the run.
+     */
+    struct SurfaceStress {
+        std::optional<std::string> result;
+        SurfaceStressTracker tracker;
+
+        SurfaceStress(std::string component, size_t surfaces)
+            : tracker(std::move(component), surfaces, [this](SurfaceStressResult const &r) {
+                  result = r.ToJSON();
+              })
+        {
+        }
+
+        jstring TakeResult(JNIEnv *env)
+        {
+            if (!result.has_value()) {
+                return nullptr;
+            }
+
+            auto json = env->NewStringUTF(result->c_str());
+            result.reset();
+            return json;
+        }
+    };
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL Java_com_microsoft_reacttestapp_react_SurfaceStress_create(
+    JNIEnv *env, jobject, jstring component, jint surfaces)
+{
+    auto chars = env->GetStringUTFChars(component, nullptr);
+    std::string name{chars};
+    env->ReleaseStringUTFChars(component, chars);
+
+    auto count = surfaces > 0 ? static_cast<size_t>(surfaces) : 0;
+    return reinterpret_cast<jlong>(new SurfaceStress(std::move(name), count));
+}
+
+JNIEXPORT void JNICALL Java_com_microsoft_reacttestapp_react_SurfaceStress_destroy(JNIEnv *,
+                                                                                   jobject,
+                                                                                   jlong handle)
+{
+    delete reinterpret_cast<SurfaceStress *>(handle);
+}
+
+JNIEXPORT jstring JNICALL Java_com_microsoft_reacttestapp_react_SurfaceStress_onMounted(
+    JNIEnv *env, jobject, jlong handle, jint surface)
+{
+    auto stress = reinterpret_cast<SurfaceStress *>(handle);
+    if (surface >= 0) {
+        stress->tracker.OnMounted(static_cast<size_t>(surface));
+    }
+    return stress->TakeResult(env);
+}
+
+JNIEXPORT jstring JNICALL Java_com_microsoft_reacttestapp_react_SurfaceStress_finish(JNIEnv *env,
+                                                                                     jobject,
+                                                                                     jlong handle)
+{
+    auto stress = reinterpret_cast<SurfaceStress *>(handle);
+    stress->tracker.Finish();
+    return stress->TakeResult(env);
+}
+
+}  // extern "C"
@@ -0,0 +1,23 @@
+#ifndef ANDROID_JNI_SURFACESTRESS_
+#define ANDROID_JNI_SURFACESTRESS_
+
+#include <jni.h>
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL Java_com_microsoft_reacttestapp_react_SurfaceStress_create(
+    JNIEnv *env, jobject thiz, jstring component, jint surfaces);
+
+JNIEXPORT void JNICALL Java_com_microsoft_reacttestapp_react_SurfaceStress_destroy(JNIEnv *env,
+                                                                                   jobject thiz,
+                                                                                   jlong handle);
+
+JNIEXPORT jstring JNICALL Java_com_microsoft_reacttestapp_react_SurfaceStress_onMounted(
+    JNIEnv *env, jobject thiz, jlong handle, jint surface);
+
+JNIEXPORT jstring JNICALL Java_com_microsoft_reacttestapp_react_SurfaceStress_finish(
+    JNIEnv *env, jobject thiz, jlong handle);
+
+}  // extern "C"
+
+#endif  // ANDROID_JNI_SURFACESTRESS_
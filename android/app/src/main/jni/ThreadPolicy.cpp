@@ -0,0 +1,51 @@
+#include "ThreadPolicy.h"
+
+#include <string>
+
+#include "common/ThreadPolicy.h"
+
+using ReactTestApp::ThreadPolicy;
+
+namespace
+{
+    std::string GetString(JNIEnv *env, jstring str)
+    {
+        auto chars = env->GetStringUTFChars(str, nullptr);
+        std::string result{chars};
+        env->ReleaseStringUTFChars(str, chars);
+        return result;
+    }
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jobjectArray JNICALL
+Java_com_microsoft_reacttestapp_react_ThreadPolicy_applyToCurrentThread(JNIEnv *env,
+                                                                        jclass,
+                                                                        jstring priority,
+                                                                        jstring qos,
+                                                                        jintArray affinity)
+{
+    ThreadPolicy policy;
+    if (priority != nullptr) {
+        policy.priority = ThreadPolicy::ParsePriority(GetString(env, priority));
+    }
+    if (qos != nullptr) {
+        policy.qos = ThreadPolicy::ParseQualityOfService(GetString(env, qos));
+    }
+    if (affinity != nullptr) {
+        auto length = env->GetArrayLength(affinity);
+        policy.affinity.resize(length);
+        env->GetIntArrayRegion(affinity, 0, length, policy.affinity.data());
+    }
+
+    auto failures = ReactTestApp::ApplyThreadPolicy(policy);
+    auto numFailures = static_cast<jsize>(failures.size());
+    auto result = env->NewObjectArray(numFailures, env->FindClass("java/lang/String"), nullptr);
+    for (jsize i = 0; i < numFailures; ++i) {
+        env->SetObjectArrayElement(result, i, env->NewStringUTF(failures[i].c_str()));
+    }
+    return result;
+}
+
+}  // extern "C"
@@ -0,0 +1,17 @@
+#ifndef ANDROID_JNI_THREADPOLICY_
+#define ANDROID_JNI_THREADPOLICY_
+
+#include <jni.h>
+
+extern "C" {
+
+JNIEXPORT jobjectArray JNICALL
+Java_com_microsoft_reacttestapp_react_ThreadPolicy_applyToCurrentThread(JNIEnv *env,
+                                                                        jclass clazz,
+                                                                        jstring priority,
+                                                                        jstring qos,
+                                                                        jintArray affinity);
+
+}  // extern "C"
+
+#endif  // ANDROID_JNI_THREADPOLICY_
@@ -5,12 +5,24 @@
 #include <rncore.h>
 
 #include "AutolinkingCompat.h"
+#include "ModuleTracing.h"
+#include "common/ModuleProviderCache.h"
 
 using facebook::react::CallInvoker;
 using facebook::react::JavaTurboModule;
 using facebook::react::TurboModule;
+using ReactTestApp::ModuleProviderCache;
 using ReactTestApp::TurboModuleManagerDelegate;
 
+namespace
+{
+    ModuleProviderCache &JavaModuleProviderCache()
+    {
+        static ModuleProviderCache cache;
+        return cache;
+    }
+}  // namespace
+
 void TurboModuleManagerDelegate::registerNatives()
 {
     registerHybrid({
@@ -28,13 +40,13 @@ std::shared_ptr<TurboModule> TurboModuleManagerDelegate::getTurboModule(StringRe
 std::shared_ptr<TurboModule> TurboModuleManagerDelegate::getTurboModule(
     StringRef name, const JavaTurboModule::InitParams &params)
 {
-    // Try autolinked module providers first
-    auto module = autolinking_ModuleProvider(name, params);
-    if (module != nullptr) {
-        return module;
-    }
+    auto module = JavaModuleProviderCache().Resolve(
+        name,
+        // Try autolinked module providers first
+        [&]() { return autolinking_ModuleProvider(name, params); },
+        [&]() { return rncore_ModuleProvider(name, params); });
 
-    return rncore_ModuleProvider(name, params);
+    return ReactTestApp::WithModuleTrace(name, std::move(module), params.jsInvoker);
 }
 
 facebook::jni::local_ref<TurboModuleManagerDelegate::jhybriddata>
@@ -46,6 +58,13 @@ TurboModuleManagerDelegate::initHybrid(
 
 bool TurboModuleManagerDelegate::canCreateTurboModule(StringRef name)
 {
+    // Generated providers can only tell whether they have a module by
+    // constructing it, so the first query for a name still does so once.
+    // Later queries are answered from the cache without constructing it.
+    if (auto exists = JavaModuleProviderCache().Contains(name); exists.has_value()) {
+        return *exists;
+    }
+
     return getTurboModule(name, nullptr) != nullptr ||
            getTurboModule(name, {.moduleName = name}) != nullptr;
 }
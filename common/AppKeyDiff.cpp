@@ -0,0 +1,110 @@
+#include "AppKeyDiff.h"
+
+#include <algorithm>
+#include <utility>
+
+using ReactTestApp::AppKeyChange;
+using ReactTestApp::AppKeyTracker;
+
+namespace
+{
+    uint64_t Hash(std::string const &s)
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for (auto c : s) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}  // namespace
+
+std::vector<AppKeyChange> AppKeyTracker::Update(std::vector<std::string> appKeys)
+{
+    std::vector<AppKeyChange> changes;
+    if (appKeys == appKeys_) {
+        return changes;
+    }
+
+    // Sorting by hash first means that most comparisons, both here and when
+    // merging below, are between integers rather than strings
+    std::vector<SortKey> sorted;
+    sorted.reserve(appKeys.size());
+    for (uint32_t i = 0; i < appKeys.size(); ++i) {
+        sorted.push_back({Hash(appKeys[i]), i});
+    }
+
+    auto less = [](SortKey const &lhs,
+                   std::string const &lhsKey,
+                   SortKey const &rhs,
+                   std::string const &rhsKey) {
+        return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhsKey < rhsKey;
+    };
+    std::sort(sorted.begin(), sorted.end(), [&](SortKey const &lhs, SortKey const &rhs) {
+        if (less(lhs, appKeys[lhs.index], rhs, appKeys[rhs.index])) {
+            return true;
+        }
+
+        // Keep duplicate keys in registration order so that they pair up
+        // with their previous occurrences in order
+        return !less(rhs, appKeys[rhs.index], lhs, appKeys[lhs.index]) && lhs.index < rhs.index;
+    });
+
+    std::vector<bool> keptPrevious(appKeys_.size(), false);
+    std::vector<bool> keptCurrent(appKeys.size(), false);
+    for (size_t i = 0, j = 0; i < sorted_.size() && j < sorted.size();) {
+        auto const &previous = sorted_[i];
+        auto const &current = sorted[j];
+        auto const &previousKey = appKeys_[previous.index];
+        auto const &currentKey = appKeys[current.index];
+        if (less(previous, previousKey, current, currentKey)) {
+            ++i;
+        } else if (less(current, currentKey, previous, previousKey)) {
+            ++j;
+        } else {
+            keptPrevious[previous.index] = true;
+            keptCurrent[current.index] = true;
+            ++i;
+            ++j;
+        }
+    }
+
+    // Removals and insertions alone can only describe the change if the keys
+    // present in both lists are still in the same order
+    bool reordered = false;
+    for (size_t i = 0, j = 0;; ++i, ++j) {
+        while (i < appKeys_.size() && !keptPrevious[i]) {
+            ++i;
+        }
+        while (j < appKeys.size() && !keptCurrent[j]) {
+            ++j;
+        }
+        if (i == appKeys_.size() || j == appKeys.size()) {
+            break;
+        }
+        if (appKeys_[i] != appKeys[j]) {
+            reordered = true;
+            break;
+        }
+    }
+    if (reordered) {
+        keptPrevious.assign(appKeys_.size(), false);
+        keptCurrent.assign(appKeys.size(), false);
+    }
+
+    for (auto i = appKeys_.size(); i-- > 0;) {
+        if (!keptPrevious[i]) {
+            changes.push_back({AppKeyChange::Kind::Remove, i, std::move(appKeys_[i])});
+        }
+    }
+    for (size_t j = 0; j < appKeys.size(); ++j) {
+        if (!keptCurrent[j]) {
+            changes.push_back({AppKeyChange::Kind::Insert, j, appKeys[j]});
+        }
+    }
+
+    appKeys_ = std::move(appKeys);
+    sorted_ = std::move(sorted);
+    return changes;
+}
@@ -0,0 +1,67 @@
+#ifndef COMMON_APPKEYDIFF_
+#define COMMON_APPKEYDIFF_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ReactTestApp
+{
+    struct AppKeyChange {
+        enum class Kind {
+            Insert,
+            Remove,
+        };
+
+        Kind kind;
+
+        /**
+         * For removals, the position in the previous list; for insertions,
+         * the position in the new list.
+         */
+        size_t index;
+
+        std::string appKey;
+    };
+
+    /**
+     * Tracks the app keys registered in `AppRegistry` across reloads, so that
+     * hosts only need to update the parts of their component list that
+     * actually changed.
+     */
+    class AppKeyTracker
+    {
+    public:
+        /**
+         * Returns the app keys from the last update, in registration order.
+         */
+        std::vector<std::string> const &AppKeys() const
+        {
+            return appKeys_;
+        }
+
+        /**
+         * Replaces the tracked app keys and returns the changes that turn the
+         * previous list into `appKeys`: removals first, from the highest index
+         * down, then insertions from the lowest index up. Returns nothing if
+         * the list is unchanged.
+         *
+         * If keys present in both lists were reordered, every previous key is
+         * removed and every new key inserted.
+         */
+        std::vector<AppKeyChange> Update(std::vector<std::string> appKeys);
+
+    private:
+        struct SortKey {
+            uint64_t hash;
+            uint32_t index;
+        };
+
+        std::vector<std::string> appKeys_;
+
+        // `appKeys_` ordered by hash, then by key
+        std::vector<SortKey> sorted_;
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_APPKEYDIFF_
@@ -3,27 +3,35 @@
 #if __has_include(<jsi/jsi.h>)
 #include <jsi/jsi.h>
 
+using facebook::jsi::Object;
 using facebook::jsi::Runtime;
 using facebook::jsi::String;
 
+namespace
+{
+    constexpr char kFbBatchedBridgeId[] = "__fbBatchedBridge";
+
+    Object GetAppRegistry(Runtime &runtime)
+    {
+        // return __fbBatchedBridge.getCallableModule("AppRegistry");
+        auto fbBatchedBridge = runtime.global().getPropertyAsObject(runtime, kFbBatchedBridgeId);
+        auto getCallableModule =
+            fbBatchedBridge.getPropertyAsFunction(runtime, "getCallableModule");
+        return getCallableModule.callWithThis(runtime, fbBatchedBridge, "AppRegistry")
+            .asObject(runtime);
+    }
+}  // namespace
+
 std::vector<std::string> ReactTestApp::GetAppKeys(Runtime &runtime)
 {
     std::vector<std::string> result;
 
-    constexpr char kFbBatchedBridgeId[] = "__fbBatchedBridge";
-
-    auto global = runtime.global();
-    if (!global.hasProperty(runtime, kFbBatchedBridgeId)) {
+    if (!runtime.global().hasProperty(runtime, kFbBatchedBridgeId)) {
         return result;
     }
 
     try {
-        // const appRegistry = __fbBatchedBridge.getCallableModule("AppRegistry");
-        auto fbBatchedBridge = global.getPropertyAsObject(runtime, kFbBatchedBridgeId);
-        auto getCallableModule =
-            fbBatchedBridge.getPropertyAsFunction(runtime, "getCallableModule");
-        auto appRegistry = getCallableModule.callWithThis(runtime, fbBatchedBridge, "AppRegistry")
-                               .asObject(runtime);
+        auto appRegistry = GetAppRegistry(runtime);
 
         // const appKeys = appRegistry.getAppKeys();
         auto getAppKeys = appRegistry.getPropertyAsFunction(runtime, "getAppKeys");
@@ -56,6 +64,23 @@ std::vector<std::string> ReactTestApp::GetAppKeys(Runtime &runtime)
     return result;
 }
 
+bool ReactTestApp::RunApplication(Runtime &runtime, std::string const &appKey, int rootTag)
+{
+    if (!runtime.global().hasProperty(runtime, kFbBatchedBridgeId)) {
+        return false;
+    }
+
+    // appRegistry.runApplication(appKey, {rootTag, initialProps: {}});
+    auto appRegistry = GetAppRegistry(runtime);
+    auto runApplication = appRegistry.getPropertyAsFunction(runtime, "runApplication");
+    Object parameters{runtime};
+    parameters.setProperty(runtime, "rootTag", rootTag);
+    parameters.setProperty(runtime, "initialProps", Object{runtime});
+    runApplication.callWithThis(
+        runtime, appRegistry, String::createFromUtf8(runtime, appKey), std::move(parameters));
+    return true;
+}
+
 #else
 
 using facebook::jsi::Runtime;
@@ -65,4 +90,9 @@ std::vector<std::string> ReactTestApp::GetAppKeys(Runtime &)
     return {};
 }
 
+bool ReactTestApp::RunApplication(Runtime &, std::string const &, int)
+{
+    return false;
+}
+
 #endif  // __has_include(<jsi/jsi.h>)
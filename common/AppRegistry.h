@@ -15,6 +15,13 @@ namespace ReactTestApp
      * Returns app keys registered in `AppRegistry`.
      */
     std::vector<std::string> GetAppKeys(facebook::jsi::Runtime &runtime);
+
+    /**
+     * Calls `AppRegistry.runApplication` for `appKey` with an empty set of
+     * initial properties. Returns `false` if `AppRegistry` is not available.
+     * Errors thrown by the application are propagated.
+     */
+    bool RunApplication(facebook::jsi::Runtime &runtime, std::string const &appKey, int rootTag);
 }  // namespace ReactTestApp
 
 #endif  // COMMON_APPREGISTRY_
@@ -0,0 +1,166 @@
+#include "BundleDelta.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using ReactTestApp::BundleHasher;
+
+namespace
+{
+    constexpr std::string_view kMagic = "RNTADLT1";
+
+    constexpr uint64_t kPrime = 1099511628211ull;
+
+    constexpr uint8_t kCopy = 0x01;
+    constexpr uint8_t kInsert = 0x02;
+
+    uint64_t LoadLittleEndian64(char const *data)
+    {
+        auto bytes = reinterpret_cast<unsigned char const *>(data);
+        return static_cast<uint64_t>(bytes[0]) | (static_cast<uint64_t>(bytes[1]) << 8) |
+               (static_cast<uint64_t>(bytes[2]) << 16) | (static_cast<uint64_t>(bytes[3]) << 24) |
+               (static_cast<uint64_t>(bytes[4]) << 32) | (static_cast<uint64_t>(bytes[5]) << 40) |
+               (static_cast<uint64_t>(bytes[6]) << 48) | (static_cast<uint64_t>(bytes[7]) << 56);
+    }
+
+    class Reader
+    {
+    public:
+        explicit Reader(std::string_view data) : data_(data)
+        {
+        }
+
+        bool AtEnd() const
+        {
+            return data_.empty();
+        }
+
+        std::string_view Bytes(uint64_t length)
+        {
+            if (length > data_.size()) {
+                throw std::runtime_error("Bundle delta is truncated");
+            }
+
+            auto bytes = data_.substr(0, static_cast<size_t>(length));
+            data_.remove_prefix(static_cast<size_t>(length));
+            return bytes;
+        }
+
+        uint8_t Byte()
+        {
+            return static_cast<uint8_t>(Bytes(1)[0]);
+        }
+
+        uint64_t Fixed64()
+        {
+            return LoadLittleEndian64(Bytes(8).data());
+        }
+
+        uint64_t Varint()
+        {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                auto byte = Byte();
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            throw std::runtime_error("Bundle delta contains an invalid varint");
+        }
+
+    private:
+        std::string_view data_;
+    };
+}  // namespace
+
+uint64_t ReactTestApp::HashBundle(std::string_view bundle)
+{
+    BundleHasher hasher;
+    hasher.Update(bundle);
+    return hasher.Digest();
+}
+
+void BundleHasher::Update(std::string_view data)
+{
+    if (pendingSize_ > 0) {
+        auto const n = std::min(data.size(), sizeof(pending_) - pendingSize_);
+        data.copy(pending_ + pendingSize_, n);
+        pendingSize_ += n;
+        data.remove_prefix(n);
+        if (pendingSize_ < sizeof(pending_)) {
+            return;
+        }
+
+        hash_ = (hash_ ^ LoadLittleEndian64(pending_)) * kPrime;
+        pendingSize_ = 0;
+    }
+
+    // Taking a word at a time is several times faster than byte-wise FNV-1a,
+    // which matters since bundles are hashed on every reload
+    while (data.size() >= 8) {
+        hash_ = (hash_ ^ LoadLittleEndian64(data.data())) * kPrime;
+        data.remove_prefix(8);
+    }
+
+    data.copy(pending_, data.size());
+    pendingSize_ = data.size();
+}
+
+uint64_t BundleHasher::Digest() const
+{
+    auto hash = hash_;
+    for (size_t i = 0; i < pendingSize_; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(pending_[i])) * kPrime;
+    }
+    return hash;
+}
+
+std::string ReactTestApp::ApplyBundleDelta(std::string_view base, std::string_view delta)
+{
+    Reader reader{delta};
+    if (reader.Bytes(kMagic.size()) != kMagic) {
+        throw std::runtime_error("Not a bundle delta");
+    }
+
+    auto const baseHash = reader.Fixed64();
+    auto const targetHash = reader.Fixed64();
+    auto const targetSize = reader.Varint();
+    if (baseHash != HashBundle(base)) {
+        throw std::runtime_error("Bundle delta was made against a different bundle");
+    }
+
+    // Don't let a corrupt size reserve arbitrary amounts of memory; the size
+    // is checked against the actual output as it is produced
+    std::string bundle;
+    bundle.reserve(static_cast<size_t>(std::min<uint64_t>(targetSize, base.size() + delta.size())));
+    while (!reader.AtEnd()) {
+        switch (reader.Byte()) {
+            case kCopy: {
+                auto const offset = reader.Varint();
+                auto const length = reader.Varint();
+                if (offset > base.size() || length > base.size() - offset) {
+                    throw std::runtime_error("Bundle delta copies past the end of the bundle");
+                }
+                bundle.append(
+                    base.substr(static_cast<size_t>(offset), static_cast<size_t>(length)));
+                break;
+            }
+            case kInsert:
+                bundle.append(reader.Bytes(reader.Varint()));
+                break;
+            default:
+                throw std::runtime_error("Bundle delta contains an unknown instruction");
+        }
+
+        if (bundle.size() > targetSize) {
+            throw std::runtime_error("Bundle delta produces too many bytes");
+        }
+    }
+
+    if (bundle.size() != targetSize || HashBundle(bundle) != targetHash) {
+        throw std::runtime_error("Bundle delta did not produce the expected bundle");
+    }
+
+    return bundle;
+}
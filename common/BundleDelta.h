@@ -0,0 +1,59 @@
+#ifndef COMMON_BUNDLEDELTA_
+#define COMMON_BUNDLEDELTA_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ReactTestApp
+{
+    /**
+     * Media type of bundle deltas, used to request them from the bundler and
+     * to tell them apart from full bundles in responses.
+     */
+    constexpr char kBundleDeltaMediaType[] = "application/x-react-test-app-bundle-delta";
+
+    /**
+     * Returns the hash that identifies a bundle in delta requests and in the
+     * deltas themselves: 64-bit FNV-1a over the bundle's 8-byte little-endian
+     * words, followed by any remaining bytes one at a time.
+     */
+    uint64_t HashBundle(std::string_view bundle);
+
+    /**
+     * Computes `HashBundle` incrementally, e.g. while a bundle is being
+     * downloaded.
+     */
+    class BundleHasher
+    {
+    public:
+        void Update(std::string_view data);
+        uint64_t Digest() const;
+
+    private:
+        uint64_t hash_ = 14695981039346656037ull;
+        char pending_[8] = {};
+        size_t pendingSize_ = 0;
+    };
+
+    /**
+     * Rebuilds a bundle from the previous version, `base`, and a delta
+     * against it. A delta consists of:
+     *
+     *   - the magic bytes `RNTADLT1`
+     *   - the hash of the base bundle, 8 bytes little-endian
+     *   - the hash of the resulting bundle, 8 bytes little-endian
+     *   - the size of the resulting bundle, as a LEB128 varint
+     *   - instructions until the end of the delta, each one of:
+     *     - `0x01 <offset> <length>`: copy `length` bytes of `base` starting
+     *       at `offset`
+     *     - `0x02 <length> <bytes>`: insert the next `length` bytes
+     *
+     * Offsets and lengths are LEB128 varints. Throws if the delta is
+     * malformed, was made against a different base, or does not produce the
+     * expected bundle.
+     */
+    std::string ApplyBundleDelta(std::string_view base, std::string_view delta);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_BUNDLEDELTA_
@@ -0,0 +1,519 @@
+#include "BundleFetcher.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+#include "BundleDelta.h"
+#include "GrowableMapping.h"
+#include "JSON.h"
+#include "Metrics.h"
+
+using ReactTestApp::BundleFetcher;
+using ReactTestApp::BundleFetchResult;
+using ReactTestApp::BundleHasher;
+using ReactTestApp::GrowableMapping;
+
+namespace
+{
+    constexpr intptr_t kInvalidHandle = -1;
+
+    // Bundling from scratch can take a while on the bundler's side
+    constexpr int kReceiveTimeoutSeconds = 120;
+
+    constexpr size_t kReceiveBufferSize = 256 * 1024;
+
+#ifdef _WIN32
+    using NativeSocket = SOCKET;
+    constexpr int kSendFlags = 0;
+
+    bool Startup()
+    {
+        static bool const started = []() {
+            WSADATA data;
+            return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }();
+        return started;
+    }
+
+    void Close(intptr_t socket)
+    {
+        closesocket(static_cast<NativeSocket>(socket));
+    }
+
+    void SetReceiveTimeout(intptr_t socket, int seconds)
+    {
+        DWORD timeout = seconds * 1000;
+        setsockopt(static_cast<NativeSocket>(socket),
+                   SOL_SOCKET,
+                   SO_RCVTIMEO,
+                   reinterpret_cast<char const *>(&timeout),
+                   sizeof(timeout));
+    }
+#else
+    using NativeSocket = int;
+    constexpr int kSendFlags = MSG_NOSIGNAL;
+
+    bool Startup()
+    {
+        return true;
+    }
+
+    void Close(intptr_t socket)
+    {
+        close(static_cast<NativeSocket>(socket));
+    }
+
+    void SetReceiveTimeout(intptr_t socket, int seconds)
+    {
+        timeval timeout{};
+        timeout.tv_sec = seconds;
+        setsockopt(
+            static_cast<NativeSocket>(socket), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+#endif  // _WIN32
+
+    intptr_t Connect(std::string const &host, uint16_t port)
+    {
+        if (!Startup()) {
+            return kInvalidHandle;
+        }
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo *addresses = nullptr;
+        if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) {
+            return kInvalidHandle;
+        }
+
+        auto result = kInvalidHandle;
+        for (auto address = addresses; address != nullptr; address = address->ai_next) {
+            auto s = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            auto handle = static_cast<intptr_t>(s);
+            if (handle == kInvalidHandle) {
+                continue;
+            }
+            if (connect(s, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0) {
+                result = handle;
+                break;
+            }
+            Close(handle);
+        }
+
+        freeaddrinfo(addresses);
+        return result;
+    }
+
+    bool Send(intptr_t socket, std::string_view data)
+    {
+        while (!data.empty()) {
+            auto sent = send(static_cast<NativeSocket>(socket),
+                             data.data(),
+                             static_cast<int>(data.size()),
+                             kSendFlags);
+            if (sent <= 0) {
+                return false;
+            }
+            data.remove_prefix(static_cast<size_t>(sent));
+        }
+        return true;
+    }
+
+    ptrdiff_t Receive(intptr_t socket, char *buffer, size_t size)
+    {
+        return recv(static_cast<NativeSocket>(socket), buffer, static_cast<int>(size), 0);
+    }
+
+    struct Response {
+        int status = 0;
+        std::string contentType;
+        std::unique_ptr<GrowableMapping> body;
+        BundleHasher bodyHash;
+    };
+
+    bool EqualsIgnoreCase(std::string_view lhs, std::string_view rhs)
+    {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            auto l = lhs[i] >= 'A' && lhs[i] <= 'Z' ? lhs[i] - 'A' + 'a' : lhs[i];
+            auto r = rhs[i] >= 'A' && rhs[i] <= 'Z' ? rhs[i] - 'A' + 'a' : rhs[i];
+            if (l != r) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string_view Trim(std::string_view s)
+    {
+        auto first = s.find_first_not_of(" \t");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        return s.substr(first, s.find_last_not_of(" \t") - first + 1);
+    }
+
+    /**
+     * Parses an HTTP/1.1 response as it is received. The body is written to
+     * a `GrowableMapping` and hashed chunk by chunk, so that it is ready as
+     * soon as the last byte has arrived.
+     */
+    class ResponseReader
+    {
+    public:
+        /**
+         * Consumes received bytes and returns whether the response is
+         * complete.
+         */
+        bool Feed(std::string_view data)
+        {
+            while (!data.empty() && state_ != State::Done) {
+                switch (state_) {
+                    case State::Headers:
+                        data = ReadHeaders(data);
+                        break;
+                    case State::Body:
+                    case State::ChunkData:
+                        data = ReadBody(data);
+                        break;
+                    case State::ChunkSize:
+                        data = ReadChunkSize(data);
+                        break;
+                    case State::ChunkEnd: {
+                        auto const n = std::min<size_t>(data.size(), remaining_);
+                        data.remove_prefix(n);
+                        remaining_ -= n;
+                        if (remaining_ == 0) {
+                            state_ = State::ChunkSize;
+                        }
+                        break;
+                    }
+                    case State::Done:
+                        break;
+                }
+            }
+            return state_ == State::Done;
+        }
+
+        /**
+         * Called when the server closed the connection. Throws if the
+         * response is incomplete.
+         */
+        void Finish()
+        {
+            if (state_ == State::Body && !bodyHasLength_) {
+                state_ = State::Done;
+            }
+            if (state_ != State::Done) {
+                throw std::runtime_error("Truncated response from the bundler");
+            }
+        }
+
+        Response Take()
+        {
+            return std::move(response_);
+        }
+
+    private:
+        enum class State {
+            Headers,
+            Body,
+            ChunkSize,
+            ChunkData,
+            ChunkEnd,
+            Done,
+        };
+
+        std::string_view ReadHeaders(std::string_view data)
+        {
+            // Only look for the end of the headers in what might contain it
+            auto const searchFrom = line_.size() < 3 ? 0 : line_.size() - 3;
+            line_.append(data);
+            auto headersEnd = line_.find("\r\n\r\n", searchFrom);
+            if (headersEnd == std::string::npos) {
+                return {};
+            }
+
+            // Whatever followed the headers is the start of the body
+            auto const consumed = headersEnd + 4 - (line_.size() - data.size());
+            line_.resize(headersEnd);
+            ParseHeaders(line_);
+            line_.clear();
+            return data.substr(consumed);
+        }
+
+        void ParseHeaders(std::string_view headers)
+        {
+            auto statusStart = headers.find(' ');
+            if (headers.compare(0, 5, "HTTP/") != 0 || statusStart == std::string_view::npos) {
+                throw std::runtime_error("Malformed response from the bundler");
+            }
+            response_.status = std::atoi(std::string{headers.substr(statusStart + 1, 3)}.c_str());
+
+            bool chunked = false;
+            for (auto lineStart = headers.find("\r\n"); lineStart != std::string_view::npos;) {
+                lineStart += 2;
+                auto lineEnd = headers.find("\r\n", lineStart);
+                auto line = headers.substr(lineStart, lineEnd - lineStart);
+                lineStart = lineEnd;
+
+                auto colon = line.find(':');
+                if (colon == std::string_view::npos) {
+                    continue;
+                }
+
+                auto name = line.substr(0, colon);
+                auto value = Trim(line.substr(colon + 1));
+                if (EqualsIgnoreCase(name, "Content-Type")) {
+                    response_.contentType = value.substr(0, value.find(';'));
+                } else if (EqualsIgnoreCase(name, "Content-Length")) {
+                    remaining_ = std::stoull(std::string{value});
+                    bodyHasLength_ = true;
+                } else if (EqualsIgnoreCase(name, "Transfer-Encoding")) {
+                    chunked = EqualsIgnoreCase(value, "chunked");
+                }
+            }
+
+            if (response_.status == 304) {
+                state_ = State::Done;
+                return;
+            }
+
+            response_.body = std::make_unique<GrowableMapping>();
+            if (chunked) {
+                state_ = State::ChunkSize;
+            } else if (bodyHasLength_ && remaining_ == 0) {
+                state_ = State::Done;
+            } else {
+                state_ = State::Body;
+            }
+        }
+
+        std::string_view ReadBody(std::string_view data)
+        {
+            auto const n = bodyHasLength_ || state_ == State::ChunkData
+                               ? std::min<size_t>(data.size(), remaining_)
+                               : data.size();
+            auto chunk = data.substr(0, n);
+            response_.body->Append(chunk);
+            response_.bodyHash.Update(chunk);
+            remaining_ -= n;
+
+            if (state_ == State::ChunkData && remaining_ == 0) {
+                state_ = State::ChunkEnd;
+                remaining_ = 2;
+            } else if (state_ == State::Body && bodyHasLength_ && remaining_ == 0) {
+                state_ = State::Done;
+            }
+            return data.substr(n);
+        }
+
+        std::string_view ReadChunkSize(std::string_view data)
+        {
+            auto lineEnd = data.find('\n');
+            line_.append(data.substr(0, lineEnd));
+            if (lineEnd == std::string_view::npos) {
+                return {};
+            }
+
+            // Trailers are not needed since the connection is closed after
+            // the response anyway
+            auto size = std::stoull(line_, nullptr, 16);
+            line_.clear();
+            if (size == 0) {
+                state_ = State::Done;
+            } else {
+                state_ = State::ChunkData;
+                remaining_ = size;
+            }
+            return data.substr(lineEnd + 1);
+        }
+
+        State state_ = State::Headers;
+        std::string line_;
+        uint64_t remaining_ = 0;
+        bool bodyHasLength_ = false;
+        Response response_;
+    };
+
+    Response Get(std::string const &host,
+                 uint16_t port,
+                 std::string const &path,
+                 std::optional<uint64_t> base)
+    {
+        std::string request = "GET " + path + " HTTP/1.1\r\nHost: " + host + ':' +
+                              std::to_string(port) + "\r\nConnection: close\r\n";
+        if (base.has_value()) {
+            char hash[17];
+            std::snprintf(
+                hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(*base));
+            request += "Accept: ";
+            request += ReactTestApp::kBundleDeltaMediaType;
+            request += ", application/javascript\r\nX-Bundle-Base: ";
+            request += hash;
+            request += "\r\n";
+        } else {
+            request += "Accept: application/javascript\r\n";
+        }
+        request += "\r\n";
+
+        auto connection = Connect(host, port);
+        if (connection == kInvalidHandle) {
+            throw std::runtime_error("Failed to connect to the bundler at " + host + ':' +
+                                     std::to_string(port));
+        }
+
+        struct Closer {
+            intptr_t connection;
+            ~Closer()
+            {
+                Close(connection);
+            }
+        } closer{connection};
+
+        SetReceiveTimeout(connection, kReceiveTimeoutSeconds);
+        if (!Send(connection, request)) {
+            throw std::runtime_error("Failed to request the bundle");
+        }
+
+        ResponseReader reader;
+        auto buffer = std::make_unique<char[]>(kReceiveBufferSize);
+        while (true) {
+            auto received = Receive(connection, buffer.get(), kReceiveBufferSize);
+            if (received < 0) {
+                throw std::runtime_error("Failed to download the bundle");
+            }
+            if (received == 0) {
+                reader.Finish();
+                break;
+            }
+            if (reader.Feed({buffer.get(), static_cast<size_t>(received)})) {
+                break;
+            }
+        }
+        return reader.Take();
+    }
+
+    void CheckStatus(Response const &response)
+    {
+        if (response.status != 200) {
+            throw std::runtime_error("Bundler responded with status " +
+                                     std::to_string(response.status));
+        }
+    }
+}  // namespace
+
+bool ReactTestApp::IsDeltaReloadEnabled()
+{
+    auto value = std::getenv("REACT_TEST_APP_DELTA_RELOAD");
+    return value != nullptr && std::string_view{value} == "1";
+}
+
+std::string BundleFetchResult::ToJSON() const
+{
+    constexpr char const *kKinds[] = {"full", "delta", "unchanged"};
+
+    std::string json = "{\"kind\":";
+    AppendJSONString(json, kKinds[static_cast<int>(kind)]);
+    json += ",\"bundleBytes\":";
+    json += std::to_string(bundle ? bundle->Size() : 0);
+    json += ",\"bytesTransferred\":";
+    json += std::to_string(bytesTransferred);
+    json += ",\"durationMicroseconds\":";
+    json += std::to_string(duration.count());
+    json += '}';
+    return json;
+}
+
+BundleFetcher::BundleFetcher(std::string host, uint16_t port, std::string path)
+    : host_(std::move(host)), port_(port), path_(std::move(path))
+{
+}
+
+BundleFetchResult BundleFetcher::Fetch()
+{
+    static auto const fetchTimes = Metrics::Shared().GetHistogram("bundleFetchMicroseconds");
+    static auto const transferSizes = Metrics::Shared().GetHistogram("bundleTransferBytes");
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const start = std::chrono::steady_clock::now();
+
+    BundleFetchResult result;
+    std::optional<uint64_t> hash;
+    auto takeBody = [&result, &hash](Response &response) {
+        result.bundle = std::move(response.body);
+        hash = response.bodyHash.Digest();
+    };
+
+    if (bundle_) {
+        auto response = Get(host_, port_, path_, bundleHash_);
+        result.bytesTransferred += response.body ? response.body->Size() : 0;
+        if (response.status == 304) {
+            ++deltasServed_;
+            result.kind = BundleFetchResult::Kind::Unchanged;
+            result.bundle = bundle_;
+            hash = bundleHash_;
+        } else {
+            CheckStatus(response);
+            if (response.contentType != kBundleDeltaMediaType) {
+                takeBody(response);
+            } else {
+                ++deltasServed_;
+                try {
+                    auto bundle = ApplyBundleDelta(bundle_->View(), response.body->View());
+                    auto mapping = std::make_shared<GrowableMapping>();
+                    mapping->Append(bundle);
+                    result.bundle = std::move(mapping);
+                    result.kind = BundleFetchResult::Kind::Delta;
+                } catch (std::runtime_error const &) {
+                    // Fall back to the whole bundle below
+                }
+            }
+        }
+
+        // Counted after `deltasServed_` so that `ServesDeltas` never sees a
+        // request without its answer
+        ++deltaRequests_;
+    }
+
+    if (!result.bundle) {
+        auto response = Get(host_, port_, path_, std::nullopt);
+        result.bytesTransferred += response.body ? response.body->Size() : 0;
+        CheckStatus(response);
+        takeBody(response);
+    }
+
+    bundle_ = result.bundle;
+    bundleHash_ = hash.has_value() ? *hash : HashBundle(bundle_->View());
+
+    result.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    fetchTimes.Record(static_cast<uint64_t>(result.duration.count()));
+    transferSizes.Record(result.bytesTransferred);
+    return result;
+}
+
+bool BundleFetcher::ServesDeltas() const
+{
+    return deltasServed_ > 0 || deltaRequests_ == 0;
+}
@@ -0,0 +1,103 @@
+#ifndef COMMON_BUNDLEFETCHER_
+#define COMMON_BUNDLEFETCHER_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "GrowableMapping.h"
+
+namespace ReactTestApp
+{
+    struct BundleFetchResult {
+        enum class Kind {
+            /** The whole bundle was transferred. */
+            Full,
+            /** A delta was transferred and applied to the previous bundle. */
+            Delta,
+            /** The bundler reported that the bundle has not changed. */
+            Unchanged,
+        };
+
+        Kind kind = Kind::Full;
+        std::shared_ptr<GrowableMapping const> bundle;
+        /** Size of all response bodies, including any failed delta. */
+        uint64_t bytesTransferred = 0;
+        std::chrono::microseconds duration{0};
+
+        std::string ToJSON() const;
+    };
+
+    /**
+     * Returns whether dev server reloads should go through `BundleFetcher`,
+     * i.e. whether the environment variable `REACT_TEST_APP_DELTA_RELOAD` is
+     * set to 1. Metro does not serve deltas; this only saves transfers with a
+     * bundler middleware that does (see `ApplyBundleDelta` for the format).
+     */
+    bool IsDeltaReloadEnabled();
+
+    /**
+     * Downloads the bundle from the bundler over HTTP and keeps the last one
+     * it got. Later fetches ask for a delta against it instead (see
+     * `ApplyBundleDelta`), and fall back to the whole bundle if the bundler
+     * does not serve deltas or the delta does not apply.
+     *
+     * Responses are parsed as they arrive, and bodies are written straight
+     * into a `GrowableMapping` and hashed chunk by chunk. A bundle is thus
+     * ready as soon as its last byte has been received, without the copies
+     * and extra pass that buffering the whole response first would take.
+     *
+     * Fetches block and may be called from any thread; concurrent fetches
+     * are serialized.
+     */
+    class BundleFetcher
+    {
+    public:
+        /**
+         * `path` is the path and query of the bundle URL, e.g.
+         * `/index.bundle?platform=windows&dev=true`.
+         */
+        BundleFetcher(std::string host, uint16_t port, std::string path);
+
+        BundleFetcher(BundleFetcher const &) = delete;
+        BundleFetcher &operator=(BundleFetcher const &) = delete;
+
+        std::string const &Host() const
+        {
+            return host_;
+        }
+
+        uint16_t Port() const
+        {
+            return port_;
+        }
+
+        /**
+         * Fetches the current bundle. Throws if it could not be downloaded;
+         * the previous bundle is then kept.
+         */
+        BundleFetchResult Fetch();
+
+        /**
+         * Returns `false` if the bundler has answered delta requests, but
+         * never with a delta or a 304, i.e. if it does not serve deltas. Does
+         * not wait for a fetch in progress.
+         */
+        bool ServesDeltas() const;
+
+    private:
+        std::string host_;
+        uint16_t port_;
+        std::string path_;
+        std::mutex mutex_;
+        std::shared_ptr<GrowableMapping const> bundle_;
+        uint64_t bundleHash_ = 0;
+        std::atomic<uint32_t> deltaRequests_{0};
+        std::atomic<uint32_t> deltasServed_{0};
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_BUNDLEFETCHER_
@@ -0,0 +1,126 @@
+#include "BundleSegments.h"
+
+#include <utility>
+
+using ReactTestApp::BundleSegmentLoader;
+
+#if __has_include(<jsi/jsi.h>)
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+#include <jsi/jsi.h>
+
+#include "Metrics.h"
+
+using ReactTestApp::Metrics;
+using facebook::jsi::Object;
+using facebook::jsi::PreparedJavaScript;
+using facebook::jsi::Runtime;
+using facebook::jsi::StringBuffer;
+
+namespace
+{
+    constexpr char kLoadedSegmentsId[] = "__rnta_loadedBundleSegments";
+
+    void ValidateName(std::string const &name)
+    {
+        if (name.empty() || name.find_first_of("/\\") != std::string::npos || name == "." ||
+            name == "..") {
+            throw std::invalid_argument("Invalid bundle segment name: " + name);
+        }
+    }
+
+    Object LoadedSegments(Runtime &runtime)
+    {
+        auto global = runtime.global();
+        if (!global.hasProperty(runtime, kLoadedSegmentsId)) {
+            global.setProperty(runtime, kLoadedSegmentsId, Object{runtime});
+        }
+        return global.getPropertyAsObject(runtime, kLoadedSegmentsId);
+    }
+}  // namespace
+
+BundleSegmentLoader::BundleSegmentLoader(std::string directory) : directory_(std::move(directory))
+{
+}
+
+BundleSegmentLoader::~BundleSegmentLoader() = default;
+
+bool BundleSegmentLoader::IsLoaded(Runtime &runtime, std::string const &name)
+{
+    // Loaded segments are recorded in the runtime itself so that they are
+    // forgotten along with it
+    auto global = runtime.global();
+    if (!global.hasProperty(runtime, kLoadedSegmentsId)) {
+        return false;
+    }
+
+    auto loaded = global.getPropertyAsObject(runtime, kLoadedSegmentsId);
+    return loaded.hasProperty(runtime, name.c_str());
+}
+
+bool BundleSegmentLoader::Load(Runtime &runtime, std::string const &name)
+{
+    static auto const loadTimes = Metrics::Shared().GetHistogram("bundleSegmentLoadMicroseconds");
+
+    ValidateName(name);
+    if (IsLoaded(runtime, name)) {
+        return false;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    runtime.evaluatePreparedJavaScript(Prepare(runtime, name));
+    LoadedSegments(runtime).setProperty(runtime, name.c_str(), true);
+
+    auto const duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    loadTimes.Record(static_cast<uint64_t>(duration.count()));
+    return true;
+}
+
+std::shared_ptr<PreparedJavaScript const> BundleSegmentLoader::Prepare(Runtime &runtime,
+                                                                       std::string const &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto prepared = prepared_.find(name); prepared != prepared_.end()) {
+        return prepared->second;
+    }
+
+    auto const fileName = name + ".bundle";
+    std::ifstream file{directory_ + '/' + fileName, std::ios::binary | std::ios::ate};
+    if (!file) {
+        throw std::runtime_error("Bundle segment not found: " + fileName);
+    }
+
+    std::string content(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(content.data(), static_cast<std::streamsize>(content.size()))) {
+        throw std::runtime_error("Failed to read bundle segment: " + fileName);
+    }
+
+    auto prepared =
+        runtime.prepareJavaScript(std::make_shared<StringBuffer>(std::move(content)), fileName);
+    prepared_.emplace(name, prepared);
+    return prepared;
+}
+
+#else
+
+BundleSegmentLoader::BundleSegmentLoader(std::string directory) : directory_(std::move(directory))
+{
+}
+
+BundleSegmentLoader::~BundleSegmentLoader() = default;
+
+bool BundleSegmentLoader::IsLoaded(facebook::jsi::Runtime &, std::string const &)
+{
+    return false;
+}
+
+bool BundleSegmentLoader::Load(facebook::jsi::Runtime &, std::string const &)
+{
+    return false;
+}
+
+#endif  // __has_include(<jsi/jsi.h>)
@@ -0,0 +1,65 @@
+#ifndef COMMON_BUNDLESEGMENTS_
+#define COMMON_BUNDLESEGMENTS_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::jsi
+{
+    class PreparedJavaScript;
+    class Runtime;
+}  // namespace facebook::jsi
+
+namespace ReactTestApp
+{
+    /**
+     * Loads bundle segments, i.e. bundles that are evaluated on top of the
+     * base bundle the first time a component that needs them is opened.
+     * Segment `name` is read from `<directory>/<name>.bundle`.
+     *
+     * Each runtime evaluates a segment at most once. Segments are read and
+     * prepared only once, and later runtimes, e.g. after a reload, reuse the
+     * prepared form. All runtimes that share a loader must therefore be of
+     * the same type.
+     */
+    class BundleSegmentLoader
+    {
+    public:
+        explicit BundleSegmentLoader(std::string directory);
+        ~BundleSegmentLoader();
+
+        BundleSegmentLoader(BundleSegmentLoader const &) = delete;
+        BundleSegmentLoader &operator=(BundleSegmentLoader const &) = delete;
+
+        std::string const &Directory() const
+        {
+            return directory_;
+        }
+
+        /**
+         * Returns whether segment `name` has been evaluated in `runtime`.
+         */
+        static bool IsLoaded(facebook::jsi::Runtime &runtime, std::string const &name);
+
+        /**
+         * Evaluates segment `name` in `runtime` unless it already has been,
+         * and returns whether this call evaluated it. Must be called on the JS
+         * thread. Throws if the segment cannot be read or fails to evaluate;
+         * the next call will then try again.
+         */
+        bool Load(facebook::jsi::Runtime &runtime, std::string const &name);
+
+    private:
+        std::shared_ptr<facebook::jsi::PreparedJavaScript const>
+        Prepare(facebook::jsi::Runtime &runtime, std::string const &name);
+
+        std::string directory_;
+        std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_ptr<facebook::jsi::PreparedJavaScript const>>
+            prepared_;
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_BUNDLESEGMENTS_
@@ -0,0 +1,124 @@
+#include "CallStats.h"
+
+#include <algorithm>
+
+#include "JSON.h"
+
+using ReactTestApp::CallStats;
+using ReactTestApp::MethodCallSummary;
+
+namespace
+{
+    void Increment(std::atomic<uint64_t> &counter, uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}  // namespace
+
+CallStats::MethodId CallStats::Intern(std::string_view module, std::string_view method)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < names_.size(); ++i) {
+        if (names_[i].first == module && names_[i].second == method) {
+            return static_cast<MethodId>(i);
+        }
+    }
+
+    names_.emplace_back(module, method);
+    return static_cast<MethodId>(names_.size() - 1);
+}
+
+void CallStats::RecordCall(MethodId id,
+                           size_t argumentBytes,
+                           std::chrono::nanoseconds duration)
+{
+    auto stats = GetMethodStats(id);
+    if (stats == nullptr) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Increment(stats->calls, 1);
+    Increment(stats->argumentBytes, argumentBytes);
+    stats->syncLatency.Record(static_cast<uint64_t>(duration.count()));
+}
+
+void CallStats::RecordAsync(MethodId id, std::chrono::nanoseconds duration)
+{
+    if (auto stats = GetMethodStats(id)) {
+        stats->asyncLatency.Record(static_cast<uint64_t>(duration.count()));
+    }
+}
+
+std::vector<MethodCallSummary> CallStats::Collect() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<MethodCallSummary> summaries;
+    summaries.reserve(names_.size());
+    for (auto const &[module, method] : names_) {
+        summaries.push_back(MethodCallSummary{module, method, 0, 0, {}, {}});
+    }
+
+    // Methods interned beyond `kMaxMethods` have no slot in the shards
+    auto const tracked = std::min<size_t>(summaries.size(), kMaxMethods);
+    shards_.ForEach([&summaries, tracked](Shard const &shard) {
+        for (size_t i = 0; i < tracked; ++i) {
+            auto stats = shard.methods[i].load(std::memory_order_acquire);
+            if (stats == nullptr) {
+                continue;
+            }
+
+            auto &summary = summaries[i];
+            summary.calls += stats->calls.load(std::memory_order_relaxed);
+            summary.argumentBytes += stats->argumentBytes.load(std::memory_order_relaxed);
+            summary.syncLatency.Merge(stats->syncLatency.Snapshot());
+            summary.asyncLatency.Merge(stats->asyncLatency.Snapshot());
+        }
+    });
+
+    return summaries;
+}
+
+std::string CallStats::DumpJSON() const
+{
+    std::string json = "{";
+    for (auto const &summary : Collect()) {
+        if (summary.calls == 0) {
+            continue;
+        }
+
+        if (json.size() > 1) {
+            json += ',';
+        }
+        AppendJSONString(json, summary.module + '.' + summary.method);
+        json += ":{\"calls\":";
+        json += std::to_string(summary.calls);
+        json += ",\"argumentBytes\":";
+        json += std::to_string(summary.argumentBytes);
+        json += ",\"sync\":";
+        summary.syncLatency.AppendJSON(json);
+        json += ",\"async\":";
+        summary.asyncLatency.AppendJSON(json);
+        json += '}';
+    }
+    json += '}';
+    return json;
+}
+
+CallStats::MethodStats *CallStats::GetMethodStats(MethodId id)
+{
+    if (id >= kMaxMethods) {
+        return nullptr;
+    }
+
+    // Only the owning thread writes to its shard, so this needs no lock
+    auto &shard = shards_.Local();
+    auto stats = shard.methods[id].load(std::memory_order_relaxed);
+    if (stats == nullptr) {
+        shard.storage.push_back(std::make_unique<MethodStats>());
+        stats = shard.storage.back().get();
+        shard.methods[id].store(stats, std::memory_order_release);
+    }
+    return stats;
+}
@@ -0,0 +1,96 @@
+#ifndef COMMON_CALLSTATS_
+#define COMMON_CALLSTATS_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Histogram.h"
+#include "ThreadShards.h"
+
+namespace ReactTestApp
+{
+    /**
+     * Aggregated statistics for a single native module method.
+     */
+    struct MethodCallSummary {
+        std::string module;
+        std::string method;
+        uint64_t calls;
+        uint64_t argumentBytes;
+        HistogramSnapshot syncLatency;
+        HistogramSnapshot asyncLatency;
+    };
+
+    /**
+     * Collects per-method call counts, argument sizes, and latencies. Each
+     * thread records into its own shard so that the hot path takes no locks;
+     * shards are merged when the statistics are collected.
+     */
+    class CallStats
+    {
+    public:
+        using MethodId = uint32_t;
+
+        /**
+         * Maximum number of distinct methods; calls to methods beyond this
+         * are counted in `Dropped()` only.
+         */
+        static constexpr MethodId kMaxMethods = 1024;
+
+        /**
+         * Returns a stable identifier for the method. This takes a lock and
+         * should be cached by the caller.
+         */
+        MethodId Intern(std::string_view module, std::string_view method);
+
+        void RecordCall(MethodId id, size_t argumentBytes, std::chrono::nanoseconds duration);
+
+        /**
+         * Records the time from a call until its promise settled.
+         */
+        void RecordAsync(MethodId id, std::chrono::nanoseconds duration);
+
+        std::vector<MethodCallSummary> Collect() const;
+
+        uint64_t Dropped() const
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Returns all collected statistics as a JSON object keyed by
+         * `module.method`. Latencies are in nanoseconds.
+         */
+        std::string DumpJSON() const;
+
+    private:
+        struct MethodStats {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> argumentBytes{0};
+            Histogram syncLatency;
+            Histogram asyncLatency;
+        };
+
+        struct Shard {
+            std::array<std::atomic<MethodStats *>, kMaxMethods> methods{};
+            std::vector<std::unique_ptr<MethodStats>> storage;
+        };
+
+        mutable std::mutex mutex_;
+        std::vector<std::pair<std::string, std::string>> names_;
+        ThreadShards<Shard> shards_;
+        std::atomic<uint64_t> dropped_{0};
+
+        MethodStats *GetMethodStats(MethodId id);
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_CALLSTATS_
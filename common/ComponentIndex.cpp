@@ -0,0 +1,323 @@
+#include "ComponentIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+using ReactTestApp::ComponentIndex;
+
+namespace
+{
+    constexpr int kNoMatch = std::numeric_limits<int>::max();
+
+    enum Rank {
+        Exact,
+        Prefix,
+        WordPrefix,
+        Substring,
+    };
+
+    struct Match {
+        int rank;
+        size_t length;
+        uint32_t entry;
+
+        bool operator<(Match const &other) const
+        {
+            return std::tie(rank, length, entry) < std::tie(other.rank, other.length, other.entry);
+        }
+    };
+
+    /**
+     * Keeps the best `limit` matches, at most one per entry.
+     */
+    class TopMatches
+    {
+    public:
+        explicit TopMatches(size_t limit) : limit_(limit)
+        {
+            heap_.reserve(limit);
+        }
+
+        bool IsFull() const
+        {
+            return heap_.size() == limit_;
+        }
+
+        Match const &Worst() const
+        {
+            return heap_.front();
+        }
+
+        void Add(Match const &match)
+        {
+            if (limit_ == 0 || (IsFull() && !(match < Worst()))) {
+                return;
+            }
+
+            // Only matches that make it into the heap need to be checked for
+            // duplicates, which is rare once it has filled up
+            auto existing = std::find_if(heap_.begin(), heap_.end(), [&match](Match const &m) {
+                return m.entry == match.entry;
+            });
+            if (existing != heap_.end()) {
+                if (match < *existing) {
+                    *existing = match;
+                    std::make_heap(heap_.begin(), heap_.end());
+                }
+                return;
+            }
+
+            if (IsFull()) {
+                std::pop_heap(heap_.begin(), heap_.end());
+                heap_.back() = match;
+            } else {
+                heap_.push_back(match);
+            }
+            std::push_heap(heap_.begin(), heap_.end());
+        }
+
+        std::vector<size_t> Take()
+        {
+            std::sort_heap(heap_.begin(), heap_.end());
+
+            std::vector<size_t> result;
+            result.reserve(heap_.size());
+            for (auto &&match : heap_) {
+                result.push_back(match.entry);
+            }
+            return result;
+        }
+
+    private:
+        size_t limit_;
+        std::vector<Match> heap_;
+    };
+
+    char Fold(char c)
+    {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    std::string Fold(std::string_view s)
+    {
+        std::string result(s);
+        std::transform(
+            result.begin(), result.end(), result.begin(), [](char c) { return Fold(c); });
+        return result;
+    }
+
+    bool IsAlphanumeric(char c)
+    {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+               (static_cast<unsigned char>(c) >= 0x80);
+    }
+
+    bool IsWordStart(std::string_view s, size_t i)
+    {
+        if (i == 0) {
+            return true;
+        }
+
+        auto const prev = s[i - 1];
+        auto const c = s[i];
+        if (!IsAlphanumeric(prev)) {
+            return IsAlphanumeric(c);
+        }
+
+        // camelCase and letter/digit boundaries
+        bool const prevIsDigit = prev >= '0' && prev <= '9';
+        bool const isDigit = c >= '0' && c <= '9';
+        return (prev >= 'a' && prev <= 'z' && c >= 'A' && c <= 'Z') || prevIsDigit != isDigit;
+    }
+
+    /**
+     * Packs the first eight bytes of `s` so that comparing keys orders strings
+     * the same way as comparing the strings themselves.
+     */
+    uint64_t Key(std::string_view s)
+    {
+        uint64_t key = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            key <<= 8;
+            if (i < s.size()) {
+                key |= static_cast<unsigned char>(s[i]);
+            }
+        }
+        return key;
+    }
+
+    uint32_t Trigram(std::string_view s, size_t i)
+    {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(s[i])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(s[i + 1])) << 8) |
+               static_cast<uint32_t>(static_cast<unsigned char>(s[i + 2]));
+    }
+}  // namespace
+
+ComponentIndex::ComponentIndex(std::vector<Entry> entries)
+{
+    fields_.reserve(entries.size());
+    for (auto &&entry : entries) {
+        auto &fields = fields_.emplace_back();
+        fields[0].original = std::move(entry.appKey);
+        fields[1].original = std::move(entry.displayName);
+        fields[2].original = std::move(entry.slug);
+        for (auto &&field : fields) {
+            field.folded = Fold(field.original);
+        }
+    }
+
+    std::vector<uint32_t> seen;
+    for (uint32_t entry = 0; entry < fields_.size(); ++entry) {
+        seen.clear();
+        for (uint16_t f = 0; f < kFieldCount; ++f) {
+            auto const &field = fields_[entry][f];
+            auto const length = std::min<size_t>(field.original.size(),
+                                                 std::numeric_limits<uint16_t>::max());
+            for (size_t i = 0; i < length; ++i) {
+                if (IsWordStart(field.original, i)) {
+                    auto const offset = static_cast<uint16_t>(i);
+                    auto const key = Key(std::string_view{field.folded}.substr(offset));
+                    terms_.push_back({key, entry, f, offset, static_cast<uint16_t>(length)});
+                }
+            }
+
+            auto const &folded = field.folded;
+            for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+                seen.push_back(Trigram(folded, i));
+            }
+        }
+
+        std::sort(seen.begin(), seen.end());
+        seen.erase(std::unique(seen.begin(), seen.end()), seen.end());
+        for (auto trigram : seen) {
+            trigrams_[trigram].push_back(entry);
+        }
+    }
+
+    std::sort(terms_.begin(), terms_.end(), [this](Term const &lhs, Term const &rhs) {
+        if (lhs.key != rhs.key) {
+            return lhs.key < rhs.key;
+        }
+        return TermText(lhs) < TermText(rhs);
+    });
+}
+
+std::vector<size_t> ComponentIndex::Search(std::string_view query, size_t limit) const
+{
+    if (limit == 0) {
+        return {};
+    }
+
+    auto const first = query.find_first_not_of(' ');
+    auto const last = query.find_last_not_of(' ');
+    if (first == std::string_view::npos) {
+        std::vector<size_t> result(std::min(limit, fields_.size()));
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = i;
+        }
+        return result;
+    }
+
+    auto const needle = Fold(query.substr(first, last - first + 1));
+    TopMatches top(limit);
+
+    // Exact, prefix and word prefix matches are all found among the terms
+    // starting with the query, so they are ranked without string searches
+    auto const needleKey = Key(needle);
+    auto const keyMask =
+        needle.size() >= 8 ? ~uint64_t{0} : ~(~uint64_t{0} >> (needle.size() * 8));
+    auto it = std::lower_bound(
+        terms_.begin(), terms_.end(), needleKey, [](Term const &term, uint64_t key) {
+            return term.key < key;
+        });
+    for (; it != terms_.end() && (it->key & keyMask) == needleKey; ++it) {
+        if (needle.size() > 8 && TermText(*it).substr(0, needle.size()) != needle) {
+            continue;
+        }
+
+        auto const rank = it->offset != 0                   ? WordPrefix
+                          : it->fieldLength == needle.size() ? Exact
+                                                             : Prefix;
+        top.Add({rank, it->fieldLength, it->entry});
+    }
+
+    // Matches in the middle of a word rank last, so they are only needed if
+    // there is still room
+    if (needle.size() < 3 || (top.IsFull() && top.Worst().rank < Substring)) {
+        return top.Take();
+    }
+
+    std::vector<std::vector<uint32_t> const *> postings;
+    for (size_t i = 0; i + 3 <= needle.size(); ++i) {
+        auto posting = trigrams_.find(Trigram(needle, i));
+        if (posting == trigrams_.end()) {
+            return top.Take();
+        }
+        postings.push_back(&posting->second);
+    }
+
+    std::sort(postings.begin(), postings.end(), [](auto lhs, auto rhs) {
+        return lhs->size() < rhs->size();
+    });
+    postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+
+    std::vector<size_t> hints(postings.size(), 0);
+    for (auto entry : *postings.front()) {
+        bool inAll = true;
+        for (size_t i = 1; i < postings.size() && inAll; ++i) {
+            auto const &posting = *postings[i];
+            auto pos = std::lower_bound(posting.begin() + hints[i], posting.end(), entry);
+            hints[i] = pos - posting.begin();
+            inAll = pos != posting.end() && *pos == entry;
+        }
+        if (!inAll) {
+            continue;
+        }
+
+        size_t length = 0;
+        auto const rank = Rank(entry, needle, length);
+        if (rank != kNoMatch) {
+            top.Add({rank, length, entry});
+        }
+    }
+
+    return top.Take();
+}
+
+std::string_view ComponentIndex::TermText(Term const &term) const
+{
+    return std::string_view{fields_[term.entry][term.field].folded}.substr(term.offset);
+}
+
+int ComponentIndex::Rank(size_t entry, std::string_view query, size_t &length) const
+{
+    int best = kNoMatch;
+    for (auto &&field : fields_[entry]) {
+        std::string_view folded{field.folded};
+        auto pos = folded.find(query);
+        if (pos == std::string_view::npos) {
+            continue;
+        }
+
+        int rank = Substring;
+        if (pos == 0) {
+            rank = folded.size() == query.size() ? Exact : Prefix;
+        } else {
+            for (; pos != std::string_view::npos; pos = folded.find(query, pos + 1)) {
+                if (IsWordStart(field.original, pos)) {
+                    rank = WordPrefix;
+                    break;
+                }
+            }
+        }
+
+        if (rank < best || (rank == best && folded.size() < length)) {
+            best = rank;
+            length = folded.size();
+        }
+    }
+    return best;
+}
@@ -0,0 +1,79 @@
+#ifndef COMMON_COMPONENTINDEX_
+#define COMMON_COMPONENTINDEX_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ReactTestApp
+{
+    /**
+     * Search index over component names, built once per manifest. Queries
+     * match case-insensitively against app key, display name and slug.
+     * Queries shorter than three characters match word prefixes only; longer
+     * queries match anywhere, using trigram posting lists to find candidates.
+     */
+    class ComponentIndex
+    {
+    public:
+        struct Entry {
+            std::string appKey;
+            std::string displayName;
+            std::string slug;
+        };
+
+        ComponentIndex() = default;
+        explicit ComponentIndex(std::vector<Entry> entries);
+
+        ComponentIndex(ComponentIndex &&) = default;
+        ComponentIndex &operator=(ComponentIndex &&) = default;
+
+        size_t Size() const
+        {
+            return fields_.size();
+        }
+
+        /**
+         * Returns the indices of up to `limit` entries matching `query`, best
+         * match first: exact matches, then prefix matches, then matches at the
+         * start of a word, then anywhere else. Ties are broken by name length,
+         * then by order in the manifest. An empty query returns the first
+         * `limit` entries.
+         */
+        std::vector<size_t> Search(std::string_view query, size_t limit) const;
+
+    private:
+        static constexpr size_t kFieldCount = 3;
+
+        struct Field {
+            std::string original;
+            std::string folded;
+        };
+
+        struct Term {
+            // Up to the first eight bytes of the term, big-endian, so that
+            // most comparisons do not need to look at the string itself
+            uint64_t key;
+            uint32_t entry;
+            uint16_t field;
+            uint16_t offset;
+            uint16_t fieldLength;
+        };
+
+        std::string_view TermText(Term const &term) const;
+        int Rank(size_t entry, std::string_view query, size_t &length) const;
+
+        std::vector<std::array<Field, kFieldCount>> fields_;
+
+        // Suffixes of every field starting at a word boundary, sorted
+        std::vector<Term> terms_;
+
+        // Entries containing each trigram, in ascending order
+        std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams_;
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_COMPONENTINDEX_
@@ -0,0 +1,365 @@
+#include "ControlServer.h"
+
+#include <chrono>
+#include <utility>
+
+#include "JSON.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+using ReactTestApp::ControlRequest;
+using ReactTestApp::ControlResponse;
+using ReactTestApp::ControlServer;
+using ReactTestApp::JSONScalar;
+
+namespace
+{
+    constexpr intptr_t kInvalidHandle = -1;
+
+    // Requests are small; a client that sends this much without a newline is
+    // dropped rather than buffered indefinitely
+    constexpr size_t kMaxLineLength = 64 * 1024;
+
+#ifdef _WIN32
+    intptr_t Listen(std::string const &address)
+    {
+        auto pipe = CreateNamedPipeA(address.c_str(),
+                                     PIPE_ACCESS_DUPLEX,
+                                     PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT |
+                                         PIPE_REJECT_REMOTE_CLIENTS,
+                                     1,
+                                     4096,
+                                     4096,
+                                     0,
+                                     nullptr);
+        return pipe == INVALID_HANDLE_VALUE ? kInvalidHandle : reinterpret_cast<intptr_t>(pipe);
+    }
+
+    intptr_t Accept(intptr_t listener)
+    {
+        auto pipe = reinterpret_cast<HANDLE>(listener);
+        if (!ConnectNamedPipe(pipe, nullptr)) {
+            // A client may connect, or even disconnect, before we start waiting
+            auto error = GetLastError();
+            if (error != ERROR_PIPE_CONNECTED && error != ERROR_NO_DATA) {
+                return kInvalidHandle;
+            }
+        }
+        return listener;
+    }
+
+    void Disconnect(intptr_t client)
+    {
+        DisconnectNamedPipe(reinterpret_cast<HANDLE>(client));
+    }
+
+    void Close(intptr_t handle)
+    {
+        CloseHandle(reinterpret_cast<HANDLE>(handle));
+    }
+
+    void Interrupt(intptr_t, std::thread &thread)
+    {
+        CancelSynchronousIo(thread.native_handle());
+    }
+
+    ptrdiff_t Read(intptr_t client, char *buffer, size_t size)
+    {
+        DWORD bytesRead = 0;
+        if (!ReadFile(reinterpret_cast<HANDLE>(client),
+                      buffer,
+                      static_cast<DWORD>(size),
+                      &bytesRead,
+                      nullptr)) {
+            return -1;
+        }
+        return static_cast<ptrdiff_t>(bytesRead);
+    }
+
+    bool Write(intptr_t client, std::string_view data)
+    {
+        DWORD bytesWritten = 0;
+        return WriteFile(reinterpret_cast<HANDLE>(client),
+                         data.data(),
+                         static_cast<DWORD>(data.size()),
+                         &bytesWritten,
+                         nullptr) &&
+               bytesWritten == data.size();
+    }
+#else
+#ifdef __APPLE__
+    // Apple platforms have no `MSG_NOSIGNAL`; `SO_NOSIGPIPE` is set on
+    // accepted sockets instead
+    constexpr int kSendFlags = 0;
+#else
+    // Writing to a client that has disconnected must not raise `SIGPIPE`,
+    // which would terminate the app
+    constexpr int kSendFlags = MSG_NOSIGNAL;
+#endif  // __APPLE__
+
+    intptr_t Listen(std::string const &address)
+    {
+        sockaddr_un addr{};
+        if (address.size() >= sizeof(addr.sun_path)) {
+            return kInvalidHandle;
+        }
+
+        auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return kInvalidHandle;
+        }
+
+        addr.sun_family = AF_UNIX;
+        address.copy(addr.sun_path, address.size());
+        unlink(address.c_str());
+
+        if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            listen(fd, 1) != 0) {
+            close(fd);
+            return kInvalidHandle;
+        }
+
+        return fd;
+    }
+
+    intptr_t Accept(intptr_t listener)
+    {
+        auto fd = accept(static_cast<int>(listener), nullptr, nullptr);
+        if (fd < 0) {
+            return kInvalidHandle;
+        }
+
+#ifdef __APPLE__
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif  // __APPLE__
+        return fd;
+    }
+
+    void Disconnect(intptr_t client)
+    {
+        close(static_cast<int>(client));
+    }
+
+    void Close(intptr_t handle)
+    {
+        close(static_cast<int>(handle));
+    }
+
+    void Interrupt(intptr_t handle, std::thread &)
+    {
+        shutdown(static_cast<int>(handle), SHUT_RDWR);
+    }
+
+    ptrdiff_t Read(intptr_t client, char *buffer, size_t size)
+    {
+        return read(static_cast<int>(client), buffer, size);
+    }
+
+    bool Write(intptr_t client, std::string_view data)
+    {
+        while (!data.empty()) {
+            auto written = send(static_cast<int>(client), data.data(), data.size(), kSendFlags);
+            if (written <= 0) {
+                return false;
+            }
+            data.remove_prefix(static_cast<size_t>(written));
+        }
+        return true;
+    }
+#endif  // _WIN32
+}  // namespace
+
+std::string_view ControlRequest::Param(std::string_view name) const
+{
+    auto it = params.find(name);
+    return it == params.end() ? std::string_view{} : std::string_view{it->second};
+}
+
+ControlServer::ControlServer(std::string address) : address_(std::move(address))
+{
+}
+
+ControlServer::~ControlServer()
+{
+    Stop();
+}
+
+void ControlServer::On(std::string command, ControlHandler handler)
+{
+    handlers_.insert_or_assign(std::move(command), std::move(handler));
+}
+
+bool ControlServer::Start()
+{
+    if (running_) {
+        return true;
+    }
+
+    auto listener = Listen(address_);
+    if (listener == kInvalidHandle) {
+        return false;
+    }
+
+    listener_ = listener;
+    running_ = true;
+    finished_ = false;
+    thread_ = std::thread{&ControlServer::Run, this};
+    return true;
+}
+
+void ControlServer::Stop()
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    // An interrupt is lost if the server thread is not blocked yet, e.g. when
+    // it has not reached `Accept` or `Read`, so keep interrupting until it
+    // has exited
+    while (!finished_) {
+        {
+            std::lock_guard<std::mutex> lock(clientMutex_);
+            if (client_ != kInvalidHandle) {
+                Interrupt(client_, thread_);
+            }
+        }
+        Interrupt(listener_, thread_);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    Close(std::exchange(listener_, kInvalidHandle));
+
+#ifndef _WIN32
+    unlink(address_.c_str());
+#endif  // !_WIN32
+}
+
+std::string ControlServer::HandleLine(std::string_view line) const
+{
+    std::string response{"{"};
+
+    auto params = ParseFlatJSONObject(line);
+    if (params.has_value()) {
+        if (auto id = params->find("id"); id != params->end()) {
+            // Only numbers, which the parser has validated, are echoed as is
+            response += "\"id\":";
+            if (id->second.type == JSONScalar::Type::Number) {
+                response += id->second.value;
+            } else {
+                AppendJSONString(response, id->second.value);
+            }
+            response += ',';
+        }
+    }
+
+    auto result = [&]() -> ControlResponse {
+        if (!params.has_value()) {
+            return ControlResponse::Failure("Malformed request");
+        }
+
+        ControlRequest request;
+        for (auto &&[name, value] : *params) {
+            if (name == "command") {
+                request.command = std::move(value.value);
+            } else {
+                request.params.emplace(name, std::move(value.value));
+            }
+        }
+        if (request.command.empty()) {
+            return ControlResponse::Failure("Missing command");
+        }
+
+        auto handler = handlers_.find(request.command);
+        if (handler == handlers_.end()) {
+            return ControlResponse::Failure("Unknown command: " + request.command);
+        }
+
+        try {
+            return handler->second(request);
+        } catch (std::exception const &e) {
+            return ControlResponse::Failure(e.what());
+        }
+    }();
+
+    if (result.ok) {
+        response += "\"ok\":true,\"result\":";
+        response += result.payload.empty() ? "null" : result.payload;
+    } else {
+        response += "\"ok\":false,\"error\":";
+        AppendJSONString(response, result.payload);
+    }
+    response += '}';
+    return response;
+}
+
+void ControlServer::Run()
+{
+    while (running_) {
+        auto client = Accept(listener_);
+        if (client == kInvalidHandle) {
+            break;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(clientMutex_);
+            client_ = client;
+        }
+        Serve(client);
+        {
+            // Don't let `Stop` interrupt a handle that is being reused
+            std::lock_guard<std::mutex> lock(clientMutex_);
+            client_ = kInvalidHandle;
+            Disconnect(client);
+        }
+    }
+
+    finished_ = true;
+}
+
+void ControlServer::Serve(intptr_t client)
+{
+    std::string buffer;
+    char chunk[4096];
+    while (running_) {
+        auto bytesRead = Read(client, chunk, sizeof(chunk));
+        if (bytesRead <= 0) {
+            return;
+        }
+
+        buffer.append(chunk, static_cast<size_t>(bytesRead));
+
+        size_t start = 0;
+        for (auto end = buffer.find('\n'); end != std::string::npos;
+             end = buffer.find('\n', start)) {
+            auto line = std::string_view{buffer}.substr(start, end - start);
+            start = end + 1;
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.empty()) {
+                continue;
+            }
+
+            if (!Write(client, HandleLine(line) + '\n')) {
+                return;
+            }
+        }
+        buffer.erase(0, start);
+
+        if (buffer.size() > kMaxLineLength) {
+            Write(client, "{\"ok\":false,\"error\":\"Request too long\"}\n");
+            return;
+        }
+    }
+}
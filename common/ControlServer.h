@@ -0,0 +1,92 @@
+#ifndef COMMON_CONTROLSERVER_
+#define COMMON_CONTROLSERVER_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace ReactTestApp
+{
+    struct ControlRequest {
+        std::string command;
+        std::map<std::string, std::string, std::less<>> params;
+
+        /**
+         * Returns the value of the specified parameter, or an empty string if
+         * it was not set.
+         */
+        std::string_view Param(std::string_view name) const;
+    };
+
+    struct ControlResponse {
+        bool ok;
+
+        /**
+         * The result as a JSON value if successful; otherwise an error message.
+         */
+        std::string payload;
+
+        static ControlResponse Success(std::string result = {})
+        {
+            return {true, std::move(result)};
+        }
+
+        static ControlResponse Failure(std::string message)
+        {
+            return {false, std::move(message)};
+        }
+    };
+
+    using ControlHandler = std::function<ControlResponse(ControlRequest const &)>;
+
+    /**
+     * Local control channel for driving the test app from automation. Listens
+     * on a Unix domain socket, or a named pipe on Windows, and serves one
+     * client at a time. Each request is a single line containing a JSON
+     * object, e.g. `{"id": 1, "command": "load", "slug": "home"}`, and is
+     * answered with a single line, e.g. `{"id":1,"ok":true,"result":null}`.
+     * Clients that send lines longer than 64 KiB are disconnected.
+     *
+     * Handlers are invoked on the server thread and must be registered before
+     * the server is started.
+     */
+    class ControlServer
+    {
+    public:
+        explicit ControlServer(std::string address);
+        ~ControlServer();
+
+        ControlServer(ControlServer const &) = delete;
+        ControlServer &operator=(ControlServer const &) = delete;
+
+        void On(std::string command, ControlHandler handler);
+
+        bool Start();
+        void Stop();
+
+        /**
+         * Parses a single request line, dispatches it, and returns the
+         * response line without the trailing newline.
+         */
+        std::string HandleLine(std::string_view line) const;
+
+    private:
+        std::string address_;
+        std::map<std::string, ControlHandler, std::less<>> handlers_;
+        std::thread thread_;
+        std::atomic<bool> running_ = false;
+        std::atomic<bool> finished_ = false;
+        intptr_t listener_ = -1;
+        std::mutex clientMutex_;
+        intptr_t client_ = -1;
+
+        void Run();
+        void Serve(intptr_t client);
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_CONTROLSERVER_
@@ -0,0 +1,182 @@
+#ifndef COMMON_EVENTCHANNEL_
+#define COMMON_EVENTCHANNEL_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace ReactTestApp
+{
+    /**
+     * Bounded, lock-free single-producer/single-consumer queue. `TryPush` may
+     * only be called by one thread at a time, and `TryPop` by one other.
+     * Payloads are moved in and out, never copied.
+     */
+    template <typename T>
+    class SpscQueue
+    {
+    public:
+        /**
+         * Creates a queue that holds at least `capacity` elements.
+         */
+        explicit SpscQueue(size_t capacity)
+            : mask_(RoundUpToPowerOfTwo(capacity) - 1),
+              slots_(std::make_unique<std::optional<T>[]>(mask_ + 1))
+        {
+        }
+
+        SpscQueue(SpscQueue const &) = delete;
+        SpscQueue &operator=(SpscQueue const &) = delete;
+
+        size_t Capacity() const
+        {
+            return mask_ + 1;
+        }
+
+        bool TryPush(T &&value)
+        {
+            auto const tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cachedHead_ > mask_) {
+                cachedHead_ = head_.load(std::memory_order_acquire);
+                if (tail - cachedHead_ > mask_) {
+                    return false;
+                }
+            }
+
+            slots_[tail & mask_].emplace(std::move(value));
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::optional<T> TryPop()
+        {
+            auto const head = head_.load(std::memory_order_relaxed);
+            if (head == cachedTail_) {
+                cachedTail_ = tail_.load(std::memory_order_acquire);
+                if (head == cachedTail_) {
+                    return std::nullopt;
+                }
+            }
+
+            auto &slot = slots_[head & mask_];
+            std::optional<T> value{std::move(slot)};
+            slot.reset();
+            head_.store(head + 1, std::memory_order_release);
+            return value;
+        }
+
+        /**
+         * Returns whether the queue is empty. Only reliable on the consumer
+         * thread.
+         */
+        bool IsEmpty() const
+        {
+            return head_.load(std::memory_order_relaxed) ==
+                   tail_.load(std::memory_order_acquire);
+        }
+
+    private:
+        static size_t RoundUpToPowerOfTwo(size_t n)
+        {
+            size_t result = 1;
+            while (result < n) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        // Consumer and producer state live on separate cache lines so that
+        // the two threads do not invalidate each other's cached indices.
+        alignas(64) std::atomic<size_t> head_{0};
+        size_t cachedTail_ = 0;
+
+        alignas(64) std::atomic<size_t> tail_{0};
+        size_t cachedHead_ = 0;
+
+        alignas(64) size_t const mask_;
+        std::unique_ptr<std::optional<T>[]> const slots_;
+    };
+
+    /**
+     * Delivers events from one producer thread to a consumer thread, e.g. the
+     * UI thread, without locks or copies.
+     *
+     * `wakeup` is called on the producer thread when the consumer needs to be
+     * scheduled, and should post a call to `Drain` to the consumer's
+     * dispatcher. Wakeups are coalesced: while a drain is pending, sending
+     * more events does not schedule another one.
+     */
+    template <typename T>
+    class EventChannel
+    {
+    public:
+        using Wakeup = std::function<void()>;
+
+        EventChannel(size_t capacity, Wakeup wakeup)
+            : queue_(capacity), wakeup_(std::move(wakeup))
+        {
+        }
+
+        /**
+         * Sends `event` to the consumer. Returns `false` and drops the event if
+         * the channel is full.
+         */
+        bool Send(T &&event)
+        {
+            if (!queue_.TryPush(std::move(event))) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // Pairs with the fence in `Drain`: either the consumer sees this
+            // event, or we see that it is no longer scheduled.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!scheduled_.exchange(true, std::memory_order_relaxed)) {
+                wakeup_();
+            }
+            return true;
+        }
+
+        /**
+         * Passes every pending event to `handler` on the consumer thread and
+         * returns the number of events handled.
+         */
+        template <typename Handler>
+        size_t Drain(Handler &&handler)
+        {
+            size_t count = 0;
+            for (;;) {
+                while (auto event = queue_.TryPop()) {
+                    handler(std::move(*event));
+                    ++count;
+                }
+
+                scheduled_.store(false, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                // An event sent after the last pop may have seen the drain as
+                // still scheduled and skipped its wakeup
+                if (queue_.IsEmpty() || scheduled_.exchange(true, std::memory_order_relaxed)) {
+                    return count;
+                }
+            }
+        }
+
+        uint64_t Dropped() const
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        SpscQueue<T> queue_;
+        Wakeup wakeup_;
+        std::atomic<bool> scheduled_{false};
+        std::atomic<uint64_t> dropped_{0};
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_EVENTCHANNEL_
@@ -0,0 +1,95 @@
+#include "GrowableMapping.h"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif  // _WIN32
+
+using ReactTestApp::GrowableMapping;
+
+namespace
+{
+    // Commit in large steps so that a multi-megabyte download does not make
+    // a system call per received chunk
+    constexpr size_t kCommitGranularity = 1 << 20;
+
+#ifdef _WIN32
+    char *Reserve(size_t capacity)
+    {
+        return static_cast<char *>(VirtualAlloc(nullptr, capacity, MEM_RESERVE, PAGE_NOACCESS));
+    }
+
+    bool Commit(char *address, size_t size)
+    {
+        return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+    }
+
+    void Release(char *address, size_t)
+    {
+        VirtualFree(address, 0, MEM_RELEASE);
+    }
+#else
+    char *Reserve(size_t capacity)
+    {
+        auto address = mmap(
+            nullptr, capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        return address == MAP_FAILED ? nullptr : static_cast<char *>(address);
+    }
+
+    bool Commit(char *address, size_t size)
+    {
+        return mprotect(address, size, PROT_READ | PROT_WRITE) == 0;
+    }
+
+    void Release(char *address, size_t capacity)
+    {
+        munmap(address, capacity);
+    }
+#endif  // _WIN32
+}  // namespace
+
+GrowableMapping::GrowableMapping(size_t capacity) : capacity_(capacity)
+{
+    data_ = Reserve(capacity_);
+    if (data_ == nullptr) {
+        throw std::bad_alloc{};
+    }
+}
+
+GrowableMapping::~GrowableMapping()
+{
+    Release(data_, capacity_);
+}
+
+void GrowableMapping::Append(std::string_view data)
+{
+    if (data.empty()) {
+        return;
+    }
+    if (data.size() > capacity_ - size_) {
+        throw std::length_error("GrowableMapping capacity exceeded");
+    }
+
+    auto const required = size_ + data.size();
+    if (required > committed_) {
+        // Keeping `committed_` a multiple of the granularity, and thereby of
+        // the page size, makes every commit start on a page boundary
+        auto commit = (required - committed_ + kCommitGranularity - 1) / kCommitGranularity *
+                      kCommitGranularity;
+        if (commit > capacity_ - committed_) {
+            commit = capacity_ - committed_;
+        }
+        if (!Commit(data_ + committed_, commit)) {
+            throw std::bad_alloc{};
+        }
+        committed_ += commit;
+    }
+
+    std::memcpy(data_ + size_, data.data(), data.size());
+    size_ = required;
+}
@@ -0,0 +1,67 @@
+#ifndef COMMON_GROWABLEMAPPING_
+#define COMMON_GROWABLEMAPPING_
+
+#include <cstddef>
+#include <string_view>
+
+namespace ReactTestApp
+{
+    /**
+     * Append-only buffer backed by a reserved range of address space. Pages
+     * are committed as the buffer grows, so that data never moves and
+     * appending never copies what is already there, unlike a growing
+     * `std::string`. Suited to downloads of unknown size, e.g. bundles.
+     */
+    class GrowableMapping
+    {
+    public:
+        /** Default address space to reserve; nothing is committed up front. */
+        static constexpr size_t kDefaultCapacity = sizeof(void *) == 8 ? size_t{1} << 30
+                                                                        : size_t{1} << 28;
+
+        /**
+         * Reserves `capacity` bytes of address space. Throws `std::bad_alloc`
+         * if it cannot be reserved.
+         */
+        explicit GrowableMapping(size_t capacity = kDefaultCapacity);
+        ~GrowableMapping();
+
+        GrowableMapping(GrowableMapping const &) = delete;
+        GrowableMapping &operator=(GrowableMapping const &) = delete;
+
+        char const *Data() const
+        {
+            return data_;
+        }
+
+        size_t Size() const
+        {
+            return size_;
+        }
+
+        size_t Capacity() const
+        {
+            return capacity_;
+        }
+
+        std::string_view View() const
+        {
+            return {data_, size_};
+        }
+
+        /**
+         * Appends `data`, committing more pages if needed. Throws
+         * `std::length_error` if it does not fit in the reserved capacity, or
+         * `std::bad_alloc` if pages cannot be committed.
+         */
+        void Append(std::string_view data);
+
+    private:
+        char *data_ = nullptr;
+        size_t size_ = 0;
+        size_t committed_ = 0;
+        size_t capacity_ = 0;
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_GROWABLEMAPPING_
@@ -0,0 +1,160 @@
+#include "Histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using ReactTestApp::Histogram;
+using ReactTestApp::HistogramBuckets;
+using ReactTestApp::HistogramSnapshot;
+
+namespace
+{
+    constexpr uint64_t kSubBuckets = uint64_t{1} << HistogramBuckets::kSubBucketBits;
+
+    int FloorLog2(uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    void AppendNumber(std::string &out, char const *key, uint64_t value)
+    {
+        out += '"';
+        out += key;
+        out += "\":";
+        out += std::to_string(value);
+    }
+}  // namespace
+
+size_t HistogramBuckets::IndexOf(uint64_t value)
+{
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+
+    auto exponent = FloorLog2(value);
+    if (exponent > kMaxExponent) {
+        return kCount - 1;
+    }
+
+    auto subBucket = (value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return static_cast<size_t>((exponent - kSubBucketBits + 1) * kSubBuckets + subBucket);
+}
+
+uint64_t HistogramBuckets::LowerBound(size_t index)
+{
+    if (index < kSubBuckets) {
+        return index;
+    }
+
+    auto exponent = static_cast<int>(index / kSubBuckets) + kSubBucketBits - 1;
+    auto subBucket = index % kSubBuckets;
+    return (kSubBuckets + subBucket) << (exponent - kSubBucketBits);
+}
+
+uint64_t HistogramBuckets::UpperBound(size_t index)
+{
+    if (index + 1 >= kCount) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return LowerBound(index + 1) - 1;
+}
+
+void HistogramSnapshot::Merge(HistogramSnapshot const &other)
+{
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum += other.sum;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+uint64_t HistogramSnapshot::Percentile(double percentile) const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    auto const fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    auto rank = static_cast<uint64_t>(std::ceil(fraction * count));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::clamp(HistogramBuckets::UpperBound(i), min, max);
+        }
+    }
+    return max;
+}
+
+void HistogramSnapshot::AppendJSON(std::string &out) const
+{
+    out += '{';
+    AppendNumber(out, "count", count);
+    out += ',';
+    AppendNumber(out, "min", count == 0 ? 0 : min);
+    out += ',';
+    AppendNumber(out, "max", max);
+    out += ',';
+    AppendNumber(out, "mean", static_cast<uint64_t>(Mean()));
+    out += ',';
+    AppendNumber(out, "p50", Percentile(50));
+    out += ',';
+    AppendNumber(out, "p90", Percentile(90));
+    out += ',';
+    AppendNumber(out, "p99", Percentile(99));
+    out += '}';
+}
+
+void Histogram::Record(uint64_t value)
+{
+    // Single writer: plain loads and stores avoid locked read-modify-writes
+    // while still letting `Snapshot()` read concurrently.
+    auto &bucket = counts_[HistogramBuckets::IndexOf(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value < min_.load(std::memory_order_relaxed)) {
+        min_.store(value, std::memory_order_relaxed);
+    }
+    if (value > max_.load(std::memory_order_relaxed)) {
+        max_.store(value, std::memory_order_relaxed);
+    }
+}
+
+HistogramSnapshot Histogram::Snapshot() const
+{
+    HistogramSnapshot snapshot;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        snapshot.counts[i] = counts_[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count = count_.load(std::memory_order_relaxed);
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    snapshot.min = min_.load(std::memory_order_relaxed);
+    snapshot.max = max_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void Histogram::Reset()
+{
+    for (auto &count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,83 @@
+#ifndef COMMON_HISTOGRAM_
+#define COMMON_HISTOGRAM_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace ReactTestApp
+{
+    /**
+     * Log-linear bucket layout shared by `Histogram` and `HistogramSnapshot`.
+     * Values below 8 get their own bucket; above that, each power of two is
+     * split into 8 sub-buckets, which bounds the relative error at 12.5%.
+     */
+    struct HistogramBuckets {
+        static constexpr int kSubBucketBits = 3;
+        static constexpr int kMaxExponent = 47;
+        static constexpr size_t kCount = (kMaxExponent - kSubBucketBits + 2) << kSubBucketBits;
+
+        static size_t IndexOf(uint64_t value);
+        static uint64_t LowerBound(size_t index);
+        static uint64_t UpperBound(size_t index);
+    };
+
+    /**
+     * Point-in-time copy of a histogram. Snapshots can be merged, e.g. to
+     * combine per-thread shards.
+     */
+    struct HistogramSnapshot {
+        std::array<uint64_t, HistogramBuckets::kCount> counts{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t min = std::numeric_limits<uint64_t>::max();
+        uint64_t max = 0;
+
+        void Merge(HistogramSnapshot const &other);
+
+        /**
+         * Returns an upper bound for the value at `percentile` (0-100), or 0
+         * if the histogram is empty.
+         */
+        uint64_t Percentile(double percentile) const;
+
+        double Mean() const
+        {
+            return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+        }
+
+        /**
+         * Appends a JSON object with count, min, max, mean and common
+         * percentiles.
+         */
+        void AppendJSON(std::string &out) const;
+    };
+
+    /**
+     * Fixed-size histogram of non-negative integers, e.g. latencies in
+     * nanoseconds. Recording is wait-free and may race with `Snapshot()`, but
+     * there must only be a single writer; use one per thread and merge the
+     * snapshots.
+     */
+    class Histogram
+    {
+    public:
+        void Record(uint64_t value);
+
+        HistogramSnapshot Snapshot() const;
+
+        void Reset();
+
+    private:
+        std::array<std::atomic<uint64_t>, HistogramBuckets::kCount> counts_{};
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> sum_{0};
+        std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> max_{0};
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_HISTOGRAM_
@@ -0,0 +1,339 @@
+#include "JSON.h"
+
+#include <cstdint>
+#include <cstdio>
+
+using ReactTestApp::JSONScalar;
+
+namespace
+{
+    class Parser
+    {
+    public:
+        explicit Parser(std::string_view input) : input_(input)
+        {
+        }
+
+        bool AtEnd()
+        {
+            SkipWhitespace();
+            return pos_ == input_.size();
+        }
+
+        bool Consume(char c)
+        {
+            SkipWhitespace();
+            if (pos_ < input_.size() && input_[pos_] == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        bool Peek(char c)
+        {
+            SkipWhitespace();
+            return pos_ < input_.size() && input_[pos_] == c;
+        }
+
+        std::optional<std::string> String()
+        {
+            if (!Consume('"')) {
+                return std::nullopt;
+            }
+
+            std::string result;
+            while (pos_ < input_.size()) {
+                char c = input_[pos_++];
+                if (c == '"') {
+                    return result;
+                }
+
+                if (c != '\\') {
+                    result += c;
+                    continue;
+                }
+
+                if (pos_ == input_.size()) {
+                    return std::nullopt;
+                }
+
+                switch (input_[pos_++]) {
+                    case '"':
+                        result += '"';
+                        break;
+                    case '\\':
+                        result += '\\';
+                        break;
+                    case '/':
+                        result += '/';
+                        break;
+                    case 'b':
+                        result += '\b';
+                        break;
+                    case 'f':
+                        result += '\f';
+                        break;
+                    case 'n':
+                        result += '\n';
+                        break;
+                    case 'r':
+                        result += '\r';
+                        break;
+                    case 't':
+                        result += '\t';
+                        break;
+                    case 'u': {
+                        auto codePoint = CodePoint();
+                        if (!codePoint.has_value()) {
+                            return std::nullopt;
+                        }
+                        AppendUTF8(result, *codePoint);
+                        break;
+                    }
+                    default:
+                        return std::nullopt;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        std::optional<std::string> Number()
+        {
+            // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+            SkipWhitespace();
+            auto start = pos_;
+            Skip('-');
+            if (!Skip('0') && Digits() == 0) {
+                return std::nullopt;
+            }
+            if (Skip('.') && Digits() == 0) {
+                return std::nullopt;
+            }
+            if (Skip('e') || Skip('E')) {
+                if (!Skip('+')) {
+                    Skip('-');
+                }
+                if (Digits() == 0) {
+                    return std::nullopt;
+                }
+            }
+            return std::string{input_.substr(start, pos_ - start)};
+        }
+
+        bool Keyword(std::string_view keyword)
+        {
+            SkipWhitespace();
+            if (input_.substr(pos_, keyword.size()) != keyword) {
+                return false;
+            }
+            pos_ += keyword.size();
+            return true;
+        }
+
+    private:
+        std::string_view input_;
+        size_t pos_ = 0;
+
+        void SkipWhitespace()
+        {
+            while (pos_ < input_.size()) {
+                char c = input_[pos_];
+                if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                    break;
+                }
+                ++pos_;
+            }
+        }
+
+        bool Skip(char c)
+        {
+            if (pos_ < input_.size() && input_[pos_] == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        size_t Digits()
+        {
+            auto start = pos_;
+            while (pos_ < input_.size() && input_[pos_] >= '0' && input_[pos_] <= '9') {
+                ++pos_;
+            }
+            return pos_ - start;
+        }
+
+        /**
+         * Decodes the code point of a `\u` escape sequence, combining
+         * surrogate pairs. Unpaired surrogates cannot be encoded as UTF-8 and
+         * are replaced with U+FFFD.
+         */
+        std::optional<uint32_t> CodePoint()
+        {
+            constexpr uint32_t kReplacementCharacter = 0xFFFD;
+
+            auto unit = CodeUnit();
+            if (!unit.has_value()) {
+                return std::nullopt;
+            }
+            if (*unit >= 0xDC00 && *unit <= 0xDFFF) {
+                return kReplacementCharacter;
+            }
+            if (*unit < 0xD800 || *unit > 0xDBFF) {
+                return unit;
+            }
+
+            if (input_.substr(pos_, 2) != "\\u") {
+                return kReplacementCharacter;
+            }
+
+            auto const next = pos_;
+            pos_ += 2;
+            auto low = CodeUnit();
+            if (!low.has_value()) {
+                return std::nullopt;
+            }
+            if (*low < 0xDC00 || *low > 0xDFFF) {
+                // Leave the second escape sequence to be decoded on its own
+                pos_ = next;
+                return kReplacementCharacter;
+            }
+            return 0x10000 + ((*unit - 0xD800) << 10) + (*low - 0xDC00);
+        }
+
+        std::optional<uint32_t> CodeUnit()
+        {
+            if (input_.size() - pos_ < 4) {
+                return std::nullopt;
+            }
+
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                char c = input_[pos_++];
+                value <<= 4;
+                if (c >= '0' && c <= '9') {
+                    value |= c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    value |= c - 'a' + 10;
+                } else if (c >= 'A' && c <= 'F') {
+                    value |= c - 'A' + 10;
+                } else {
+                    return std::nullopt;
+                }
+            }
+            return value;
+        }
+
+        static void AppendUTF8(std::string &out, uint32_t codePoint)
+        {
+            if (codePoint < 0x80) {
+                out += static_cast<char>(codePoint);
+            } else if (codePoint < 0x800) {
+                out += static_cast<char>(0xC0 | (codePoint >> 6));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            } else if (codePoint < 0x10000) {
+                out += static_cast<char>(0xE0 | (codePoint >> 12));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (codePoint >> 18));
+                out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+    };
+}  // namespace
+
+std::optional<std::map<std::string, JSONScalar, std::less<>>>
+ReactTestApp::ParseFlatJSONObject(std::string_view json)
+{
+    Parser parser{json};
+    if (!parser.Consume('{')) {
+        return std::nullopt;
+    }
+
+    auto parseValue = [&parser]() -> std::optional<JSONScalar> {
+        using Type = JSONScalar::Type;
+        if (parser.Peek('"')) {
+            auto value = parser.String();
+            return value.has_value() ? std::make_optional(JSONScalar{Type::String, *value})
+                                     : std::nullopt;
+        }
+        if (parser.Keyword("true")) {
+            return JSONScalar{Type::Boolean, "true"};
+        }
+        if (parser.Keyword("false")) {
+            return JSONScalar{Type::Boolean, "false"};
+        }
+        if (parser.Keyword("null")) {
+            return JSONScalar{Type::Null, "null"};
+        }
+        auto value = parser.Number();
+        return value.has_value() ? std::make_optional(JSONScalar{Type::Number, *value})
+                                 : std::nullopt;
+    };
+
+    std::map<std::string, JSONScalar, std::less<>> result;
+    if (!parser.Consume('}')) {
+        do {
+            auto key = parser.String();
+            if (!key.has_value() || !parser.Consume(':')) {
+                return std::nullopt;
+            }
+
+            auto value = parseValue();
+            if (!value.has_value()) {
+                return std::nullopt;
+            }
+
+            result.insert_or_assign(std::move(*key), std::move(*value));
+        } while (parser.Consume(','));
+
+        if (!parser.Consume('}')) {
+            return std::nullopt;
+        }
+    }
+
+    if (!parser.AtEnd()) {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+void ReactTestApp::AppendJSONString(std::string &out, std::string_view value)
+{
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[7];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+                break;
+        }
+    }
+    out += '"';
+}
@@ -0,0 +1,41 @@
+#ifndef COMMON_JSON_
+#define COMMON_JSON_
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ReactTestApp
+{
+    struct JSONScalar {
+        enum class Type {
+            String,
+            Number,
+            Boolean,
+            Null,
+        };
+
+        Type type;
+
+        /**
+         * The unescaped value of a string; otherwise the value as it appeared
+         * in the input, e.g. `-1.5e3` or `true`.
+         */
+        std::string value;
+    };
+
+    /**
+     * Parses a JSON object whose values are all scalars. Returns nothing if
+     * the input is not such an object.
+     */
+    std::optional<std::map<std::string, JSONScalar, std::less<>>>
+    ParseFlatJSONObject(std::string_view json);
+
+    /**
+     * Appends `value` to `out` as a quoted and escaped JSON string.
+     */
+    void AppendJSONString(std::string &out, std::string_view value);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_JSON_
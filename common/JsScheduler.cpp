@@ -0,0 +1,135 @@
+#include "JsScheduler.h"
+
+using facebook::jsi::Runtime;
+using ReactTestApp::JsScheduler;
+
+JsScheduler::JsScheduler() : state_(std::make_shared<State>())
+{
+}
+
+JsScheduler::~JsScheduler()
+{
+    CancelPending(*state_);
+}
+
+void JsScheduler::Attach(Dispatch dispatch)
+{
+    // Jobs for the runtime that was attached before must not run on this one
+    std::vector<Job> cancelled;
+    uint64_t generation = 0;
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (state_->dispatch) {
+            ++state_->generation;
+            cancelled.swap(state_->pending);
+        }
+
+        state_->dispatch = dispatch;
+        state_->scheduled = !state_->pending.empty();
+        if (state_->scheduled) {
+            // Jobs held while detached were submitted for whichever runtime
+            // loads next, i.e. this one
+            ++state_->dispatches;
+            schedule = true;
+        }
+        generation = state_->generation;
+    }
+
+    for (auto &&job : cancelled) {
+        job.cancel();
+    }
+
+    if (schedule) {
+        Schedule(state_, dispatch, generation);
+    }
+}
+
+void JsScheduler::Detach()
+{
+    CancelPending(*state_);
+}
+
+uint64_t JsScheduler::Dispatches() const
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->dispatches;
+}
+
+void JsScheduler::Submit(Job &&job)
+{
+    Dispatch dispatch;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        job.generation = state_->generation;
+        state_->pending.push_back(std::move(job));
+        if (!state_->dispatch || state_->scheduled) {
+            return;
+        }
+
+        state_->scheduled = true;
+        ++state_->dispatches;
+        dispatch = state_->dispatch;
+        generation = state_->generation;
+    }
+
+    Schedule(state_, dispatch, generation);
+}
+
+void JsScheduler::Schedule(std::shared_ptr<State> const &state,
+                           Dispatch const &dispatch,
+                           uint64_t generation)
+{
+    dispatch([weakState = std::weak_ptr<State>(state), generation](Runtime &runtime) {
+        if (auto state = weakState.lock()) {
+            RunPending(*state, runtime, generation);
+        }
+    });
+}
+
+void JsScheduler::RunPending(State &state, Runtime &runtime, uint64_t generation)
+{
+    std::vector<Job> jobs;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (generation != state.generation) {
+            // The batch was dispatched to a runtime that has since been
+            // replaced; a new batch was scheduled for any jobs submitted after
+            return;
+        }
+
+        state.scheduled = false;
+        jobs.swap(state.pending);
+    }
+
+    for (auto &&job : jobs) {
+        bool cancelled = false;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            cancelled = job.generation != state.generation;
+        }
+
+        if (cancelled) {
+            job.cancel();
+        } else {
+            job.run(runtime);
+        }
+    }
+}
+
+void JsScheduler::CancelPending(State &state)
+{
+    std::vector<Job> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        ++state.generation;
+        state.dispatch = nullptr;
+        state.scheduled = false;
+        cancelled.swap(state.pending);
+    }
+
+    for (auto &&job : cancelled) {
+        job.cancel();
+    }
+}
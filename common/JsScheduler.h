@@ -0,0 +1,246 @@
+#ifndef COMMON_JSSCHEDULER_
+#define COMMON_JSSCHEDULER_
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace facebook::jsi
+{
+    class Runtime;
+}
+
+namespace ReactTestApp
+{
+    /**
+     * Thrown when awaiting a job that was cancelled before it ran, e.g.
+     * because the instance was reloaded.
+     */
+    class JsTaskCancelled : public std::runtime_error
+    {
+    public:
+        JsTaskCancelled() : std::runtime_error("JS task was cancelled")
+        {
+        }
+    };
+
+    namespace detail
+    {
+        struct Void {
+        };
+
+        template <typename T>
+        class JsTaskState
+        {
+        public:
+            using Value = std::conditional_t<std::is_void_v<T>, Void, T>;
+
+            void Resolve(Value &&value)
+            {
+                Complete(std::move(value));
+            }
+
+            void Reject(std::exception_ptr error)
+            {
+                Complete(std::move(error));
+            }
+
+            bool IsReady()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return result_.index() != 0;
+            }
+
+            /**
+             * Registers `resume` to be called once a result is set. Returns
+             * `false` if there is already a result, in which case `resume` is
+             * not called.
+             */
+            bool Suspend(std::function<void()> resume)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (result_.index() != 0) {
+                    return false;
+                }
+
+                resume_ = std::move(resume);
+                return true;
+            }
+
+            T Take()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (auto error = std::get_if<std::exception_ptr>(&result_)) {
+                    std::rethrow_exception(*error);
+                }
+
+                if constexpr (!std::is_void_v<T>) {
+                    return std::move(std::get<Value>(result_));
+                }
+            }
+
+        private:
+            template <typename R>
+            void Complete(R &&result)
+            {
+                std::function<void()> resume;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (result_.index() != 0) {
+                        return;
+                    }
+
+                    result_ = std::forward<R>(result);
+                    resume = std::move(resume_);
+                }
+
+                if (resume) {
+                    resume();
+                }
+            }
+
+            std::mutex mutex_;
+            std::variant<std::monostate, Value, std::exception_ptr> result_;
+            std::function<void()> resume_;
+        };
+    }  // namespace detail
+
+    /**
+     * Result of a job scheduled with `JsScheduler::RunOnJs`. It can be
+     * `co_await`-ed from any coroutine; the awaiting coroutine is resumed on
+     * the JS thread, or inline if the job has already finished.
+     */
+    template <typename T>
+    class JsTask
+    {
+    public:
+        explicit JsTask(std::shared_ptr<detail::JsTaskState<T>> state) : state_(std::move(state))
+        {
+        }
+
+        bool await_ready() const
+        {
+            return state_->IsReady();
+        }
+
+        template <typename Handle>
+        bool await_suspend(Handle handle)
+        {
+            return state_->Suspend([handle]() mutable { handle.resume(); });
+        }
+
+        T await_resume()
+        {
+            return state_->Take();
+        }
+
+    private:
+        std::shared_ptr<detail::JsTaskState<T>> state_;
+    };
+
+    /**
+     * Runs jobs that need the JS runtime on the JS thread. Jobs submitted
+     * before the JS thread gets to them are coalesced and run in a single
+     * dispatch. Jobs submitted while no runtime is attached, e.g. before the
+     * instance has loaded, are held until one is.
+     */
+    class JsScheduler
+    {
+    public:
+        using Batch = std::function<void(facebook::jsi::Runtime &)>;
+        using Dispatch = std::function<void(Batch)>;
+
+        JsScheduler();
+        ~JsScheduler();
+
+        JsScheduler(JsScheduler const &) = delete;
+        JsScheduler &operator=(JsScheduler const &) = delete;
+
+        /**
+         * Attaches the runtime that has just loaded. `dispatch` must run the
+         * given batch on its JS thread, e.g. with `ExecuteJsi` on Windows, and
+         * should hold on to what it needs for that by value. Jobs that were
+         * held while no runtime was attached are dispatched now; jobs for a
+         * previously attached runtime are cancelled.
+         */
+        void Attach(Dispatch dispatch);
+
+        /**
+         * Cancels all jobs that have not started yet, and holds on to new ones
+         * until the next `Attach`. Call this when the attached runtime goes
+         * away, e.g. on reload.
+         */
+        void Detach();
+
+        /**
+         * Schedules `job` to be called with the runtime on the JS thread.
+         * Exceptions thrown by `job` are rethrown when the result is awaited.
+         */
+        template <typename F>
+        auto RunOnJs(F &&job) -> JsTask<std::invoke_result_t<F &, facebook::jsi::Runtime &>>
+        {
+            using T = std::invoke_result_t<F &, facebook::jsi::Runtime &>;
+
+            auto state = std::make_shared<detail::JsTaskState<T>>();
+            Submit(Job{
+                [state, job = std::forward<F>(job)](facebook::jsi::Runtime &runtime) mutable {
+                    try {
+                        if constexpr (std::is_void_v<T>) {
+                            job(runtime);
+                            state->Resolve({});
+                        } else {
+                            state->Resolve(job(runtime));
+                        }
+                    } catch (...) {
+                        state->Reject(std::current_exception());
+                    }
+                },
+                [state]() { state->Reject(std::make_exception_ptr(JsTaskCancelled{})); },
+                0,
+            });
+            return JsTask<T>{std::move(state)};
+        }
+
+        /**
+         * Returns the number of times a batch was dispatched to the JS thread.
+         */
+        uint64_t Dispatches() const;
+
+    private:
+        struct Job {
+            std::function<void(facebook::jsi::Runtime &)> run;
+            std::function<void()> cancel;
+            uint64_t generation;
+        };
+
+        // Batches only hold on to the state weakly, so that one that reaches
+        // the JS thread after the scheduler is gone does nothing
+        struct State {
+            std::mutex mutex;
+            Dispatch dispatch;
+            std::vector<Job> pending;
+            uint64_t generation = 0;
+            uint64_t dispatches = 0;
+            bool scheduled = false;
+        };
+
+        std::shared_ptr<State> state_;
+
+        void Submit(Job &&job);
+
+        static void Schedule(std::shared_ptr<State> const &state,
+                             Dispatch const &dispatch,
+                             uint64_t generation);
+        static void RunPending(State &state, facebook::jsi::Runtime &runtime, uint64_t generation);
+        static void CancelPending(State &state);
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_JSSCHEDULER_
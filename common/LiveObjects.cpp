@@ -0,0 +1,89 @@
+#include "LiveObjects.h"
+
+#include <mutex>
+
+using ReactTestApp::LiveObjectCounter;
+
+namespace
+{
+    struct LiveObjectRegistry {
+        std::mutex mutex;
+        std::map<std::string, std::unique_ptr<LiveObjectCounter>, std::less<>> counters;
+    };
+
+    LiveObjectRegistry &GetRegistry()
+    {
+        // Intentionally leaked so that objects destroyed during static
+        // destruction can still decrement their counters
+        static auto registry = new LiveObjectRegistry();
+        return *registry;
+    }
+}  // namespace
+
+LiveObjectCounter &ReactTestApp::GetLiveObjectCounter(std::string_view kind)
+{
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto counter = registry.counters.find(kind);
+    if (counter == registry.counters.end()) {
+        counter =
+            registry.counters.emplace(std::string{kind}, std::make_unique<LiveObjectCounter>())
+                .first;
+    }
+    return *counter->second;
+}
+
+std::map<std::string, int64_t, std::less<>> ReactTestApp::GetLiveObjectCounts()
+{
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::map<std::string, int64_t, std::less<>> counts;
+    for (auto const &[kind, counter] : registry.counters) {
+        counts.emplace(kind, counter->Count());
+    }
+    return counts;
+}
+
+#if __has_include(<jsi/jsi.h>)
+#include <jsi/jsi.h>
+
+namespace
+{
+    // Host objects are finalized when the runtime that holds them is
+    // destroyed, which makes them a portable way to observe runtime lifetime
+    class RuntimeLifetimeToken : public facebook::jsi::HostObject
+    {
+    public:
+        RuntimeLifetimeToken() : token_(ReactTestApp::GetLiveObjectCounter("jsRuntimes"))
+        {
+        }
+
+    private:
+        ReactTestApp::LiveObject token_;
+    };
+}  // namespace
+
+void ReactTestApp::TrackRuntimeLifetime(facebook::jsi::Runtime &runtime)
+{
+    constexpr char kPropertyName[] = "__rntaRuntimeLifetime";
+
+    auto global = runtime.global();
+    if (global.hasProperty(runtime, kPropertyName)) {
+        return;
+    }
+
+    global.setProperty(runtime,
+                       kPropertyName,
+                       facebook::jsi::Object::createFromHostObject(
+                           runtime, std::make_shared<RuntimeLifetimeToken>()));
+}
+
+#else
+
+void ReactTestApp::TrackRuntimeLifetime(facebook::jsi::Runtime &)
+{
+}
+
+#endif  // __has_include(<jsi/jsi.h>)
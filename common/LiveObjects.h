@@ -0,0 +1,109 @@
+#ifndef COMMON_LIVEOBJECTS_
+#define COMMON_LIVEOBJECTS_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace facebook::jsi
+{
+    class Runtime;
+}
+
+namespace ReactTestApp
+{
+    /**
+     * Number of live objects of a kind, e.g. runtimes or native modules.
+     */
+    class LiveObjectCounter
+    {
+    public:
+        void Increment()
+        {
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void Decrement()
+        {
+            count_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        int64_t Count() const
+        {
+            return count_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<int64_t> count_{0};
+    };
+
+    /**
+     * Returns the counter for `kind`. Counters are never destroyed, so the
+     * reference may be kept.
+     */
+    LiveObjectCounter &GetLiveObjectCounter(std::string_view kind);
+
+    /**
+     * Returns the current count of every kind of object.
+     */
+    std::map<std::string, int64_t, std::less<>> GetLiveObjectCounts();
+
+    /**
+     * Counts as one live object for as long as it exists. Embed it in the
+     * object to track.
+     */
+    class LiveObject
+    {
+    public:
+        explicit LiveObject(LiveObjectCounter &counter) : counter_(&counter)
+        {
+            counter_->Increment();
+        }
+
+        LiveObject(LiveObject const &other) : LiveObject(*other.counter_)
+        {
+        }
+        LiveObject &operator=(LiveObject const &) = delete;
+
+        ~LiveObject()
+        {
+            counter_->Decrement();
+        }
+
+    private:
+        LiveObjectCounter *counter_;
+    };
+
+    /**
+     * Returns a pointer that shares ownership of `object` and counts it as
+     * live until the last copy is released. Unlike wrapping the object, this
+     * adds no indirection to its use.
+     */
+    template <typename T>
+    std::shared_ptr<T> TrackLifetime(std::shared_ptr<T> object, LiveObjectCounter &counter)
+    {
+        if (object == nullptr) {
+            return object;
+        }
+
+        struct Tracked {
+            LiveObject token;
+            std::shared_ptr<T> object;
+        };
+
+        auto tracked = std::make_shared<Tracked>(Tracked{LiveObject{counter}, std::move(object)});
+        auto pointer = tracked->object.get();
+        return std::shared_ptr<T>(std::move(tracked), pointer);
+    }
+
+    /**
+     * Counts `runtime` as a live `jsRuntimes` object until it is destroyed.
+     */
+    void TrackRuntimeLifetime(facebook::jsi::Runtime &runtime);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_LIVEOBJECTS_
@@ -0,0 +1,192 @@
+#include "MemoryMonitor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif  // defined(_WIN32)
+
+#include "Metrics.h"
+#include "OutputFile.h"
+
+using ReactTestApp::MemoryBudget;
+using ReactTestApp::MemorySample;
+using ReactTestApp::ProcessMemoryInfo;
+
+namespace
+{
+    std::optional<uint64_t> ParseMegabytes(char const *value)
+    {
+        if (value == nullptr || *value == '\0') {
+            return std::nullopt;
+        }
+
+        char *end = nullptr;
+        auto megabytes = std::strtoull(value, &end, 10);
+        if (*end != '\0' || megabytes == 0) {
+            return std::nullopt;
+        }
+        return megabytes * 1024 * 1024;
+    }
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+    // Returns the value of a `/proc/self/status` field in bytes
+    std::optional<uint64_t> ReadStatusField(char const *line, char const *field)
+    {
+        auto const length = std::strlen(field);
+        if (std::strncmp(line, field, length) != 0) {
+            return std::nullopt;
+        }
+
+        unsigned long long kilobytes = 0;
+        if (std::sscanf(line + length, " %llu kB", &kilobytes) != 1) {
+            return std::nullopt;
+        }
+        return static_cast<uint64_t>(kilobytes) * 1024;
+    }
+#endif  // !defined(_WIN32) && !defined(__APPLE__)
+}  // namespace
+
+std::optional<ProcessMemoryInfo> ReactTestApp::SampleProcessMemory()
+{
+#if defined(_WIN32)
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!::GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return std::nullopt;
+    }
+    return ProcessMemoryInfo{counters.WorkingSetSize, counters.PeakWorkingSetSize};
+#else
+    // Process memory counters are not available to UWP apps
+    return std::nullopt;
+#endif  // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(),
+                  MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info),
+                  &count) != KERN_SUCCESS) {
+        return std::nullopt;
+    }
+    return ProcessMemoryInfo{info.resident_size, info.resident_size_max};
+#else
+    auto status = std::fopen("/proc/self/status", "r");
+    if (status == nullptr) {
+        return std::nullopt;
+    }
+
+    std::optional<uint64_t> resident;
+    std::optional<uint64_t> peak;
+    char line[256];
+    while (std::fgets(line, sizeof(line), status) != nullptr) {
+        if (auto value = ReadStatusField(line, "VmRSS:")) {
+            resident = value;
+        } else if (auto value = ReadStatusField(line, "VmHWM:")) {
+            peak = value;
+        }
+    }
+    std::fclose(status);
+
+    if (!resident.has_value()) {
+        return std::nullopt;
+    }
+    return ProcessMemoryInfo{*resident, peak.value_or(*resident)};
+#endif  // defined(_WIN32)
+}
+
+MemoryBudget MemoryBudget::Parse(char const *jsHeapMegabytes, char const *residentMegabytes)
+{
+    return MemoryBudget{ParseMegabytes(jsHeapMegabytes), ParseMegabytes(residentMegabytes)};
+}
+
+MemoryBudget MemoryBudget::FromEnvironment()
+{
+    return Parse(std::getenv("REACT_TEST_APP_JS_HEAP_BUDGET_MB"),
+                 std::getenv("REACT_TEST_APP_RSS_BUDGET_MB"));
+}
+
+bool MemoryBudget::IsExceededBy(MemorySample const &sample) const
+{
+    if (jsHeapBytes.has_value() && sample.jsHeapBytes.value_or(0) > *jsHeapBytes) {
+        return true;
+    }
+    if (residentBytes.has_value() && sample.process.has_value() &&
+        sample.process->residentBytes > *residentBytes) {
+        return true;
+    }
+    return false;
+}
+
+void ReactTestApp::RecordMemorySample(MemorySample const &sample)
+{
+    auto &metrics = Metrics::Shared();
+    auto const record = [&metrics, &sample](std::string_view name, uint64_t value) {
+        auto const gauge = static_cast<int64_t>(value);
+        metrics.GetGauge(name).Set(gauge);
+        metrics.GetGauge("memory." + sample.component + '.' + std::string{name}).Set(gauge);
+    };
+
+    if (sample.jsHeapBytes.has_value()) {
+        record("jsHeapBytes", *sample.jsHeapBytes);
+    }
+    if (sample.process.has_value()) {
+        record("residentBytes", sample.process->residentBytes);
+        record("peakResidentBytes", sample.process->peakResidentBytes);
+    }
+}
+
+#if __has_include(<jsi/jsi.h>)
+#include <jsi/jsi.h>
+
+std::optional<std::string> ReactTestApp::CheckComponentMemory(facebook::jsi::Runtime &runtime,
+                                                              std::string_view component,
+                                                              MemoryBudget const &budget,
+                                                              std::string_view snapshotDirectory)
+{
+    auto &instrumentation = runtime.instrumentation();
+
+    MemorySample sample{std::string{component}, std::nullopt, SampleProcessMemory()};
+
+    // Only Hermes reports heap usage; other engines return an empty map
+    auto heapInfo = instrumentation.getHeapInfo(false);
+    auto allocated = heapInfo.find("hermes_allocatedBytes");
+    if (allocated != heapInfo.end() && allocated->second >= 0) {
+        sample.jsHeapBytes = static_cast<uint64_t>(allocated->second);
+    }
+
+    RecordMemorySample(sample);
+
+    if (!budget.IsExceededBy(sample)) {
+        return std::nullopt;
+    }
+
+    auto path = JoinOutputPath(
+        snapshotDirectory,
+        MakeOutputFileName(component, std::chrono::system_clock::now(), ".heapsnapshot"));
+    try {
+        instrumentation.createSnapshotToFile(path);
+    } catch (facebook::jsi::JSIException const &) {
+        return std::nullopt;
+    }
+    return path;
+}
+
+#else
+
+std::optional<std::string> ReactTestApp::CheckComponentMemory(facebook::jsi::Runtime &,
+                                                              std::string_view,
+                                                              MemoryBudget const &,
+                                                              std::string_view)
+{
+    return std::nullopt;
+}
+
+#endif  // __has_include(<jsi/jsi.h>)
@@ -0,0 +1,74 @@
+#ifndef COMMON_MEMORYMONITOR_
+#define COMMON_MEMORYMONITOR_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace facebook::jsi
+{
+    class Runtime;
+}
+
+namespace ReactTestApp
+{
+    struct ProcessMemoryInfo {
+        uint64_t residentBytes;
+        /** Highest resident set size since the process started. */
+        uint64_t peakResidentBytes;
+    };
+
+    /**
+     * Returns the resident set size of the current process, or nothing if it
+     * cannot be determined on this platform.
+     */
+    std::optional<ProcessMemoryInfo> SampleProcessMemory();
+
+    struct MemorySample {
+        std::string component;
+        std::optional<uint64_t> jsHeapBytes;
+        std::optional<ProcessMemoryInfo> process;
+    };
+
+    /**
+     * Limits above which a component is considered to use too much memory.
+     */
+    struct MemoryBudget {
+        std::optional<uint64_t> jsHeapBytes;
+        std::optional<uint64_t> residentBytes;
+
+        /**
+         * Parses limits given in megabytes. Empty, zero, or invalid values
+         * mean no limit.
+         */
+        static MemoryBudget Parse(char const *jsHeapMegabytes, char const *residentMegabytes);
+
+        /**
+         * Reads `REACT_TEST_APP_JS_HEAP_BUDGET_MB` and
+         * `REACT_TEST_APP_RSS_BUDGET_MB` from the environment.
+         */
+        static MemoryBudget FromEnvironment();
+
+        bool IsExceededBy(MemorySample const &sample) const;
+    };
+
+    /**
+     * Records `sample` to the shared metrics registry, both as the latest
+     * process-wide values and per component.
+     */
+    void RecordMemorySample(MemorySample const &sample);
+
+    /**
+     * Samples memory used while `component` was presented, records it, and
+     * writes a heap snapshot to `snapshotDirectory` if the sample exceeds
+     * `budget`. Must be called on the JS thread. Returns the path of the heap
+     * snapshot, if one was written.
+     */
+    std::optional<std::string> CheckComponentMemory(facebook::jsi::Runtime &runtime,
+                                                    std::string_view component,
+                                                    MemoryBudget const &budget,
+                                                    std::string_view snapshotDirectory);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_MEMORYMONITOR_
@@ -0,0 +1,263 @@
+#include "Metrics.h"
+
+#include <algorithm>
+
+#include "JSON.h"
+
+using ReactTestApp::Counter;
+using ReactTestApp::Gauge;
+using ReactTestApp::HistogramMetric;
+using ReactTestApp::Metrics;
+using ReactTestApp::MetricsSnapshot;
+
+void Counter::Increment(int64_t delta) const
+{
+    if (slot_ >= Metrics::kMaxMetrics) {
+        return;
+    }
+
+    // Only this thread writes to its shard, so a plain store is enough
+    auto &counter = metrics_->shards_.Local().counters[slot_];
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+void Gauge::Set(int64_t value) const
+{
+    if (slot_ < Metrics::kMaxMetrics) {
+        metrics_->gauges_[slot_].store(value, std::memory_order_relaxed);
+    }
+}
+
+void HistogramMetric::Record(uint64_t value) const
+{
+    if (auto histogram = metrics_->LocalHistogram(slot_)) {
+        histogram->Record(value);
+    }
+}
+
+std::string MetricsSnapshot::ToJSON() const
+{
+    auto const appendNumbers = [](std::string &out, auto const &values) {
+        out += '{';
+        for (auto const &[name, value] : values) {
+            if (out.back() != '{') {
+                out += ',';
+            }
+            ReactTestApp::AppendJSONString(out, name);
+            out += ':';
+            out += std::to_string(value);
+        }
+        out += '}';
+    };
+
+    std::string json = "{\"counters\":";
+    appendNumbers(json, counters);
+    json += ",\"gauges\":";
+    appendNumbers(json, gauges);
+    json += ",\"histograms\":{";
+    for (auto const &[name, histogram] : histograms) {
+        if (json.back() != '{') {
+            json += ',';
+        }
+        ReactTestApp::AppendJSONString(json, name);
+        json += ':';
+        histogram.AppendJSON(json);
+    }
+    json += "}}";
+    return json;
+}
+
+Metrics &Metrics::Shared()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+Counter Metrics::GetCounter(std::string_view name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Counter{this, Intern(counterNames_, name)};
+}
+
+Gauge Metrics::GetGauge(std::string_view name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Gauge{this, Intern(gaugeNames_, name)};
+}
+
+HistogramMetric Metrics::GetHistogram(std::string_view name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return HistogramMetric{this, Intern(histogramNames_, name)};
+}
+
+MetricsSnapshot Metrics::Snapshot() const
+{
+    MetricsSnapshot snapshot;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const numCounters = std::min<size_t>(counterNames_.size(), kMaxMetrics);
+    auto const numHistograms = std::min<size_t>(histogramNames_.size(), kMaxMetrics);
+
+    std::vector<int64_t> counters(numCounters, 0);
+    std::vector<HistogramSnapshot> histograms(numHistograms);
+    shards_.ForEach([&](Shard const &shard) {
+        for (size_t i = 0; i < numCounters; ++i) {
+            counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < numHistograms; ++i) {
+            if (auto histogram = shard.histograms[i].load(std::memory_order_acquire)) {
+                histograms[i].Merge(histogram->Snapshot());
+            }
+        }
+    });
+
+    for (size_t i = 0; i < numCounters; ++i) {
+        snapshot.counters.emplace(counterNames_[i], counters[i]);
+    }
+    for (size_t i = 0; i < std::min<size_t>(gaugeNames_.size(), kMaxMetrics); ++i) {
+        snapshot.gauges.emplace(gaugeNames_[i], gauges_[i].load(std::memory_order_relaxed));
+    }
+    for (size_t i = 0; i < numHistograms; ++i) {
+        snapshot.histograms.emplace(histogramNames_[i], histograms[i]);
+    }
+
+    return snapshot;
+}
+
+uint32_t Metrics::Intern(std::vector<std::string> &names, std::string_view name)
+{
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+
+    names.emplace_back(name);
+    return static_cast<uint32_t>(names.size() - 1);
+}
+
+ReactTestApp::Histogram *Metrics::LocalHistogram(uint32_t slot)
+{
+    if (slot >= kMaxMetrics) {
+        return nullptr;
+    }
+
+    auto &shard = shards_.Local();
+    auto histogram = shard.histograms[slot].load(std::memory_order_relaxed);
+    if (histogram == nullptr) {
+        shard.storage.push_back(std::make_unique<Histogram>());
+        histogram = shard.storage.back().get();
+        shard.histograms[slot].store(histogram, std::memory_order_release);
+    }
+    return histogram;
+}
+
+#if __has_include(<jsi/jsi.h>)
+#include <jsi/jsi.h>
+
+using facebook::jsi::Function;
+using facebook::jsi::Object;
+using facebook::jsi::PropNameID;
+using facebook::jsi::Runtime;
+using facebook::jsi::String;
+using facebook::jsi::Value;
+
+namespace
+{
+    std::string NameArgument(Runtime &runtime, Value const *args, size_t count)
+    {
+        if (count == 0 || !args[0].isString()) {
+            throw facebook::jsi::JSError(runtime, "Expected a metric name");
+        }
+        return args[0].getString(runtime).utf8(runtime);
+    }
+
+    double NumberArgument(Value const *args, size_t count, double defaultValue)
+    {
+        return count > 0 && args[0].isNumber() ? args[0].getNumber() : defaultValue;
+    }
+
+    template <typename Factory>
+    void SetMethod(Runtime &runtime, Object &object, char const *name, Factory &&factory)
+    {
+        auto propName = PropNameID::forAscii(runtime, name);
+        object.setProperty(
+            runtime,
+            propName,
+            Function::createFromHostFunction(
+                runtime,
+                propName,
+                1,
+                [factory = std::forward<Factory>(factory)](
+                    Runtime &runtime, Value const &, Value const *args, size_t count) -> Value {
+                    return factory(runtime, args, count);
+                }));
+    }
+}  // namespace
+
+void ReactTestApp::InstallMetrics(Runtime &runtime)
+{
+    auto &metrics = Metrics::Shared();
+    auto binding = Object(runtime);
+
+    SetMethod(
+        runtime, binding, "counter", [&metrics](Runtime &runtime, Value const *args, size_t count) {
+            auto counter = metrics.GetCounter(NameArgument(runtime, args, count));
+            return Function::createFromHostFunction(
+                runtime,
+                PropNameID::forAscii(runtime, "increment"),
+                1,
+                [counter](Runtime &, Value const &, Value const *args, size_t count) {
+                    counter.Increment(static_cast<int64_t>(NumberArgument(args, count, 1)));
+                    return Value::undefined();
+                });
+        });
+
+    SetMethod(
+        runtime, binding, "gauge", [&metrics](Runtime &runtime, Value const *args, size_t count) {
+            auto gauge = metrics.GetGauge(NameArgument(runtime, args, count));
+            return Function::createFromHostFunction(
+                runtime,
+                PropNameID::forAscii(runtime, "set"),
+                1,
+                [gauge](Runtime &, Value const &, Value const *args, size_t count) {
+                    gauge.Set(static_cast<int64_t>(NumberArgument(args, count, 0)));
+                    return Value::undefined();
+                });
+        });
+
+    SetMethod(runtime,
+              binding,
+              "histogram",
+              [&metrics](Runtime &runtime, Value const *args, size_t count) {
+                  auto histogram = metrics.GetHistogram(NameArgument(runtime, args, count));
+                  return Function::createFromHostFunction(
+                      runtime,
+                      PropNameID::forAscii(runtime, "record"),
+                      1,
+                      [histogram](Runtime &, Value const &, Value const *args, size_t count) {
+                          auto value = NumberArgument(args, count, 0);
+                          histogram.Record(value < 0 ? 0 : static_cast<uint64_t>(value));
+                          return Value::undefined();
+                      });
+              });
+
+    SetMethod(runtime, binding, "snapshot", [&metrics](Runtime &runtime, Value const *, size_t) {
+        auto json = runtime.global().getPropertyAsObject(runtime, "JSON");
+        return json.getPropertyAsFunction(runtime, "parse")
+            .callWithThis(runtime,
+                          json,
+                          String::createFromUtf8(runtime, metrics.Snapshot().ToJSON()));
+    });
+
+    runtime.global().setProperty(runtime, "__rntaMetrics", std::move(binding));
+}
+
+#else
+
+void ReactTestApp::InstallMetrics(facebook::jsi::Runtime &)
+{
+}
+
+#endif  // __has_include(<jsi/jsi.h>)
@@ -0,0 +1,150 @@
+#ifndef COMMON_METRICS_
+#define COMMON_METRICS_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Histogram.h"
+#include "ThreadShards.h"
+
+namespace facebook::jsi
+{
+    class Runtime;
+}
+
+namespace ReactTestApp
+{
+    class Metrics;
+
+    /**
+     * Monotonically increasing count, e.g. number of reloads.
+     */
+    class Counter
+    {
+    public:
+        void Increment(int64_t delta = 1) const;
+
+    private:
+        friend class Metrics;
+        Counter(Metrics *metrics, uint32_t slot) : metrics_(metrics), slot_(slot)
+        {
+        }
+
+        Metrics *metrics_;
+        uint32_t slot_;
+    };
+
+    /**
+     * Last observed value, e.g. current memory usage.
+     */
+    class Gauge
+    {
+    public:
+        void Set(int64_t value) const;
+
+    private:
+        friend class Metrics;
+        Gauge(Metrics *metrics, uint32_t slot) : metrics_(metrics), slot_(slot)
+        {
+        }
+
+        Metrics *metrics_;
+        uint32_t slot_;
+    };
+
+    /**
+     * Distribution of values, e.g. latencies in nanoseconds.
+     */
+    class HistogramMetric
+    {
+    public:
+        void Record(uint64_t value) const;
+
+    private:
+        friend class Metrics;
+        HistogramMetric(Metrics *metrics, uint32_t slot) : metrics_(metrics), slot_(slot)
+        {
+        }
+
+        Metrics *metrics_;
+        uint32_t slot_;
+    };
+
+    struct MetricsSnapshot {
+        std::map<std::string, int64_t, std::less<>> counters;
+        std::map<std::string, int64_t, std::less<>> gauges;
+        std::map<std::string, HistogramSnapshot, std::less<>> histograms;
+
+        std::string ToJSON() const;
+    };
+
+    /**
+     * Registry of named metrics. Looking up a metric by name takes a lock,
+     * but the returned handles update per-thread storage without locks or
+     * read-modify-write instructions, and can be used from any thread.
+     */
+    class Metrics
+    {
+    public:
+        /**
+         * Maximum number of metrics of each kind. Handles for metrics beyond
+         * this are valid but discard their updates.
+         */
+        static constexpr uint32_t kMaxMetrics = 256;
+
+        /**
+         * Returns the process-wide registry.
+         */
+        static Metrics &Shared();
+
+        Counter GetCounter(std::string_view name);
+        Gauge GetGauge(std::string_view name);
+        HistogramMetric GetHistogram(std::string_view name);
+
+        MetricsSnapshot Snapshot() const;
+
+    private:
+        friend class Counter;
+        friend class Gauge;
+        friend class HistogramMetric;
+
+        struct Shard {
+            std::array<std::atomic<int64_t>, kMaxMetrics> counters{};
+            std::array<std::atomic<Histogram *>, kMaxMetrics> histograms{};
+            std::vector<std::unique_ptr<Histogram>> storage;
+        };
+
+        mutable std::mutex mutex_;
+        std::vector<std::string> counterNames_;
+        std::vector<std::string> gaugeNames_;
+        std::vector<std::string> histogramNames_;
+        std::array<std::atomic<int64_t>, kMaxMetrics> gauges_{};
+        ThreadShards<Shard> shards_;
+
+        static uint32_t Intern(std::vector<std::string> &names, std::string_view name);
+        Histogram *LocalHistogram(uint32_t slot);
+    };
+
+    /**
+     * Installs `__rntaMetrics` in the global scope of `runtime`:
+     *
+     *   const reloads = __rntaMetrics.counter("reloads");
+     *   reloads(1);
+     *   __rntaMetrics.gauge("items")(42);
+     *   __rntaMetrics.histogram("renderTime")(durationNs);
+     *   const { counters, gauges, histograms } = __rntaMetrics.snapshot();
+     *
+     * The functions returned by `counter()`, `gauge()` and `histogram()` are
+     * bound to their metric and should be kept around on hot paths.
+     */
+    void InstallMetrics(facebook::jsi::Runtime &runtime);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_METRICS_
@@ -0,0 +1,21 @@
+#include "ModuleProviderCache.h"
+
+#include <mutex>
+
+using ReactTestApp::ModuleProviderCache;
+
+std::optional<int> ModuleProviderCache::Lookup(std::string const &name) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto provider = providers_.find(name);
+    if (provider == providers_.end()) {
+        return std::nullopt;
+    }
+    return provider->second;
+}
+
+void ModuleProviderCache::Store(std::string const &name, int provider)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    providers_.insert_or_assign(name, provider);
+}
@@ -0,0 +1,85 @@
+#ifndef COMMON_MODULEPROVIDERCACHE_
+#define COMMON_MODULEPROVIDERCACHE_
+
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+
+namespace ReactTestApp
+{
+    /**
+     * Remembers which module provider, if any, can create a module by name.
+     * This lets us skip providers that are known not to have a module, and
+     * answer existence checks without constructing the module again.
+     */
+    class ModuleProviderCache
+    {
+    public:
+        static constexpr int kNone = -1;
+
+        /**
+         * Returns the index of the provider that created the named module, or
+         * `kNone` if no provider could. Returns nothing if the name has not
+         * been resolved yet.
+         */
+        std::optional<int> Lookup(std::string const &name) const;
+
+        void Store(std::string const &name, int provider);
+
+        /**
+         * Returns whether the named module can be created, if known. Names are
+         * only known once they have gone through `Resolve`, which constructs
+         * the module; there is no way to ask generated providers otherwise.
+         */
+        std::optional<bool> Contains(std::string const &name) const
+        {
+            auto provider = Lookup(name);
+            if (!provider.has_value()) {
+                return std::nullopt;
+            }
+            return *provider != kNone;
+        }
+
+        /**
+         * Creates the named module by trying each provider in order, then
+         * remembers the outcome so that subsequent calls only invoke the
+         * provider that succeeded, or none at all.
+         */
+        template <typename... Providers>
+        auto Resolve(std::string const &name, Providers const &...providers)
+        {
+            using Module = std::invoke_result_t<std::tuple_element_t<0, std::tuple<Providers...>>>;
+
+            auto const invoke = [&providers...](int index) {
+                Module module = nullptr;
+                int i = 0;
+                ((i++ == index ? static_cast<void>(module = providers()) : static_cast<void>(0)),
+                 ...);
+                return module;
+            };
+
+            if (auto cached = Lookup(name); cached.has_value()) {
+                return *cached == kNone ? Module{nullptr} : invoke(*cached);
+            }
+
+            for (int i = 0; i < static_cast<int>(sizeof...(Providers)); ++i) {
+                if (auto module = invoke(i)) {
+                    Store(name, i);
+                    return module;
+                }
+            }
+
+            Store(name, kNone);
+            return Module{nullptr};
+        }
+
+    private:
+        mutable std::shared_mutex mutex_;
+        std::unordered_map<std::string, int> providers_;
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_MODULEPROVIDERCACHE_
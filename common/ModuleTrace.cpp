@@ -0,0 +1,483 @@
+#include "ModuleTrace.h"
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+using ReactTestApp::ModuleTraceReplayer;
+using ReactTestApp::ModuleTraceWriter;
+using ReactTestApp::RecordedCall;
+
+namespace
+{
+    constexpr char kMagic[] = {'R', 'N', 'T', 'A'};
+    constexpr uint8_t kVersion = 1;
+
+    enum RecordType : uint8_t {
+        kCall = 1,
+        kResolve = 2,
+    };
+
+    // Guards against cyclic or pathologically deep objects when encoding, and
+    // against deeply nested input overflowing the stack when decoding
+    constexpr int kMaxDepth = 32;
+}  // namespace
+
+void ReactTestApp::ModuleTrace::AppendVarint(std::string &out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+void ReactTestApp::ModuleTrace::AppendString(std::string &out, std::string_view value)
+{
+    AppendVarint(out, value.size());
+    out += value;
+}
+
+void ReactTestApp::ModuleTrace::AppendNumber(std::string &out, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        out += static_cast<char>((bits >> (i * 8)) & 0xFF);
+    }
+}
+
+std::optional<uint64_t> ReactTestApp::ModuleTrace::ReadVarint(std::string_view &in)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64 && !in.empty(); shift += 7) {
+        auto byte = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string_view> ReactTestApp::ModuleTrace::ReadString(std::string_view &in)
+{
+    auto length = ReadVarint(in);
+    if (!length.has_value() || *length > in.size()) {
+        return std::nullopt;
+    }
+
+    auto value = in.substr(0, *length);
+    in.remove_prefix(*length);
+    return value;
+}
+
+std::optional<double> ReactTestApp::ModuleTrace::ReadNumber(std::string_view &in)
+{
+    if (in.size() < 8) {
+        return std::nullopt;
+    }
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) {
+        bits |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (i * 8);
+    }
+    in.remove_prefix(8);
+
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+namespace
+{
+    std::optional<std::string_view> SkipValue(std::string_view &in, int depth)
+    {
+        using namespace ReactTestApp::ModuleTrace;
+
+        auto const start = in;
+        if (in.empty() || depth > kMaxDepth) {
+            return std::nullopt;
+        }
+
+        auto tag = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+
+        switch (tag) {
+            case kUndefined:
+            case kNull:
+            case kFalse:
+            case kTrue:
+            case kPromise:
+            case kUnsupported:
+                break;
+            case kNumber:
+                if (!ReadNumber(in).has_value()) {
+                    return std::nullopt;
+                }
+                break;
+            case kString:
+                if (!ReadString(in).has_value()) {
+                    return std::nullopt;
+                }
+                break;
+            case kArray: {
+                auto length = ReadVarint(in);
+                if (!length.has_value()) {
+                    return std::nullopt;
+                }
+                for (uint64_t i = 0; i < *length; ++i) {
+                    if (!SkipValue(in, depth + 1).has_value()) {
+                        return std::nullopt;
+                    }
+                }
+                break;
+            }
+            case kObject: {
+                auto length = ReadVarint(in);
+                if (!length.has_value()) {
+                    return std::nullopt;
+                }
+                for (uint64_t i = 0; i < *length; ++i) {
+                    if (!ReadString(in).has_value() || !SkipValue(in, depth + 1).has_value()) {
+                        return std::nullopt;
+                    }
+                }
+                break;
+            }
+            default:
+                return std::nullopt;
+        }
+
+        return start.substr(0, start.size() - in.size());
+    }
+}  // namespace
+
+std::optional<std::string_view> ReactTestApp::ModuleTrace::SkipValue(std::string_view &in)
+{
+    return ::SkipValue(in, 0);
+}
+
+#if __has_include(<jsi/jsi.h>)
+#include <jsi/jsi.h>
+
+using facebook::jsi::Array;
+using facebook::jsi::Function;
+using facebook::jsi::Object;
+using facebook::jsi::Runtime;
+using facebook::jsi::String;
+using facebook::jsi::Value;
+
+namespace
+{
+    void EncodeValue(Runtime &runtime, Value const &value, std::string &out, int depth)
+    {
+        using namespace ReactTestApp::ModuleTrace;
+
+        if (value.isUndefined()) {
+            out += static_cast<char>(kUndefined);
+        } else if (value.isNull()) {
+            out += static_cast<char>(kNull);
+        } else if (value.isBool()) {
+            out += static_cast<char>(value.getBool() ? kTrue : kFalse);
+        } else if (value.isNumber()) {
+            out += static_cast<char>(kNumber);
+            AppendNumber(out, value.getNumber());
+        } else if (value.isString()) {
+            out += static_cast<char>(kString);
+            AppendString(out, value.getString(runtime).utf8(runtime));
+        } else if (value.isObject() && depth < kMaxDepth) {
+            auto object = value.getObject(runtime);
+            if (object.isFunction(runtime) || object.isHostObject(runtime)) {
+                out += static_cast<char>(kUnsupported);
+            } else if (object.isArray(runtime)) {
+                auto array = object.getArray(runtime);
+                auto length = array.size(runtime);
+                out += static_cast<char>(kArray);
+                AppendVarint(out, length);
+                for (size_t i = 0; i < length; ++i) {
+                    EncodeValue(runtime, array.getValueAtIndex(runtime, i), out, depth + 1);
+                }
+            } else if (auto then = object.getProperty(runtime, "then");
+                       then.isObject() && then.getObject(runtime).isFunction(runtime)) {
+                out += static_cast<char>(kPromise);
+            } else {
+                auto names = object.getPropertyNames(runtime);
+                auto length = names.size(runtime);
+                out += static_cast<char>(kObject);
+                AppendVarint(out, length);
+                for (size_t i = 0; i < length; ++i) {
+                    auto name = names.getValueAtIndex(runtime, i).getString(runtime);
+                    AppendString(out, name.utf8(runtime));
+                    EncodeValue(runtime, object.getProperty(runtime, name), out, depth + 1);
+                }
+            }
+        } else {
+            out += static_cast<char>(kUnsupported);
+        }
+    }
+
+    [[noreturn]] void ThrowMalformed()
+    {
+        throw std::runtime_error("Malformed module trace value");
+    }
+
+    Value DecodeValue(Runtime &runtime, std::string_view &in, int depth)
+    {
+        using namespace ReactTestApp::ModuleTrace;
+
+        if (in.empty() || depth > kMaxDepth) {
+            ThrowMalformed();
+        }
+
+        auto tag = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+
+        switch (tag) {
+            case kUndefined:
+            case kPromise:
+            case kUnsupported:
+                return Value::undefined();
+            case kNull:
+                return Value::null();
+            case kFalse:
+                return Value{false};
+            case kTrue:
+                return Value{true};
+            case kNumber: {
+                auto number = ReadNumber(in);
+                if (!number.has_value()) {
+                    ThrowMalformed();
+                }
+                return Value{*number};
+            }
+            case kString: {
+                auto str = ReadString(in);
+                if (!str.has_value()) {
+                    ThrowMalformed();
+                }
+                return String::createFromUtf8(
+                    runtime, reinterpret_cast<uint8_t const *>(str->data()), str->size());
+            }
+            case kArray: {
+                auto length = ReadVarint(in);
+                if (!length.has_value() || *length > in.size()) {
+                    ThrowMalformed();
+                }
+                auto array = Array(runtime, static_cast<size_t>(*length));
+                for (size_t i = 0; i < *length; ++i) {
+                    array.setValueAtIndex(runtime, i, DecodeValue(runtime, in, depth + 1));
+                }
+                return array;
+            }
+            case kObject: {
+                auto length = ReadVarint(in);
+                if (!length.has_value() || *length > in.size()) {
+                    ThrowMalformed();
+                }
+                auto object = Object(runtime);
+                for (size_t i = 0; i < *length; ++i) {
+                    auto name = ReadString(in);
+                    if (!name.has_value()) {
+                        ThrowMalformed();
+                    }
+                    object.setProperty(runtime,
+                                       String::createFromUtf8(
+                                           runtime,
+                                           reinterpret_cast<uint8_t const *>(name->data()),
+                                           name->size()),
+                                       DecodeValue(runtime, in, depth + 1));
+                }
+                return object;
+            }
+            default:
+                ThrowMalformed();
+        }
+    }
+}  // namespace
+
+void ReactTestApp::ModuleTrace::EncodeValue(Runtime &runtime, Value const &value, std::string &out)
+{
+    ::EncodeValue(runtime, value, out, 0);
+}
+
+void ReactTestApp::ModuleTrace::EncodeValues(Runtime &runtime,
+                                             Value const *values,
+                                             size_t count,
+                                             std::string &out)
+{
+    out += static_cast<char>(kArray);
+    AppendVarint(out, count);
+    for (size_t i = 0; i < count; ++i) {
+        ::EncodeValue(runtime, values[i], out, 1);
+    }
+}
+
+Value ReactTestApp::ModuleTrace::DecodeValue(Runtime &runtime, std::string_view &in)
+{
+    return ::DecodeValue(runtime, in, 0);
+}
+
+#endif  // __has_include(<jsi/jsi.h>)
+
+ModuleTraceWriter::ModuleTraceWriter(std::string const &path)
+    : stream_(path, std::ios::binary | std::ios::trunc)
+{
+    stream_.write(kMagic, sizeof(kMagic));
+    stream_.put(static_cast<char>(kVersion));
+    stream_.flush();
+}
+
+uint64_t ModuleTraceWriter::RecordCall(std::string_view module,
+                                       std::string_view method,
+                                       std::string_view encodedArgs,
+                                       std::string_view encodedResult,
+                                       std::chrono::nanoseconds duration)
+{
+    using namespace ModuleTrace;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto seq = seq_++;
+    buffer_.clear();
+    buffer_ += static_cast<char>(kCall);
+    AppendVarint(buffer_, seq);
+    AppendString(buffer_, module);
+    AppendString(buffer_, method);
+    buffer_ += encodedArgs;
+    buffer_ += encodedResult;
+    AppendVarint(buffer_, static_cast<uint64_t>(duration.count()));
+    stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    stream_.flush();
+    return seq;
+}
+
+void ModuleTraceWriter::RecordResolve(uint64_t seq,
+                                      std::string_view encodedResult,
+                                      std::chrono::nanoseconds duration)
+{
+    using namespace ModuleTrace;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer_.clear();
+    buffer_ += static_cast<char>(kResolve);
+    AppendVarint(buffer_, seq);
+    buffer_ += encodedResult;
+    AppendVarint(buffer_, static_cast<uint64_t>(duration.count()));
+    stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    stream_.flush();
+}
+
+void ModuleTraceWriter::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream_.flush();
+}
+
+bool ModuleTraceReplayer::Load(std::string const &path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+
+    std::string trace{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+    return Parse(trace);
+}
+
+bool ModuleTraceReplayer::Parse(std::string_view trace)
+{
+    using namespace ModuleTrace;
+
+    if (trace.size() < sizeof(kMagic) + 1 ||
+        trace.substr(0, sizeof(kMagic)) != std::string_view{kMagic, sizeof(kMagic)} ||
+        static_cast<uint8_t>(trace[sizeof(kMagic)]) != kVersion) {
+        return false;
+    }
+    trace.remove_prefix(sizeof(kMagic) + 1);
+
+    // Parse into a container of our own so that a malformed trace leaves the
+    // loaded calls untouched. Records are written and flushed one at a time,
+    // so a record that cannot be read can only be the last one, cut short
+    // when the recording process was killed; the trace ends there.
+    decltype(calls_) calls;
+    std::map<uint64_t, RecordedCall *> pending;
+    while (!trace.empty()) {
+        auto type = static_cast<uint8_t>(trace.front());
+        trace.remove_prefix(1);
+        if (type != kCall && type != kResolve) {
+            return false;
+        }
+
+        auto seq = ReadVarint(trace);
+        if (!seq.has_value()) {
+            break;
+        }
+
+        if (type == kCall) {
+            auto module = ReadString(trace);
+            auto method = ReadString(trace);
+            auto args = module && method ? SkipValue(trace) : std::nullopt;
+            auto result = args ? SkipValue(trace) : std::nullopt;
+            auto duration = result ? ReadVarint(trace) : std::nullopt;
+            if (!duration.has_value()) {
+                break;
+            }
+
+            auto &queue = calls[Key(*module, *method, *args)];
+            queue.push_back({std::string{*result},
+                             std::nullopt,
+                             std::chrono::nanoseconds{static_cast<int64_t>(*duration)}});
+            if (static_cast<uint8_t>(result->front()) == kPromise) {
+                pending[*seq] = &queue.back();
+            }
+        } else {
+            auto result = SkipValue(trace);
+            auto duration = result ? ReadVarint(trace) : std::nullopt;
+            if (!duration.has_value()) {
+                break;
+            }
+
+            if (auto call = pending.find(*seq); call != pending.end()) {
+                call->second->resolution = std::string{*result};
+                call->second->duration =
+                    std::chrono::nanoseconds{static_cast<int64_t>(*duration)};
+                pending.erase(call);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    calls_.swap(calls);
+    return true;
+}
+
+std::optional<RecordedCall> ModuleTraceReplayer::Next(std::string_view module,
+                                                      std::string_view method,
+                                                      std::string_view encodedArgs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto calls = calls_.find(Key(module, method, encodedArgs));
+    if (calls == calls_.end() || calls->second.empty()) {
+        ++misses_;
+        return std::nullopt;
+    }
+
+    auto call = std::move(calls->second.front());
+    calls->second.pop_front();
+    return call;
+}
+
+std::string ModuleTraceReplayer::Key(std::string_view module,
+                                     std::string_view method,
+                                     std::string_view encodedArgs)
+{
+    std::string key;
+    key.reserve(module.size() + method.size() + encodedArgs.size() + 2);
+    key += module;
+    key += '\0';
+    key += method;
+    key += '\0';
+    key += encodedArgs;
+    return key;
+}
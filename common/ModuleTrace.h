@@ -0,0 +1,165 @@
+#ifndef COMMON_MODULETRACE_
+#define COMMON_MODULETRACE_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace facebook::jsi
+{
+    class Runtime;
+    class Value;
+}  // namespace facebook::jsi
+
+namespace ReactTestApp
+{
+    /**
+     * Compact binary trace of native module traffic. A trace starts with a
+     * header (`RNTA` followed by a version byte) and is followed by records:
+     *
+     *   call:    0x01 seq module method args result duration
+     *   resolve: 0x02 seq result duration
+     *
+     * where `seq`, `duration` (in nanoseconds) and lengths are LEB128 varints,
+     * strings are length-prefixed, and `args` and `result` are encoded values
+     * (see `EncodeValue`). Asynchronous calls record a `kPromise` result, and
+     * a `resolve` record once the promise settles.
+     */
+    namespace ModuleTrace
+    {
+        enum Tag : uint8_t {
+            kUndefined,
+            kNull,
+            kFalse,
+            kTrue,
+            kNumber,
+            kString,
+            kArray,
+            kObject,
+            kPromise,
+            kUnsupported,
+        };
+
+        void AppendVarint(std::string &out, uint64_t value);
+        void AppendString(std::string &out, std::string_view value);
+        void AppendNumber(std::string &out, double value);
+
+        std::optional<uint64_t> ReadVarint(std::string_view &in);
+        std::optional<std::string_view> ReadString(std::string_view &in);
+        std::optional<double> ReadNumber(std::string_view &in);
+
+        /**
+         * Advances `in` past one encoded value. Returns the bytes of the
+         * skipped value, or nothing if the input is truncated, malformed, or
+         * nested deeper than the encoder would write.
+         */
+        std::optional<std::string_view> SkipValue(std::string_view &in);
+
+#if __has_include(<jsi/jsi.h>)
+        /**
+         * Appends `value` to `out`. Functions and host objects are encoded as
+         * `kUnsupported`; promise-like objects as `kPromise`.
+         */
+        void EncodeValue(facebook::jsi::Runtime &, facebook::jsi::Value const &, std::string &out);
+        void EncodeValues(facebook::jsi::Runtime &,
+                          facebook::jsi::Value const *values,
+                          size_t count,
+                          std::string &out);
+
+        /**
+         * Decodes a value previously written by `EncodeValue`. Throws
+         * `std::runtime_error` on malformed input, including input nested
+         * deeper than the encoder would write.
+         */
+        facebook::jsi::Value DecodeValue(facebook::jsi::Runtime &, std::string_view &in);
+#endif  // __has_include(<jsi/jsi.h>)
+    }  // namespace ModuleTrace
+
+    /**
+     * Appends module calls to a trace file. Each record is flushed as soon as
+     * it has been written, since the process may be killed without running
+     * destructors. Thread-safe.
+     */
+    class ModuleTraceWriter
+    {
+    public:
+        explicit ModuleTraceWriter(std::string const &path);
+
+        bool IsOpen() const
+        {
+            return stream_.is_open();
+        }
+
+        /**
+         * Records a call and returns its sequence number.
+         */
+        uint64_t RecordCall(std::string_view module,
+                            std::string_view method,
+                            std::string_view encodedArgs,
+                            std::string_view encodedResult,
+                            std::chrono::nanoseconds duration);
+
+        void RecordResolve(uint64_t seq,
+                           std::string_view encodedResult,
+                           std::chrono::nanoseconds duration);
+
+        void Flush();
+
+    private:
+        std::mutex mutex_;
+        std::ofstream stream_;
+        std::string buffer_;
+        uint64_t seq_ = 0;
+    };
+
+    struct RecordedCall {
+        std::string result;
+        std::optional<std::string> resolution;
+        std::chrono::nanoseconds duration;
+    };
+
+    /**
+     * Serves recorded results back in the order they were recorded. Calls are
+     * matched on module, method and encoded arguments. Thread-safe.
+     */
+    class ModuleTraceReplayer
+    {
+    public:
+        /**
+         * Loads a trace file, replacing any calls loaded before. Returns
+         * `false` if the file could not be read or is malformed, in which case
+         * the previously loaded calls are kept. A trace that ends in a partial
+         * record, e.g. because the recording process was killed, is loaded up
+         * to the last complete record.
+         */
+        bool Load(std::string const &path);
+        bool Parse(std::string_view trace);
+
+        std::optional<RecordedCall> Next(std::string_view module,
+                                         std::string_view method,
+                                         std::string_view encodedArgs);
+
+        size_t Misses() const
+        {
+            return misses_;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::map<std::string, std::deque<RecordedCall>, std::less<>> calls_;
+        std::atomic<size_t> misses_{0};
+
+        static std::string Key(std::string_view module,
+                               std::string_view method,
+                               std::string_view encodedArgs);
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_MODULETRACE_
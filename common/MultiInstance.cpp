@@ -0,0 +1,248 @@
+#include "MultiInstance.h"
+
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "AppRegistry.h"
+#include "JSON.h"
+#include "MemoryMonitor.h"
+#include "Metrics.h"
+
+#if __has_include(<jsi/jsi.h>)
+#include <jsi/jsi.h>
+#endif  // __has_include(<jsi/jsi.h>)
+
+using ReactTestApp::InstanceLoad;
+using ReactTestApp::Metrics;
+using ReactTestApp::MultiInstanceOptions;
+using ReactTestApp::MultiInstanceResult;
+using ReactTestApp::MultiInstanceTracker;
+
+namespace
+{
+    std::optional<long long> ParseNumber(std::string const &value)
+    {
+        if (value.empty()) {
+            return std::nullopt;
+        }
+
+        char *end = nullptr;
+        auto number = std::strtoll(value.c_str(), &end, 10);
+        if (*end != '\0' || number < 0) {
+            return std::nullopt;
+        }
+        return number;
+    }
+
+    std::optional<uint64_t> SampleResidentBytes()
+    {
+        if (auto memory = ReactTestApp::SampleProcessMemory()) {
+            return memory->residentBytes;
+        }
+        return std::nullopt;
+    }
+
+    void AppendOptional(std::string &out, std::optional<uint64_t> const &value)
+    {
+        out += value ? std::to_string(*value) : "null";
+    }
+}  // namespace
+
+std::optional<MultiInstanceOptions> MultiInstanceOptions::FromEnvironment()
+{
+    auto instances = std::getenv("REACT_TEST_APP_INSTANCES");
+    auto count = ParseNumber(instances == nullptr ? "" : instances);
+    if (!count || *count < 2) {
+        return std::nullopt;
+    }
+
+    MultiInstanceOptions options;
+    options.instances = static_cast<size_t>(*count);
+
+    if (auto ports = std::getenv("REACT_TEST_APP_INSTANCE_PORTS")) {
+        std::string_view list{ports};
+        while (!list.empty()) {
+            auto comma = list.find(',');
+            auto port = ParseNumber(std::string{list.substr(0, comma)});
+            options.bundlerPorts.push_back(port && *port <= 65535 ? static_cast<int>(*port) : 0);
+            list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+        }
+    }
+
+    return options;
+}
+
+std::optional<uint64_t> MultiInstanceResult::ResidentBytesPerInstance() const
+{
+    size_t loaded = 0;
+    for (auto &&instance : instances) {
+        if (instance.error.empty()) {
+            ++loaded;
+        }
+    }
+
+    if (loaded == 0 || !baselineResidentBytes || !finalResidentBytes) {
+        return std::nullopt;
+    }
+
+    auto growth = *finalResidentBytes > *baselineResidentBytes
+                      ? *finalResidentBytes - *baselineResidentBytes
+                      : 0;
+    return growth / loaded;
+}
+
+std::string MultiInstanceResult::ToJSON() const
+{
+    std::string json = "{\"durationMicroseconds\":";
+    json += std::to_string(duration.count());
+    json += ",\"baselineResidentBytes\":";
+    AppendOptional(json, baselineResidentBytes);
+    json += ",\"finalResidentBytes\":";
+    AppendOptional(json, finalResidentBytes);
+    json += ",\"residentBytesPerInstance\":";
+    AppendOptional(json, ResidentBytesPerInstance());
+    json += ",\"instances\":[";
+    auto separator = "";
+    for (auto &&instance : instances) {
+        json += separator;
+        json += "{\"appKeys\":[";
+        auto keySeparator = "";
+        for (auto &&appKey : instance.appKeys) {
+            json += keySeparator;
+            AppendJSONString(json, appKey);
+            keySeparator = ",";
+        }
+        json += "],\"durationMicroseconds\":";
+        json += std::to_string(instance.duration.count());
+        json += ",\"error\":";
+        if (instance.error.empty()) {
+            json += "null";
+        } else {
+            AppendJSONString(json, instance.error);
+        }
+        json += '}';
+        separator = ",";
+    }
+    json += "]}";
+    return json;
+}
+
+MultiInstanceTracker::MultiInstanceTracker(size_t instances, Completion completion)
+    : start_(std::chrono::steady_clock::now()), reported_(instances, false),
+      remaining_(instances), completion_(std::move(completion))
+{
+    result_.instances.resize(instances);
+    result_.baselineResidentBytes = SampleResidentBytes();
+}
+
+void MultiInstanceTracker::OnLoaded(size_t instance, std::vector<std::string> appKeys)
+{
+    Report(instance, {std::move(appKeys), {}, {}});
+}
+
+void MultiInstanceTracker::OnFailed(size_t instance, std::string error)
+{
+    Report(instance, {{}, {}, error.empty() ? "Unknown error" : std::move(error)});
+}
+
+void MultiInstanceTracker::Report(size_t instance, InstanceLoad load)
+{
+    static auto const loadTimes = Metrics::Shared().GetHistogram("instanceLoadMicroseconds");
+
+    MultiInstanceResult result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (instance >= reported_.size() || reported_[instance]) {
+            return;
+        }
+
+        auto const now = std::chrono::steady_clock::now();
+        load.duration = std::chrono::duration_cast<std::chrono::microseconds>(now - start_);
+        if (load.error.empty()) {
+            loadTimes.Record(static_cast<uint64_t>(load.duration.count()));
+        }
+
+        reported_[instance] = true;
+        result_.instances[instance] = std::move(load);
+        if (--remaining_ > 0) {
+            return;
+        }
+
+        result_.duration = std::chrono::duration_cast<std::chrono::microseconds>(now - start_);
+        result_.finalResidentBytes = SampleResidentBytes();
+        result = result_;
+    }
+
+    if (auto perInstance = result.ResidentBytesPerInstance()) {
+        Metrics::Shared()
+            .GetGauge("residentBytesPerInstance")
+            .Set(static_cast<int64_t>(*perInstance));
+    }
+
+    if (completion_) {
+        completion_(result);
+    }
+}
+
+MultiInstanceResult ReactTestApp::RunHeadlessInstances(
+    size_t instances,
+    [[maybe_unused]] RuntimeFactory const &createRuntime,
+    [[maybe_unused]] std::shared_ptr<facebook::jsi::Buffer const> bundle,
+    [[maybe_unused]] std::string const &sourceURL)
+{
+    std::mutex mutex;
+    std::condition_variable completed;
+    std::optional<MultiInstanceResult> result;
+    MultiInstanceTracker tracker(instances, [&](MultiInstanceResult const &r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        result = r;
+        completed.notify_all();
+    });
+    if (instances == 0) {
+        return {};
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(instances);
+    for (size_t i = 0; i < instances; ++i) {
+        threads.emplace_back([&, i]() {
+#if __has_include(<jsi/jsi.h>)
+            std::unique_ptr<facebook::jsi::Runtime> runtime;
+            try {
+                runtime = createRuntime(i);
+                runtime->evaluateJavaScript(bundle, sourceURL);
+
+                auto appKeys = GetAppKeys(*runtime);
+                if (appKeys.empty()) {
+                    tracker.OnFailed(i, "No components were registered");
+                } else {
+                    // Root tags of React Native apps end in 1
+                    RunApplication(*runtime, appKeys.front(), static_cast<int>(i * 10 + 1));
+                    tracker.OnLoaded(i, std::move(appKeys));
+                }
+            } catch (std::exception const &e) {
+                tracker.OnFailed(i, e.what());
+            } catch (...) {
+                tracker.OnFailed(i, {});
+            }
+
+            // Keep the runtime alive until every instance has been measured
+            std::unique_lock<std::mutex> lock(mutex);
+            completed.wait(lock, [&result]() { return result.has_value(); });
+            lock.unlock();
+            runtime.reset();
+#else
+            tracker.OnFailed(i, "JSI is not available");
+#endif  // __has_include(<jsi/jsi.h>)
+        });
+    }
+
+    for (auto &&thread : threads) {
+        thread.join();
+    }
+    return std::move(*result);
+}
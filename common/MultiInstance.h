@@ -0,0 +1,118 @@
+#ifndef COMMON_MULTIINSTANCE_
+#define COMMON_MULTIINSTANCE_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace facebook::jsi
+{
+    class Buffer;
+    class Runtime;
+}  // namespace facebook::jsi
+
+namespace ReactTestApp
+{
+    struct MultiInstanceOptions {
+        /** Number of instances, including the one presenting components. */
+        size_t instances = 2;
+        /**
+         * Dev server port of each additional instance, in order. Instances
+         * without one use the address stored in their own settings.
+         */
+        std::vector<int> bundlerPorts;
+
+        /**
+         * Reads `REACT_TEST_APP_INSTANCES` and, optionally, a comma separated
+         * list of ports from `REACT_TEST_APP_INSTANCE_PORTS`. Returns nothing
+         * unless at least two instances are requested.
+         */
+        static std::optional<MultiInstanceOptions> FromEnvironment();
+    };
+
+    struct InstanceLoad {
+        std::vector<std::string> appKeys;
+        /** Time from the start of the run until the instance had loaded. */
+        std::chrono::microseconds duration{0};
+        /** Why the instance failed to load, or empty on success. */
+        std::string error;
+    };
+
+    struct MultiInstanceResult {
+        std::vector<InstanceLoad> instances;
+        /** Time until every instance had loaded or failed. */
+        std::chrono::microseconds duration{0};
+        std::optional<uint64_t> baselineResidentBytes;
+        std::optional<uint64_t> finalResidentBytes;
+
+        /**
+         * Returns the growth of the resident set size divided by the number
+         * of instances that loaded.
+         */
+        std::optional<uint64_t> ResidentBytesPerInstance() const;
+
+        std::string ToJSON() const;
+    };
+
+    /**
+     * Collects load times and memory while several instances start up
+     * concurrently. The resident set size is sampled on construction and
+     * again once every instance has reported back, after which the result is
+     * recorded to the shared metrics registry and passed to `completion`.
+     * Instances may report from any thread; `completion` is called on the
+     * thread of the last one.
+     */
+    class MultiInstanceTracker
+    {
+    public:
+        using Completion = std::function<void(MultiInstanceResult const &)>;
+
+        MultiInstanceTracker(size_t instances, Completion completion);
+
+        MultiInstanceTracker(MultiInstanceTracker const &) = delete;
+        MultiInstanceTracker &operator=(MultiInstanceTracker const &) = delete;
+
+        /**
+         * Reports that `instance` has loaded. Only the first report of each
+         * instance counts; later ones, e.g. after a reload, are ignored.
+         */
+        void OnLoaded(size_t instance, std::vector<std::string> appKeys);
+        void OnFailed(size_t instance, std::string error);
+
+    private:
+        void Report(size_t instance, InstanceLoad load);
+
+        std::mutex mutex_;
+        std::chrono::steady_clock::time_point start_;
+        MultiInstanceResult result_;
+        std::vector<bool> reported_;
+        size_t remaining_;
+        Completion completion_;
+    };
+
+    /**
+     * Creates the runtime of headless instance `instance`, with whatever host
+     * objects the bundle needs already installed.
+     */
+    using RuntimeFactory =
+        std::function<std::unique_ptr<facebook::jsi::Runtime>(size_t instance)>;
+
+    /**
+     * Runs `instances` runtimes concurrently, each on its own thread, without
+     * any UI. Every runtime evaluates `bundle`, then the first registered app
+     * key is run with `AppRegistry.runApplication`. Runtimes are kept alive
+     * until all of them have loaded so that the final memory sample includes
+     * every one of them.
+     */
+    MultiInstanceResult RunHeadlessInstances(size_t instances,
+                                             RuntimeFactory const &createRuntime,
+                                             std::shared_ptr<facebook::jsi::Buffer const> bundle,
+                                             std::string const &sourceURL);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_MULTIINSTANCE_
@@ -0,0 +1,52 @@
+#include "OutputFile.h"
+
+#include <ctime>
+
+namespace
+{
+    bool IsSafeFileNameCharacter(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+               c == '-' || c == '_' || c == '.';
+    }
+}  // namespace
+
+std::string ReactTestApp::MakeOutputFileName(std::string_view label,
+                                             std::chrono::system_clock::time_point time,
+                                             std::string_view extension)
+{
+    std::string fileName;
+    fileName.reserve(label.size() + extension.size() + 20);
+    for (char c : label) {
+        fileName += IsSafeFileNameCharacter(c) ? c : '_';
+    }
+    if (fileName.empty() || fileName.front() == '.') {
+        fileName.insert(0, "output");
+    }
+
+    auto const timeT = std::chrono::system_clock::to_time_t(time);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &timeT);
+#else
+    gmtime_r(&timeT, &utc);
+#endif  // _WIN32
+
+    char timestamp[20] = {};
+    std::strftime(timestamp, sizeof(timestamp), "%Y%m%dT%H%M%SZ", &utc);
+
+    fileName += '-';
+    fileName += timestamp;
+    fileName += extension;
+    return fileName;
+}
+
+std::string ReactTestApp::JoinOutputPath(std::string_view directory, std::string_view fileName)
+{
+    std::string path{directory};
+    if (!path.empty() && path.back() != '/' && path.back() != '\\') {
+        path += '/';
+    }
+    path += fileName;
+    return path;
+}
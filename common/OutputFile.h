@@ -0,0 +1,26 @@
+#ifndef COMMON_OUTPUTFILE_
+#define COMMON_OUTPUTFILE_
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace ReactTestApp
+{
+    /**
+     * Returns a file name for diagnostics output, e.g.
+     * `my-component-20241018T093000Z.cpuprofile`. Characters that are not
+     * safe in file names are replaced with `_`.
+     */
+    std::string MakeOutputFileName(std::string_view label,
+                                   std::chrono::system_clock::time_point time,
+                                   std::string_view extension);
+
+    /**
+     * Returns `fileName` in `directory`, or just `fileName` if `directory` is
+     * empty.
+     */
+    std::string JoinOutputPath(std::string_view directory, std::string_view fileName);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_OUTPUTFILE_
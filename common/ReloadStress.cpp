@@ -0,0 +1,174 @@
+#include "ReloadStress.h"
+
+#include <cstdlib>
+#include <set>
+
+#include "JSON.h"
+#include "LiveObjects.h"
+#include "MemoryMonitor.h"
+
+using ReactTestApp::ReloadStressDriver;
+using ReactTestApp::ReloadStressOptions;
+using ReactTestApp::ReloadStressResult;
+using ReactTestApp::ReloadStressSample;
+
+namespace
+{
+    std::optional<long long> GetEnvironmentNumber(char const *name)
+    {
+        auto value = std::getenv(name);
+        if (value == nullptr || *value == '\0') {
+            return std::nullopt;
+        }
+
+        char *end = nullptr;
+        auto number = std::strtoll(value, &end, 10);
+        if (*end != '\0' || number < 0) {
+            return std::nullopt;
+        }
+        return number;
+    }
+
+    void AppendSample(std::string &out, ReloadStressSample const &sample)
+    {
+        out += "{\"liveObjects\":{";
+        auto separator = "";
+        for (auto const &[kind, count] : sample.liveObjects) {
+            out += separator;
+            ReactTestApp::AppendJSONString(out, kind);
+            out += ':';
+            out += std::to_string(count);
+            separator = ",";
+        }
+        out += "},\"residentBytes\":";
+        out += sample.residentBytes ? std::to_string(*sample.residentBytes) : "null";
+        out += '}';
+    }
+}  // namespace
+
+std::optional<ReloadStressOptions> ReloadStressOptions::FromEnvironment()
+{
+    auto iterations = GetEnvironmentNumber("REACT_TEST_APP_RELOAD_STRESS");
+    if (!iterations || *iterations == 0) {
+        return std::nullopt;
+    }
+
+    ReloadStressOptions options;
+    options.iterations = static_cast<int>(*iterations);
+    if (auto objects = GetEnvironmentNumber("REACT_TEST_APP_RELOAD_STRESS_OBJECTS")) {
+        options.objectTolerance = *objects;
+    }
+    if (auto memory = GetEnvironmentNumber("REACT_TEST_APP_RELOAD_STRESS_MEMORY")) {
+        options.memoryTolerance = static_cast<double>(*memory) / 100.0;
+    }
+    return options;
+}
+
+ReloadStressSample ReloadStressSample::Take()
+{
+    ReloadStressSample sample;
+    sample.liveObjects = GetLiveObjectCounts();
+    if (auto memory = SampleProcessMemory()) {
+        sample.residentBytes = memory->residentBytes;
+    }
+    return sample;
+}
+
+std::string ReloadStressResult::ToJSON() const
+{
+    std::string json = "{\"passed\":";
+    json += Passed() ? "true" : "false";
+    json += ",\"iterations\":";
+    json += std::to_string(iterations);
+    json += ",\"baseline\":";
+    AppendSample(json, baseline);
+    json += ",\"final\":";
+    AppendSample(json, final);
+    json += ",\"failures\":[";
+    auto separator = "";
+    for (auto const &failure : failures) {
+        json += separator;
+        AppendJSONString(json, failure);
+        separator = ",";
+    }
+    json += "]}";
+    return json;
+}
+
+ReloadStressResult ReactTestApp::EvaluateReloadStress(ReloadStressOptions const &options,
+                                                      ReloadStressSample baseline,
+                                                      ReloadStressSample final)
+{
+    ReloadStressResult result{options.iterations, std::move(baseline), std::move(final), {}};
+
+    std::set<std::string, std::less<>> kinds;
+    for (auto const &sample : {&result.baseline, &result.final}) {
+        for (auto const &entry : sample->liveObjects) {
+            kinds.insert(entry.first);
+        }
+    }
+
+    for (auto const &kind : kinds) {
+        auto count = [&kind](ReloadStressSample const &sample) -> int64_t {
+            auto entry = sample.liveObjects.find(kind);
+            return entry == sample.liveObjects.end() ? 0 : entry->second;
+        };
+        auto before = count(result.baseline);
+        auto after = count(result.final);
+        if (after > before + options.objectTolerance) {
+            result.failures.push_back("live " + kind + " grew from " + std::to_string(before) +
+                                      " to " + std::to_string(after));
+        }
+    }
+
+    if (result.baseline.residentBytes && result.final.residentBytes) {
+        auto before = *result.baseline.residentBytes;
+        auto after = *result.final.residentBytes;
+        if (static_cast<double>(after) >
+            static_cast<double>(before) * (1.0 + options.memoryTolerance)) {
+            result.failures.push_back("resident memory grew from " + std::to_string(before) +
+                                      " to " + std::to_string(after) + " bytes");
+        }
+    }
+
+    return result;
+}
+
+ReloadStressDriver::ReloadStressDriver(ReloadStressOptions options,
+                                       Reload reload,
+                                       Completion completion)
+    : options_(options), reload_(std::move(reload)), completion_(std::move(completion))
+{
+}
+
+void ReloadStressDriver::Start()
+{
+    if (running_) {
+        return;
+    }
+
+    running_ = true;
+    reloads_ = 0;
+    reload_();
+}
+
+void ReloadStressDriver::OnReloaded()
+{
+    if (!running_) {
+        return;
+    }
+
+    // The first reload is a warm-up; caches and lazily initialized singletons
+    // that survive reloads are populated before the baseline is taken
+    ++reloads_;
+    if (reloads_ == 1) {
+        baseline_ = ReloadStressSample::Take();
+    } else if (reloads_ > options_.iterations) {
+        running_ = false;
+        auto final = ReloadStressSample::Take();
+        completion_(EvaluateReloadStress(options_, std::move(baseline_), std::move(final)));
+        return;
+    }
+
+    reload_();
+}
@@ -0,0 +1,94 @@
+#ifndef COMMON_RELOADSTRESS_
+#define COMMON_RELOADSTRESS_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ReactTestApp
+{
+    struct ReloadStressOptions {
+        /** Number of reloads measured after the warm-up reload. */
+        int iterations = 10;
+        /** Number of extra live objects of any kind that is tolerated. */
+        int64_t objectTolerance = 1;
+        /** Fraction by which the resident set size may grow. */
+        double memoryTolerance = 0.1;
+
+        /**
+         * Reads `REACT_TEST_APP_RELOAD_STRESS` (iterations),
+         * `REACT_TEST_APP_RELOAD_STRESS_OBJECTS` and
+         * `REACT_TEST_APP_RELOAD_STRESS_MEMORY` (percent) from the
+         * environment. Returns nothing if stress mode is not requested.
+         */
+        static std::optional<ReloadStressOptions> FromEnvironment();
+    };
+
+    struct ReloadStressSample {
+        std::map<std::string, int64_t, std::less<>> liveObjects;
+        std::optional<uint64_t> residentBytes;
+
+        static ReloadStressSample Take();
+    };
+
+    struct ReloadStressResult {
+        int iterations;
+        ReloadStressSample baseline;
+        ReloadStressSample final;
+        /** Human readable descriptions of every exceeded tolerance. */
+        std::vector<std::string> failures;
+
+        bool Passed() const
+        {
+            return failures.empty();
+        }
+
+        std::string ToJSON() const;
+    };
+
+    /**
+     * Compares two samples and returns the result of a stress run.
+     */
+    ReloadStressResult EvaluateReloadStress(ReloadStressOptions const &options,
+                                            ReloadStressSample baseline,
+                                            ReloadStressSample final);
+
+    /**
+     * Reloads the app repeatedly and checks that live objects and memory
+     * return to the levels seen after the first reload.
+     *
+     * The driver does not own any threads; the host calls `Reload` on its
+     * behalf and reports back through `OnReloaded` once the new instance has
+     * loaded. `reload` must not reload synchronously from within
+     * `OnReloaded`.
+     */
+    class ReloadStressDriver
+    {
+    public:
+        using Reload = std::function<void()>;
+        using Completion = std::function<void(ReloadStressResult const &)>;
+
+        ReloadStressDriver(ReloadStressOptions options, Reload reload, Completion completion);
+
+        bool IsRunning() const
+        {
+            return running_;
+        }
+
+        void Start();
+        void OnReloaded();
+
+    private:
+        ReloadStressOptions options_;
+        Reload reload_;
+        Completion completion_;
+        ReloadStressSample baseline_;
+        int reloads_ = 0;
+        bool running_ = false;
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_RELOADSTRESS_
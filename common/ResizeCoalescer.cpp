@@ -0,0 +1,53 @@
+#include "ResizeCoalescer.h"
+
+using ReactTestApp::LogicalSize;
+using ReactTestApp::ResizeCoalescer;
+
+ResizeCoalescer::ResizeCoalescer(float scaleFactor) : scaleFactor_(scaleFactor)
+{
+}
+
+bool ResizeCoalescer::Resize(float width, float height)
+{
+    width_ = width;
+    height_ = height;
+    return RequestFrame();
+}
+
+bool ResizeCoalescer::Rescale(float scaleFactor)
+{
+    if (scaleFactor <= 0 || scaleFactor == scaleFactor_) {
+        return false;
+    }
+
+    scaleFactor_ = scaleFactor;
+    return RequestFrame();
+}
+
+std::optional<LogicalSize> ResizeCoalescer::Flush()
+{
+    frameRequested_ = false;
+
+    LogicalSize size{width_ / scaleFactor_, height_ / scaleFactor_};
+    if (arranged_ == size) {
+        return std::nullopt;
+    }
+
+    arranged_ = size;
+    return size;
+}
+
+void ResizeCoalescer::Reset()
+{
+    arranged_.reset();
+}
+
+bool ResizeCoalescer::RequestFrame()
+{
+    if (frameRequested_) {
+        return false;
+    }
+
+    frameRequested_ = true;
+    return true;
+}
@@ -0,0 +1,64 @@
+#ifndef COMMON_RESIZECOALESCER_
+#define COMMON_RESIZECOALESCER_
+
+#include <optional>
+
+namespace ReactTestApp
+{
+    struct LogicalSize {
+        float width;
+        float height;
+
+        bool operator==(LogicalSize const &) const = default;
+    };
+
+    /**
+     * Coalesces window size and scale changes so that the root view is
+     * arranged at most once per frame, and only when its logical size actually
+     * changed.
+     */
+    class ResizeCoalescer
+    {
+    public:
+        explicit ResizeCoalescer(float scaleFactor);
+
+        float ScaleFactor() const
+        {
+            return scaleFactor_;
+        }
+
+        /**
+         * Records a new client size in physical pixels. Returns `true` if the
+         * caller should schedule a frame callback.
+         */
+        bool Resize(float width, float height);
+
+        /**
+         * Records a new scale factor. Returns `true` if the caller should
+         * schedule a frame callback.
+         */
+        bool Rescale(float scaleFactor);
+
+        /**
+         * Called once per frame. Returns the logical size to arrange, or
+         * nothing if it hasn't changed since the last arrange.
+         */
+        std::optional<LogicalSize> Flush();
+
+        /**
+         * Forgets the last arranged size so that the next flush always arranges.
+         */
+        void Reset();
+
+    private:
+        float scaleFactor_;
+        float width_ = 0;
+        float height_ = 0;
+        std::optional<LogicalSize> arranged_;
+        bool frameRequested_ = false;
+
+        bool RequestFrame();
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_RESIZECOALESCER_
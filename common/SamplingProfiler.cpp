@@ -0,0 +1,149 @@
+#include "SamplingProfiler.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+// `USE_HERMES` is set by the build when the app is configured to use Hermes:
+// by `UseHermes` on Windows, and by `USE_HERMES` on iOS
+#if defined(USE_HERMES) && USE_HERMES
+#include <hermes/hermes.h>
+#define REACTTESTAPP_HAS_HERMES 1
+#endif  // defined(USE_HERMES) && USE_HERMES
+
+#include "OutputFile.h"
+
+using ReactTestApp::SamplingProfiler;
+
+namespace
+{
+#ifdef REACTTESTAPP_HAS_HERMES
+    void EnableSampling()
+    {
+        facebook::hermes::HermesRuntime::enableSamplingProfiler();
+    }
+
+    void DisableSampling(std::string const &path)
+    {
+        facebook::hermes::HermesRuntime::disableSamplingProfiler();
+        facebook::hermes::HermesRuntime::dumpSampledTraceToFile(path);
+    }
+#else
+    void EnableSampling()
+    {
+    }
+
+    void DisableSampling(std::string const &)
+    {
+    }
+#endif  // REACTTESTAPP_HAS_HERMES
+}  // namespace
+
+SamplingProfiler &SamplingProfiler::Shared()
+{
+    static SamplingProfiler profiler;
+    return profiler;
+}
+
+bool SamplingProfiler::IsAvailable()
+{
+#ifdef REACTTESTAPP_HAS_HERMES
+    return true;
+#else
+    return false;
+#endif  // REACTTESTAPP_HAS_HERMES
+}
+
+bool SamplingProfiler::HasSamples(std::string const &profilePath)
+{
+    std::ifstream file(profilePath, std::ios::binary);
+    std::string const profile{std::istreambuf_iterator<char>{file},
+                              std::istreambuf_iterator<char>{}};
+
+    constexpr std::string_view kSamples = "\"samples\"";
+    auto i = profile.find(kSamples);
+    if (i == std::string::npos) {
+        return false;
+    }
+
+    i = profile.find('[', i + kSamples.size());
+    if (i == std::string::npos) {
+        return false;
+    }
+
+    for (++i; i < profile.size(); ++i) {
+        if (!std::isspace(static_cast<unsigned char>(profile[i]))) {
+            return profile[i] != ']';
+        }
+    }
+    return false;
+}
+
+bool SamplingProfiler::ShouldProfileComponents()
+{
+    static bool const shouldProfile = [] {
+        auto value = std::getenv("REACT_TEST_APP_PROFILE_COMPONENTS");
+        return value != nullptr && std::string_view{value} == "1";
+    }();
+    return shouldProfile;
+}
+
+std::string SamplingProfiler::OutputDirectory() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return outputDirectory_;
+}
+
+void SamplingProfiler::OutputDirectory(std::string directory)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    outputDirectory_ = std::move(directory);
+}
+
+bool SamplingProfiler::IsRunning() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return currentPath_.has_value();
+}
+
+bool SamplingProfiler::Start(std::string_view label)
+{
+    if (!IsAvailable()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (currentPath_.has_value()) {
+        return false;
+    }
+
+    currentPath_ = JoinOutputPath(
+        outputDirectory_,
+        MakeOutputFileName(label, std::chrono::system_clock::now(), ".cpuprofile"));
+    EnableSampling();
+    return true;
+}
+
+std::optional<std::string> SamplingProfiler::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!currentPath_.has_value()) {
+        return std::nullopt;
+    }
+
+    auto path = std::move(*currentPath_);
+    currentPath_.reset();
+    DisableSampling(path);
+    return path;
+}
+
+void SamplingProfiler::BeginComponentSession(std::string_view slug)
+{
+    if (!ShouldProfileComponents()) {
+        return;
+    }
+
+    Stop();
+    Start(slug);
+}
@@ -0,0 +1,75 @@
+#ifndef COMMON_SAMPLINGPROFILER_
+#define COMMON_SAMPLINGPROFILER_
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ReactTestApp
+{
+    /**
+     * Controls the Hermes sampling profiler. The profiler is process-wide, so
+     * only one session can run at a time. Each session is written to its own
+     * `.cpuprofile` file in `OutputDirectory()`, named after the label passed
+     * to `Start()` and the time it was started.
+     */
+    class SamplingProfiler
+    {
+    public:
+        static SamplingProfiler &Shared();
+
+        /**
+         * Returns whether the app was built with a JS engine that supports
+         * sampling, i.e. Hermes. This follows the build's `USE_HERMES`
+         * setting; when it is false, `Start()` always fails and callers should
+         * report the profiler as unsupported.
+         */
+        static bool IsAvailable();
+
+        /**
+         * Returns whether the profile at `profilePath` contains any samples.
+         * A profile without samples means that nothing was sampled even though
+         * the app was built with Hermes, e.g. because JS was running in a web
+         * debugger.
+         */
+        static bool HasSamples(std::string const &profilePath);
+
+        /**
+         * Returns whether every component should be profiled from when it is
+         * loaded until the next one is. Set the environment variable
+         * `REACT_TEST_APP_PROFILE_COMPONENTS` to 1 to enable.
+         */
+        static bool ShouldProfileComponents();
+
+        std::string OutputDirectory() const;
+        void OutputDirectory(std::string directory);
+
+        bool IsRunning() const;
+
+        /**
+         * Starts a new session. Returns false if a session is already
+         * running, or if sampling is not available.
+         */
+        bool Start(std::string_view label);
+
+        /**
+         * Stops the current session and returns the path of the written
+         * profile. Returns nothing if no session was running.
+         */
+        std::optional<std::string> Stop();
+
+        /**
+         * Stops any running session, then starts a new one for the component
+         * if `ShouldProfileComponents()`.
+         */
+        void BeginComponentSession(std::string_view slug);
+
+    private:
+        mutable std::mutex mutex_;
+        std::string outputDirectory_;
+        std::optional<std::string> currentPath_;
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_SAMPLINGPROFILER_
@@ -0,0 +1,193 @@
+#include "StallWatchdog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+
+#include "Metrics.h"
+#include "SamplingProfiler.h"
+
+using ReactTestApp::SamplingProfiler;
+using ReactTestApp::StallEvent;
+using ReactTestApp::StallWatchdog;
+
+namespace
+{
+    /**
+     * Profiler session started for a stall. The session is stopped when the
+     * stall ends, or when the recorder is destroyed first, e.g. because the
+     * watchdog was torn down on reload, so that it does not keep the shared
+     * profiler busy.
+     */
+    class StallSession
+    {
+    public:
+        StallSession() = default;
+        ~StallSession()
+        {
+            Stop();
+        }
+
+        StallSession(StallSession const &) = delete;
+        StallSession &operator=(StallSession const &) = delete;
+
+        void Start()
+        {
+            if (!running_) {
+                running_ = SamplingProfiler::Shared().Start("js-stall");
+            }
+        }
+
+        std::optional<std::string> Stop()
+        {
+            if (!running_) {
+                return std::nullopt;
+            }
+
+            running_ = false;
+            return SamplingProfiler::Shared().Stop();
+        }
+
+    private:
+        bool running_ = false;
+    };
+}  // namespace
+
+struct StallWatchdog::State {
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopped = false;
+
+    // Whether a heartbeat was posted and has yet to run on the JS thread
+    bool pending = false;
+    std::chrono::steady_clock::time_point postedAt;
+
+    bool stalled = false;
+    bool recovered = false;
+    std::chrono::steady_clock::time_point answeredAt;
+};
+
+StallWatchdog::StallWatchdog(std::chrono::milliseconds threshold,
+                             Scheduler schedule,
+                             Listener listener)
+    : state_(std::make_shared<State>())
+{
+    auto const interval = std::max(threshold / 4, std::chrono::milliseconds{10});
+    monitor_ = std::thread([state = state_,
+                            threshold,
+                            interval,
+                            schedule = std::move(schedule),
+                            listener = std::move(listener)] {
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+        using std::chrono::steady_clock;
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (!state->stopped) {
+            auto const now = steady_clock::now();
+
+            if (state->recovered) {
+                auto duration = duration_cast<milliseconds>(state->answeredAt - state->postedAt);
+                state->recovered = false;
+                lock.unlock();
+                listener(StallEvent{StallEvent::Phase::Recovered, duration, {}});
+                lock.lock();
+                continue;
+            }
+
+            if (!state->pending) {
+                state->pending = true;
+                state->postedAt = now;
+                lock.unlock();
+
+                // The heartbeat holds on to the state in case it runs after
+                // the watchdog has been destroyed
+                schedule([state] {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->pending = false;
+                    if (state->stalled) {
+                        state->stalled = false;
+                        state->recovered = true;
+                        state->answeredAt = std::chrono::steady_clock::now();
+                        state->wake.notify_one();
+                    }
+                });
+
+                lock.lock();
+            } else if (!state->stalled && now - state->postedAt > threshold) {
+                state->stalled = true;
+                auto duration = duration_cast<milliseconds>(now - state->postedAt);
+                lock.unlock();
+                listener(StallEvent{StallEvent::Phase::Stalled, duration, {}});
+                lock.lock();
+            }
+
+            state->wake.wait_for(
+                lock, interval, [&state] { return state->stopped || state->recovered; });
+        }
+    });
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stopped = true;
+    }
+    state_->wake.notify_one();
+    monitor_.join();
+}
+
+std::optional<std::chrono::milliseconds> ReactTestApp::GetStallThreshold()
+{
+    auto value = std::getenv("REACT_TEST_APP_STALL_THRESHOLD_MS");
+    if (value == nullptr || *value == '\0') {
+        return std::nullopt;
+    }
+
+    char *end = nullptr;
+    auto threshold = std::strtol(value, &end, 10);
+    if (*end != '\0' || threshold <= 0) {
+        return std::nullopt;
+    }
+    return std::chrono::milliseconds{threshold};
+}
+
+StallWatchdog::Listener ReactTestApp::MakeStallRecorder(StallWatchdog::Listener next)
+{
+    auto &metrics = Metrics::Shared();
+    auto stalls = metrics.GetCounter("jsStalls");
+    auto durations = metrics.GetHistogram("jsStallMilliseconds");
+
+    // Listeners must be copyable, so the session is shared between copies
+    auto session = std::make_shared<StallSession>();
+    return [stalls, durations, next = std::move(next), session](StallEvent const &event) {
+        auto report = event;
+        switch (event.phase) {
+            case StallEvent::Phase::Stalled:
+                stalls.Increment();
+                // The stalled thread cannot be asked for its stack, but the
+                // sampling profiler interrupts it from the outside. Sampling
+                // only starts now, so the samples show where the thread is
+                // stuck rather than what led up to it. If a session is
+                // already running, the stall ends up in there.
+                session->Start();
+                break;
+
+            case StallEvent::Phase::Recovered:
+                durations.Record(static_cast<uint64_t>(event.duration.count()));
+                if (auto path = session->Stop()) {
+                    if (SamplingProfiler::HasSamples(*path)) {
+                        report.samplesPath = std::move(*path);
+                    }
+                }
+                break;
+        }
+
+        if (next) {
+            next(report);
+        }
+    };
+}
@@ -0,0 +1,82 @@
+#ifndef COMMON_STALLWATCHDOG_
+#define COMMON_STALLWATCHDOG_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace ReactTestApp
+{
+    struct StallEvent {
+        enum class Phase {
+            /** The JS thread has not responded for longer than the threshold. */
+            Stalled,
+            /** The JS thread is responsive again. */
+            Recovered,
+        };
+
+        Phase phase;
+
+        /**
+         * Time since the unanswered heartbeat was posted.
+         */
+        std::chrono::milliseconds duration;
+
+        /**
+         * Path to the JS stack samples taken during the stall, if any.
+         */
+        std::string samplesPath;
+    };
+
+    /**
+     * Detects when the JS thread stops processing work. A monitor thread
+     * periodically posts a heartbeat to the JS thread via `schedule`, and
+     * reports a stall once a heartbeat has gone unanswered for longer than
+     * `threshold`. `listener` is always called on the monitor thread.
+     *
+     * The iOS and Windows hosts start a watchdog when a threshold is set; see
+     * `GetStallThreshold()`. The Android host does not use it yet.
+     */
+    class StallWatchdog
+    {
+    public:
+        using Task = std::function<void()>;
+        using Scheduler = std::function<void(Task)>;
+        using Listener = std::function<void(StallEvent const &)>;
+
+        StallWatchdog(std::chrono::milliseconds threshold, Scheduler schedule, Listener listener);
+        ~StallWatchdog();
+
+        StallWatchdog(StallWatchdog const &) = delete;
+        StallWatchdog &operator=(StallWatchdog const &) = delete;
+
+    private:
+        struct State;
+
+        std::shared_ptr<State> state_;
+        std::thread monitor_;
+    };
+
+    /**
+     * Returns the stall threshold set with the environment variable
+     * `REACT_TEST_APP_STALL_THRESHOLD_MS`. Returns nothing, i.e. the watchdog
+     * is disabled, if the variable is unset, 0, or not a number.
+     */
+    std::optional<std::chrono::milliseconds> GetStallThreshold();
+
+    /**
+     * Returns a listener that records stalls to the shared metrics registry
+     * (`jsStalls`, `jsStallMilliseconds`), then forwards them to `next`. If
+     * the sampling profiler is available and idle, it also samples JS stacks
+     * from when each stall is detected until it ends; see `SamplingProfiler`.
+     * Nothing is captured from before detection, i.e. the first `threshold`
+     * of the stall. A session that is still running when the recorder is
+     * destroyed, i.e. with its watchdog, is stopped without being reported.
+     */
+    StallWatchdog::Listener MakeStallRecorder(StallWatchdog::Listener next = nullptr);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_STALLWATCHDOG_
@@ -0,0 +1,192 @@
+#include "SurfaceStress.h"
+
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+#include "AppRegistry.h"
+#include "Histogram.h"
+#include "JSON.h"
+#include "MemoryMonitor.h"
+#include "Metrics.h"
+
+using ReactTestApp::Histogram;
+using ReactTestApp::Metrics;
+using ReactTestApp::SurfaceStressOptions;
+using ReactTestApp::SurfaceStressResult;
+using ReactTestApp::SurfaceStressTracker;
+
+namespace
+{
+    std::optional<uint64_t> SampleResidentBytes()
+    {
+        if (auto memory = ReactTestApp::SampleProcessMemory()) {
+            return memory->residentBytes;
+        }
+        return std::nullopt;
+    }
+
+    void AppendOptional(std::string &out, std::optional<uint64_t> const &value)
+    {
+        out += value ? std::to_string(*value) : "null";
+    }
+}  // namespace
+
+std::optional<SurfaceStressOptions> SurfaceStressOptions::FromEnvironment()
+{
+    auto surfaces = std::getenv("REACT_TEST_APP_SURFACES");
+    if (surfaces == nullptr || *surfaces == '\0') {
+        return std::nullopt;
+    }
+
+    char *end = nullptr;
+    auto count = std::strtoll(surfaces, &end, 10);
+    if (*end != '\0' || count <= 0) {
+        return std::nullopt;
+    }
+
+    SurfaceStressOptions options;
+    options.surfaces = static_cast<size_t>(count);
+    if (auto component = std::getenv("REACT_TEST_APP_SURFACE_COMPONENT")) {
+        options.component = component;
+    }
+    return options;
+}
+
+size_t SurfaceStressResult::MountedSurfaces() const
+{
+    size_t mounted = 0;
+    for (auto &&duration : mountDurations) {
+        if (duration.has_value()) {
+            ++mounted;
+        }
+    }
+    return mounted;
+}
+
+std::optional<uint64_t> SurfaceStressResult::ResidentBytesPerSurface() const
+{
+    auto mounted = MountedSurfaces();
+    if (mounted == 0 || !baselineResidentBytes || !finalResidentBytes) {
+        return std::nullopt;
+    }
+
+    auto growth = *finalResidentBytes > *baselineResidentBytes
+                      ? *finalResidentBytes - *baselineResidentBytes
+                      : 0;
+    return growth / mounted;
+}
+
+std::string SurfaceStressResult::ToJSON() const
+{
+    Histogram mountTimes;
+    for (auto &&duration : mountDurations) {
+        if (duration.has_value()) {
+            mountTimes.Record(static_cast<uint64_t>(duration->count()));
+        }
+    }
+
+    std::string json = "{\"component\":";
+    AppendJSONString(json, component);
+    json += ",\"surfaces\":";
+    json += std::to_string(mountDurations.size());
+    json += ",\"mountedSurfaces\":";
+    json += std::to_string(MountedSurfaces());
+    json += ",\"durationMicroseconds\":";
+    json += std::to_string(duration.count());
+    json += ",\"mountMicroseconds\":";
+    mountTimes.Snapshot().AppendJSON(json);
+    json += ",\"baselineResidentBytes\":";
+    AppendOptional(json, baselineResidentBytes);
+    json += ",\"finalResidentBytes\":";
+    AppendOptional(json, finalResidentBytes);
+    json += ",\"residentBytesPerSurface\":";
+    AppendOptional(json, ResidentBytesPerSurface());
+    json += '}';
+    return json;
+}
+
+SurfaceStressTracker::SurfaceStressTracker(std::string component,
+                                           size_t surfaces,
+                                           Completion completion)
+    : start_(std::chrono::steady_clock::now()), remaining_(surfaces),
+      completion_(std::move(completion))
+{
+    result_.component = std::move(component);
+    result_.mountDurations.resize(surfaces);
+    result_.baselineResidentBytes = SampleResidentBytes();
+}
+
+bool SurfaceStressTracker::IsRunning() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return remaining_ > 0;
+}
+
+void SurfaceStressTracker::OnMounted(size_t surface)
+{
+    static auto const mountTimes = Metrics::Shared().GetHistogram("surfaceMountMicroseconds");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (remaining_ == 0 || surface >= result_.mountDurations.size() ||
+        result_.mountDurations[surface].has_value()) {
+        return;
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_);
+    mountTimes.Record(static_cast<uint64_t>(duration.count()));
+    result_.mountDurations[surface] = duration;
+    if (--remaining_ == 0) {
+        Complete(std::move(lock));
+    }
+}
+
+void SurfaceStressTracker::Finish()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (remaining_ > 0) {
+        remaining_ = 0;
+        Complete(std::move(lock));
+    }
+}
+
+void SurfaceStressTracker::Complete(std::unique_lock<std::mutex> lock)
+{
+    result_.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_);
+    result_.finalResidentBytes = SampleResidentBytes();
+    auto result = result_;
+    lock.unlock();
+
+    if (auto perSurface = result.ResidentBytesPerSurface()) {
+        Metrics::Shared()
+            .GetGauge("residentBytesPerSurface")
+            .Set(static_cast<int64_t>(*perSurface));
+    }
+
+    if (completion_) {
+        completion_(result);
+    }
+}
+
+SurfaceStressResult ReactTestApp::RunHeadlessSurfaces(facebook::jsi::Runtime &runtime,
+                                                      std::string const &appKey,
+                                                      size_t surfaces)
+{
+    SurfaceStressResult result;
+    SurfaceStressTracker tracker(
+        appKey, surfaces, [&result](SurfaceStressResult const &r) { result = r; });
+    for (size_t i = 0; i < surfaces; ++i) {
+        try {
+            // Root tags of React Native apps end in 1
+            if (RunApplication(runtime, appKey, static_cast<int>(i * 10 + 1))) {
+                tracker.OnMounted(i);
+            }
+        } catch (std::exception const &) {
+            // The surface is reported as not mounted
+        }
+    }
+    tracker.Finish();
+    return result;
+}
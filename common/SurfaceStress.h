@@ -0,0 +1,109 @@
+#ifndef COMMON_SURFACESTRESS_
+#define COMMON_SURFACESTRESS_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace facebook::jsi
+{
+    class Runtime;
+}
+
+namespace ReactTestApp
+{
+    struct SurfaceStressOptions {
+        /** Number of surfaces mounted at once. */
+        size_t surfaces = 8;
+        /** Slug or app key of the component to mount. */
+        std::string component;
+
+        /**
+         * Reads `REACT_TEST_APP_SURFACES` and, optionally,
+         * `REACT_TEST_APP_SURFACE_COMPONENT` from the environment. Returns
+         * nothing if stress mode is not requested.
+         */
+        static std::optional<SurfaceStressOptions> FromEnvironment();
+    };
+
+    struct SurfaceStressResult {
+        std::string component;
+        /**
+         * Time from the start of the run until each surface had mounted, or
+         * nothing for surfaces that never did.
+         */
+        std::vector<std::optional<std::chrono::microseconds>> mountDurations;
+        /** Time until every surface had mounted or the run was stopped. */
+        std::chrono::microseconds duration{0};
+        std::optional<uint64_t> baselineResidentBytes;
+        std::optional<uint64_t> finalResidentBytes;
+
+        size_t MountedSurfaces() const;
+
+        /**
+         * Returns the growth of the resident set size divided by the number
+         * of mounted surfaces.
+         */
+        std::optional<uint64_t> ResidentBytesPerSurface() const;
+
+        std::string ToJSON() const;
+    };
+
+    /**
+     * Collects mount times and memory while one component is mounted on many
+     * surfaces at once. Surfaces are expected to be created right after the
+     * tracker, which samples the resident set size on construction and again
+     * once every surface has mounted. The result is then recorded to the
+     * shared metrics registry and passed to `completion`, on the thread of
+     * the last report.
+     */
+    class SurfaceStressTracker
+    {
+    public:
+        using Completion = std::function<void(SurfaceStressResult const &)>;
+
+        SurfaceStressTracker(std::string component, size_t surfaces, Completion completion);
+
+        SurfaceStressTracker(SurfaceStressTracker const &) = delete;
+        SurfaceStressTracker &operator=(SurfaceStressTracker const &) = delete;
+
+        bool IsRunning() const;
+
+        /**
+         * Reports that `surface` has mounted. Only the first report of each
+         * surface counts.
+         */
+        void OnMounted(size_t surface);
+
+        /**
+         * Ends the run before every surface has mounted, e.g. because it was
+         * cancelled or timed out.
+         */
+        void Finish();
+
+    private:
+        void Complete(std::unique_lock<std::mutex> lock);
+
+        mutable std::mutex mutex_;
+        std::chrono::steady_clock::time_point start_;
+        SurfaceStressResult result_;
+        size_t remaining_;
+        Completion completion_;
+    };
+
+    /**
+     * Mounts `appKey` on `surfaces` surfaces of a headless runtime that has
+     * already evaluated its bundle, by calling `AppRegistry.runApplication`
+     * with distinct root tags. A surface counts as mounted once
+     * `runApplication` returns without throwing.
+     */
+    SurfaceStressResult RunHeadlessSurfaces(facebook::jsi::Runtime &runtime,
+                                            std::string const &appKey,
+                                            size_t surfaces);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_SURFACESTRESS_
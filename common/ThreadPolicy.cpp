@@ -0,0 +1,268 @@
+#include "ThreadPolicy.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <cstring>
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using ReactTestApp::ThreadPolicy;
+
+namespace
+{
+    using Priority = ThreadPolicy::Priority;
+    using QualityOfService = ThreadPolicy::QualityOfService;
+
+#if defined(_WIN32)
+
+    std::string LastErrorMessage(char const *what)
+    {
+        return std::string{what} + " failed with error " + std::to_string(GetLastError());
+    }
+
+    void ApplyPriority(Priority priority, std::vector<std::string> &failures)
+    {
+        int value = THREAD_PRIORITY_NORMAL;
+        switch (priority) {
+            case Priority::Low:
+                value = THREAD_PRIORITY_BELOW_NORMAL;
+                break;
+            case Priority::Normal:
+                value = THREAD_PRIORITY_NORMAL;
+                break;
+            case Priority::High:
+                value = THREAD_PRIORITY_ABOVE_NORMAL;
+                break;
+        }
+
+        if (!SetThreadPriority(GetCurrentThread(), value)) {
+            failures.push_back(LastErrorMessage("SetThreadPriority"));
+        }
+    }
+
+    void ApplyQualityOfService(QualityOfService qos, std::vector<std::string> &failures)
+    {
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+        THREAD_POWER_THROTTLING_STATE state{};
+        state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+        state.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+        state.StateMask = qos == QualityOfService::Background || qos == QualityOfService::Utility
+                              ? THREAD_POWER_THROTTLING_EXECUTION_SPEED
+                              : 0;
+        if (!SetThreadInformation(
+                GetCurrentThread(), ThreadPowerThrottling, &state, sizeof(state))) {
+            failures.push_back(LastErrorMessage("SetThreadInformation"));
+        }
+#else
+        (void)qos;
+        failures.push_back("QoS is not supported on this platform");
+#endif  // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+    }
+
+    void ApplyAffinity(std::vector<int> const &cpus, std::vector<std::string> &failures)
+    {
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+        DWORD_PTR mask = 0;
+        for (auto cpu : cpus) {
+            if (cpu < 0 || cpu >= static_cast<int>(sizeof(mask) * 8)) {
+                failures.push_back("CPU " + std::to_string(cpu) + " is out of range");
+                return;
+            }
+            mask |= DWORD_PTR{1} << cpu;
+        }
+
+        if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+            failures.push_back(LastErrorMessage("SetThreadAffinityMask"));
+        }
+#else
+        (void)cpus;
+        failures.push_back("CPU affinity is not supported on this platform");
+#endif  // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+    }
+
+    void Apply(ThreadPolicy const &policy, std::vector<std::string> &failures)
+    {
+        if (policy.priority.has_value()) {
+            ApplyPriority(*policy.priority, failures);
+        }
+        if (policy.qos.has_value()) {
+            ApplyQualityOfService(*policy.qos, failures);
+        }
+        if (!policy.affinity.empty()) {
+            ApplyAffinity(policy.affinity, failures);
+        }
+    }
+
+#elif defined(__APPLE__)
+
+    qos_class_t ToQoSClass(QualityOfService qos)
+    {
+        switch (qos) {
+            case QualityOfService::Background:
+                return QOS_CLASS_BACKGROUND;
+            case QualityOfService::Utility:
+                return QOS_CLASS_UTILITY;
+            case QualityOfService::UserInitiated:
+                return QOS_CLASS_USER_INITIATED;
+            case QualityOfService::UserInteractive:
+                return QOS_CLASS_USER_INTERACTIVE;
+        }
+        return QOS_CLASS_DEFAULT;
+    }
+
+    qos_class_t ToQoSClass(Priority priority)
+    {
+        switch (priority) {
+            case Priority::Low:
+                return QOS_CLASS_UTILITY;
+            case Priority::Normal:
+                return QOS_CLASS_DEFAULT;
+            case Priority::High:
+                return QOS_CLASS_USER_INTERACTIVE;
+        }
+        return QOS_CLASS_DEFAULT;
+    }
+
+    void Apply(ThreadPolicy const &policy, std::vector<std::string> &failures)
+    {
+        if (policy.qos.has_value() || policy.priority.has_value()) {
+            // With an explicit QoS class, a low priority lowers the thread
+            // within that class
+            auto qos = policy.qos.has_value() ? ToQoSClass(*policy.qos)
+                                              : ToQoSClass(*policy.priority);
+            auto relativePriority =
+                policy.qos.has_value() && policy.priority == Priority::Low ? -8 : 0;
+            if (auto error = pthread_set_qos_class_self_np(qos, relativePriority)) {
+                failures.push_back("pthread_set_qos_class_self_np failed with error " +
+                                   std::to_string(error));
+            }
+        }
+
+        if (!policy.affinity.empty()) {
+            failures.push_back("CPU affinity is not supported on this platform");
+        }
+    }
+
+#elif defined(__linux__)
+
+    int ToNiceValue(Priority priority)
+    {
+        switch (priority) {
+            case Priority::Low:
+                return 10;
+            case Priority::Normal:
+                return 0;
+            case Priority::High:
+                return -4;
+        }
+        return 0;
+    }
+
+    int ToNiceValue(QualityOfService qos)
+    {
+        switch (qos) {
+            case QualityOfService::Background:
+                return 10;
+            case QualityOfService::Utility:
+                return 5;
+            case QualityOfService::UserInitiated:
+                return 0;
+            case QualityOfService::UserInteractive:
+                return -4;
+        }
+        return 0;
+    }
+
+    std::string ErrnoMessage(char const *what)
+    {
+        return std::string{what} + " failed: " + std::strerror(errno);
+    }
+
+    void Apply(ThreadPolicy const &policy, std::vector<std::string> &failures)
+    {
+        if (policy.priority.has_value() || policy.qos.has_value()) {
+            // On Linux, nice values are per thread when given a thread id
+            auto nice = policy.priority.has_value() ? ToNiceValue(*policy.priority)
+                                                    : ToNiceValue(*policy.qos);
+            auto tid = static_cast<id_t>(syscall(SYS_gettid));
+            if (setpriority(PRIO_PROCESS, tid, nice) != 0) {
+                failures.push_back(ErrnoMessage("setpriority"));
+            }
+        }
+
+        if (!policy.affinity.empty()) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (auto cpu : policy.affinity) {
+                if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                    failures.push_back("CPU " + std::to_string(cpu) + " is out of range");
+                    return;
+                }
+                CPU_SET(cpu, &cpus);
+            }
+
+            if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+                failures.push_back(ErrnoMessage("sched_setaffinity"));
+            }
+        }
+    }
+
+#else
+
+    void Apply(ThreadPolicy const &policy, std::vector<std::string> &failures)
+    {
+        if (!policy.IsEmpty()) {
+            failures.push_back("Thread policies are not supported on this platform");
+        }
+    }
+
+#endif
+}  // namespace
+
+std::optional<ThreadPolicy::Priority> ThreadPolicy::ParsePriority(std::string_view value)
+{
+    if (value == "low") {
+        return Priority::Low;
+    }
+    if (value == "normal") {
+        return Priority::Normal;
+    }
+    if (value == "high") {
+        return Priority::High;
+    }
+    return std::nullopt;
+}
+
+std::optional<ThreadPolicy::QualityOfService>
+ThreadPolicy::ParseQualityOfService(std::string_view value)
+{
+    if (value == "background") {
+        return QualityOfService::Background;
+    }
+    if (value == "utility") {
+        return QualityOfService::Utility;
+    }
+    if (value == "userInitiated") {
+        return QualityOfService::UserInitiated;
+    }
+    if (value == "userInteractive") {
+        return QualityOfService::UserInteractive;
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> ReactTestApp::ApplyThreadPolicy(ThreadPolicy const &policy)
+{
+    std::vector<std::string> failures;
+    Apply(policy, failures);
+    return failures;
+}
@@ -0,0 +1,64 @@
+#ifndef COMMON_THREADPOLICY_
+#define COMMON_THREADPOLICY_
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ReactTestApp
+{
+    /**
+     * Scheduling policy for a thread. Unset fields leave the corresponding
+     * setting untouched.
+     */
+    struct ThreadPolicy {
+        enum class Priority {
+            Low,
+            Normal,
+            High,
+        };
+
+        enum class QualityOfService {
+            Background,
+            Utility,
+            UserInitiated,
+            UserInteractive,
+        };
+
+        std::optional<Priority> priority;
+        std::optional<QualityOfService> qos;
+        /** Indices of the CPUs the thread may run on. */
+        std::vector<int> affinity;
+
+        bool IsEmpty() const
+        {
+            return !priority.has_value() && !qos.has_value() && affinity.empty();
+        }
+
+        /**
+         * Parses `low`, `normal` or `high`.
+         */
+        static std::optional<Priority> ParsePriority(std::string_view value);
+
+        /**
+         * Parses `background`, `utility`, `userInitiated` or
+         * `userInteractive`.
+         */
+        static std::optional<QualityOfService> ParseQualityOfService(std::string_view value);
+    };
+
+    /**
+     * Applies `policy` to the calling thread and returns a description of
+     * every setting that could not be applied.
+     *
+     * - Linux and Android map priority, or QoS if priority is unset, to a
+     *   nice value. Raising priority above normal may require privileges.
+     * - Apple platforms map priority to a QoS class if QoS is unset. CPU
+     *   affinity is not supported.
+     * - Windows maps QoS to power throttling (EcoQoS).
+     */
+    std::vector<std::string> ApplyThreadPolicy(ThreadPolicy const &policy);
+}  // namespace ReactTestApp
+
+#endif  // COMMON_THREADPOLICY_
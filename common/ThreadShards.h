@@ -0,0 +1,86 @@
+#ifndef COMMON_THREADSHARDS_
+#define COMMON_THREADSHARDS_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ReactTestApp
+{
+    /**
+     * Hands out one `Shard` per thread. After a thread's first call, `Local()`
+     * is a thread-local lookup and takes no locks; the shard is then only
+     * written by that thread and may be read by others via `ForEach()`.
+     */
+    template <typename Shard>
+    class ThreadShards
+    {
+    public:
+        ThreadShards() : id_(NextId())
+        {
+        }
+
+        ThreadShards(ThreadShards const &) = delete;
+        ThreadShards &operator=(ThreadShards const &) = delete;
+
+        Shard &Local()
+        {
+            // Each thread remembers its shard for the last few instances it
+            // used, so that instances sharing a `Shard` type do not evict each
+            // other. Instances are told apart by id rather than address, since
+            // a new instance may be allocated where a destroyed one used to be.
+            thread_local std::array<std::pair<uint64_t, Shard *>, kCacheSize> cache{};
+            auto &cached = cache[id_ % kCacheSize];
+            if (cached.first == id_) {
+                return *cached.second;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            auto const thread = std::this_thread::get_id();
+            for (auto &[owner, shard] : shards_) {
+                if (owner == thread) {
+                    cached = {id_, shard.get()};
+                    return *shard;
+                }
+            }
+
+            shards_.emplace_back(thread, std::make_unique<Shard>());
+            cached = {id_, shards_.back().second.get()};
+            return *cached.second;
+        }
+
+        /**
+         * Calls `fn` with every shard while preventing new ones from being
+         * added. Shards may be concurrently written by their threads.
+         */
+        template <typename Fn>
+        void ForEach(Fn &&fn) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto const &[owner, shard] : shards_) {
+                fn(static_cast<Shard const &>(*shard));
+            }
+        }
+
+    private:
+        static constexpr size_t kCacheSize = 8;
+
+        uint64_t const id_;
+        mutable std::mutex mutex_;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<Shard>>> shards_;
+
+        static uint64_t NextId()
+        {
+            static std::atomic<uint64_t> nextId{1};
+            return nextId.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+}  // namespace ReactTestApp
+
+#endif  // COMMON_THREADSHARDS_
@@ -4,17 +4,80 @@
 
 #import <React/RCTBridge.h>
 
+#import "AppKeyDiff.h"
 #import "AppRegistry.h"
+#import "EventChannel.h"
+#import "LiveObjects.h"
+#import "Metrics.h"
 #import "ReactTestApp-DevSupport.h"
+#import "StallWatchdog.h"
+#import "ThreadPolicy.h"
 
 using facebook::jsi::Runtime;
+using ReactTestApp::AppKeyChange;
+using ReactTestApp::EventChannel;
+using ReactTestApp::StallEvent;
+using ReactTestApp::StallWatchdog;
+using ReactTestApp::ThreadPolicy;
+
+namespace
+{
+    ThreadPolicy gJSThreadPolicy;
+
+    // Hosts keep their component list across reloads, while a new instance of
+    // the module is created for every bridge. Changes must therefore be
+    // relative to the last list posted by any instance. Main queue only.
+    ReactTestApp::AppKeyTracker &RegisteredAppKeys()
+    {
+        static ReactTestApp::AppKeyTracker appKeys;
+        return appKeys;
+    }
+
+    void LogStall(StallEvent const &event)
+    {
+        NSLog(@"JS thread %s after %lld ms%s%s",
+              event.phase == StallEvent::Phase::Stalled ? "stalled" : "recovered",
+              static_cast<long long>(event.duration.count()),
+              event.samplesPath.empty() ? "" : "; samples: ",
+              event.samplesPath.c_str());
+    }
+}  // namespace
+
+void RTASetJSThreadPolicy(NSDictionary<NSString *, id> *policy)
+{
+    gJSThreadPolicy = {};
+
+    NSString *priority = policy[@"priority"];
+    if ([priority isKindOfClass:[NSString class]]) {
+        gJSThreadPolicy.priority = ThreadPolicy::ParsePriority(priority.UTF8String);
+    }
+
+    NSString *qos = policy[@"qos"];
+    if ([qos isKindOfClass:[NSString class]]) {
+        gJSThreadPolicy.qos = ThreadPolicy::ParseQualityOfService(qos.UTF8String);
+    }
+
+    NSArray *affinity = policy[@"affinity"];
+    if ([affinity isKindOfClass:[NSArray class]]) {
+        for (id cpu in affinity) {
+            if ([cpu isKindOfClass:[NSNumber class]]) {
+                gJSThreadPolicy.affinity.push_back([cpu intValue]);
+            }
+        }
+    }
+}
 
 @interface RCTCxxBridge : RCTBridge
 @property (nonatomic, readonly) void *runtime;
 - (void)invokeAsync:(std::function<void()> &&)func;
 @end
 
-@implementation RTAAppRegistryModule
+@implementation RTAAppRegistryModule {
+    std::unique_ptr<StallWatchdog> _watchdog;
+    std::unique_ptr<EventChannel<std::vector<std::string>>> _registrations;
+}
+
+@synthesize bridge = _bridge;
 
 RCT_EXPORT_MODULE();
 
@@ -26,6 +89,13 @@ RCT_EXPORT_MODULE();
 - (instancetype)init
 {
     if (self = [super init]) {
+        __weak RTAAppRegistryModule *weakSelf = self;
+        _registrations = std::make_unique<EventChannel<std::vector<std::string>>>(8, [weakSelf] {
+            dispatch_async(dispatch_get_main_queue(), ^{
+              [weakSelf drainRegistrations];
+            });
+        });
+
         [NSNotificationCenter.defaultCenter addObserver:self
                                                selector:@selector(javascriptDidLoadNotification:)
                                                    name:RCTJavaScriptDidLoadNotification
@@ -36,35 +106,92 @@ RCT_EXPORT_MODULE();
 
 - (void)javascriptDidLoadNotification:(NSNotification *)note
 {
+    // Instances from before a reload may still be around; only the one that
+    // belongs to the bridge that loaded should respond
     id bridge = note.userInfo[@"bridge"];
-    if (![bridge isKindOfClass:[RCTCxxBridge class]] ||
+    if ((self.bridge != nil && bridge != self.bridge) ||
+        ![bridge isKindOfClass:[RCTCxxBridge class]] ||
         ![bridge respondsToSelector:@selector(runtime)] ||
         ![bridge respondsToSelector:@selector(invokeAsync:)]) {
         return;
     }
 
     RCTCxxBridge *batchedBridge = (RCTCxxBridge *)bridge;
-    [batchedBridge invokeAsync:[batchedBridge] {
+    [self startWatchdogWithBridge:batchedBridge];
+
+    [batchedBridge invokeAsync:[self, batchedBridge, policy = gJSThreadPolicy] {
+        for (auto &&failure : ReactTestApp::ApplyThreadPolicy(policy)) {
+            NSLog(@"Failed to apply JS thread policy: %s", failure.c_str());
+        }
+
         auto runtime = static_cast<Runtime *>(batchedBridge.runtime);
         if (runtime == nullptr) {
             return;
         }
 
+        ReactTestApp::TrackRuntimeLifetime(*runtime);
+        ReactTestApp::InstallMetrics(*runtime);
+
         auto appKeys = ReactTestApp::GetAppKeys(*runtime);
         if (appKeys.empty()) {
             return;
         }
 
-        NSMutableArray *array = [NSMutableArray arrayWithCapacity:appKeys.size()];
-        for (const auto &appKey : appKeys) {
+        _registrations->Send(std::move(appKeys));
+    }];
+}
+
+- (void)drainRegistrations
+{
+    _registrations->Drain([self](std::vector<std::string> &&appKeys) {
+        // Hosts reopen the only component after every reload, so it must be
+        // reported even if nothing changed
+        auto &tracker = RegisteredAppKeys();
+        auto changes = tracker.Update(std::move(appKeys));
+        auto const &registered = tracker.AppKeys();
+        if (changes.empty() && registered.size() != 1) {
+            return;
+        }
+
+        NSMutableArray *array = [NSMutableArray arrayWithCapacity:registered.size()];
+        for (const auto &appKey : registered) {
             [array addObject:[NSString stringWithUTF8String:appKey.c_str()]];
         }
 
+        NSMutableArray<NSNumber *> *removed = [NSMutableArray array];
+        NSMutableArray<NSNumber *> *inserted = [NSMutableArray array];
+        for (const auto &change : changes) {
+            auto indices = change.kind == AppKeyChange::Kind::Remove ? removed : inserted;
+            [indices addObject:@(change.index)];
+        }
+
         [NSNotificationCenter.defaultCenter
             postNotificationName:ReactTestAppDidRegisterAppsNotification
                           object:nil
-                        userInfo:@{@"appKeys": [array copy]}];
-    }];
+                        userInfo:@{
+                            @"appKeys": [array copy],
+                            @"removedIndices": [removed copy],
+                            @"insertedIndices": [inserted copy],
+                        }];
+    });
+}
+
+- (void)startWatchdogWithBridge:(RCTCxxBridge *)bridge
+{
+    _watchdog.reset();
+
+    auto threshold = ReactTestApp::GetStallThreshold();
+    if (!threshold.has_value()) {
+        return;
+    }
+
+    __weak RCTCxxBridge *weakBridge = bridge;
+    _watchdog = std::make_unique<StallWatchdog>(
+        *threshold,
+        [weakBridge](StallWatchdog::Task task) {
+            [weakBridge invokeAsync:std::move(task)];
+        },
+        ReactTestApp::MakeStallRecorder(LogStall));
 }
 
 @end
@@ -103,7 +103,12 @@ final class ContentViewController: UITableViewController {
                     }
 
                     let components = appKeys.map { Component(appKey: $0) }
-                    strongSelf.onComponentsRegistered(components, checksum: Manifest.checksum())
+                    strongSelf.onComponentsRegistered(
+                        components,
+                        checksum: Manifest.checksum(),
+                        removed: note.userInfo?["removedIndices"] as? [Int],
+                        inserted: note.userInfo?["insertedIndices"] as? [Int]
+                    )
                 }
             )
         }
@@ -230,7 +235,12 @@ final class ContentViewController: UITableViewController {
         }
     }
 
-    private func onComponentsRegistered(_ components: [Component], checksum: String) {
+    private func onComponentsRegistered(
+        _ components: [Component],
+        checksum: String,
+        removed: [Int]? = nil,
+        inserted: [Int]? = nil
+    ) {
         let items = components.enumerated().map { index, component in
             NavigationLink(title: component.displayName ?? component.appKey) { [weak self] in
                 self?.navigate(to: component)
@@ -249,8 +259,23 @@ final class ContentViewController: UITableViewController {
                 footer: "\(runtimeInfo())\n\nShake your device\(keyboardShortcut) to open the React Native debug menu."
             ))
         } else {
+            let previousCount = sections[0].items.count
             sections[0].items = items
-            tableView.reloadSections(IndexSet(integer: 0), with: .automatic)
+            // The changes are relative to the last list posted by any bridge;
+            // fall back to a full reload if they do not lead to what we have
+            if let removed = removed, let inserted = inserted,
+               previousCount - removed.count + inserted.count == components.count
+            {
+                // Only animate the rows that changed since the last registration
+                let deletions = removed.map { IndexPath(row: $0, section: Section.components) }
+                let insertions = inserted.map { IndexPath(row: $0, section: Section.components) }
+                tableView.performBatchUpdates({ [tableView] in
+                    tableView?.deleteRows(at: deletions, with: .automatic)
+                    tableView?.insertRows(at: insertions, with: .automatic)
+                })
+            } else {
+                tableView.reloadSections(IndexSet(integer: 0), with: .automatic)
+            }
 
             if components.count == 1, isVisible {
                 navigate(to: components[0])
@@ -7,6 +7,7 @@ struct Component {
     let initialProperties: [String: Any]?
     let presentationStyle: String?
     let slug: String?
+    let bundleSegment: String?
 }
 
 struct Manifest {
@@ -16,6 +17,7 @@ struct Manifest {
     let bundleRoot: String?
     let singleApp: String?
     let components: [Component]?
+    let engine: [String: Any]?
 }
 
 extension Component {
@@ -25,7 +27,8 @@ extension Component {
             displayName: nil,
             initialProperties: nil,
             presentationStyle: nil,
-            slug: nil
+            slug: nil,
+            bundleSegment: nil
         )
     }
 }
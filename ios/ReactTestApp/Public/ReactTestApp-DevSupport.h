@@ -12,4 +12,11 @@ extern NSNotificationName const ReactTestAppSceneDidOpenURLNotification;
 
 extern NSNotificationName const ReactInstanceDidLoadBundle;
 
+/**
+ * Sets the scheduling policy that is applied to the JS thread whenever a bundle
+ * has loaded, i.e. the `engine.jsThread` section of the app manifest. Must be
+ * called before React Native is initialized.
+ */
+FOUNDATION_EXTERN void RTASetJSThreadPolicy(NSDictionary<NSString *, id> *_Nullable policy);
+
 NS_ASSUME_NONNULL_END
@@ -88,6 +88,7 @@ final class ReactInstance: NSObject, RNXHostConfig {
         }
 
         self.bundleRoot = bundleRoot
+        RTASetJSThreadPolicy(Manifest.load().engine?["jsThread"] as? [String: Any])
 
         NotificationCenter.default.post(
             name: .ReactTestAppWillInitializeReactNative,
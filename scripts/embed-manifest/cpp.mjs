@@ -140,7 +140,8 @@ function components(components, level) {
     lines.push(innerIndent + str(c.displayName ?? c.appKey) + ",");
     lines.push(innerIndent + object(c.initialProperties, level + 2) + ",");
     lines.push(innerIndent + str(c.presentationStyle) + ",");
-    lines.push(innerIndent + str(c.slug));
+    lines.push(innerIndent + str(c.slug) + ",");
+    lines.push(innerIndent + str(c.bundleSegment));
     lines.push(outerIndent + "},");
   }
   lines.push(INDENT.repeat(level) + "})");
@@ -173,7 +174,8 @@ export function generate(json, checksum) {
     "        " + str(json.version) + ",",
     "        " + str(json.bundleRoot) + ",",
     "        " + str(json.singleApp) + ",",
-    "        " + components(json.components, 2),
+    "        " + components(json.components, 2) + ",",
+    "        " + object(json.engine, 2),
     "    };",
     "}",
     "",
@@ -134,7 +134,8 @@ function components(components, level) {
     lines.push(innerIndent + str(c.displayName ?? c.appKey) + ",");
     lines.push(innerIndent + bundle(c.initialProperties, level + 2) + ",");
     lines.push(innerIndent + str(c.presentationStyle) + ",");
-    lines.push(innerIndent + str(c.slug));
+    lines.push(innerIndent + str(c.slug) + ",");
+    lines.push(innerIndent + str(c.bundleSegment));
     lines.push(outerIndent + "),");
   }
   lines.push(INDENT.repeat(level) + ")");
@@ -165,7 +166,8 @@ export function generate(json, checksum) {
     "                " + str(json.version) + ",",
     "                " + str(json.bundleRoot) + ",",
     "                " + str(json.singleApp) + ",",
-    "                " + components(json.components, 4),
+    "                " + components(json.components, 4) + ",",
+    "                " + bundle(json.engine, 4),
     "            )",
     "        }",
     "    }",
@@ -119,7 +119,8 @@ function components(components, level) {
       `${innerIndent}initialProperties: ${object(c.initialProperties, level + 2)},`
     );
     lines.push(`${innerIndent}presentationStyle: ${str(c.presentationStyle)},`);
-    lines.push(`${innerIndent}slug: ${str(c.slug)}`);
+    lines.push(`${innerIndent}slug: ${str(c.slug)},`);
+    lines.push(`${innerIndent}bundleSegment: ${str(c.bundleSegment)}`);
     lines.push(outerIndent + "),");
   }
   lines.push(INDENT.repeat(level) + "]");
@@ -147,7 +148,8 @@ export function generate(json, checksum) {
     "            version: " + str(json.version) + ",",
     "            bundleRoot: " + str(json.bundleRoot) + ",",
     "            singleApp: " + str(json.singleApp) + ",",
-    "            components: " + components(json.components, 3),
+    "            components: " + components(json.components, 3) + ",",
+    "            engine: " + object(json.engine, 3),
     "        )",
     "    }",
     "}",
@@ -124,7 +124,8 @@ function getLanguage(output) {
             "            displayName: nil,",
             "            initialProperties: nil,",
             "            presentationStyle: nil,",
-            "            slug: nil",
+            "            slug: nil,",
+            "            bundleSegment: nil",
             "        )",
             "    }",
             "}",
@@ -25,6 +25,7 @@ export async function readDocumentation() {
     "introduction",
     "bundleRoot",
     "components",
+    "engine",
     "resources",
     "singleApp",
     "version",
@@ -127,6 +127,11 @@ export function generateSchema(docs = {}) {
               "URL slug that uniquely identifies this component. Used for deep linking.",
             type: "string",
           },
+          bundleSegment: {
+            description:
+              "Name of the bundle segment that registers this component. The segment is loaded the first time the component is opened.",
+            type: "string",
+          },
         },
         required: ["appKey"],
       },
@@ -160,6 +165,44 @@ export function generateSchema(docs = {}) {
             type: "array",
             items: { $ref: "#/$defs/component" },
           },
+          engine: {
+            description: extractBrief(docs.engine),
+            markdownDescription: docs.engine,
+            type: "object",
+            properties: {
+              maxHeapSizeMB: {
+                description: "Maximum size of the JS heap in megabytes.",
+                type: "integer",
+                minimum: 1,
+              },
+              initHeapSizeMB: {
+                description: "Initial size of the JS heap in megabytes.",
+                type: "integer",
+                minimum: 1,
+              },
+              gcMode: {
+                description:
+                  "Whether the garbage collector should favour a small heap or throughput.",
+                type: "string",
+                enum: ["default", "lowMemory", "throughput"],
+              },
+              bytecodeOnly: {
+                description:
+                  "Whether embedded bundles must be precompiled Hermes bytecode.",
+                type: "boolean",
+              },
+              jsThread: {
+                description: "Scheduling policy of the JS thread.",
+                allOf: [{ $ref: "#/$defs/threadPolicy" }],
+                type: "object",
+              },
+              nativeModulesThread: {
+                description: "Scheduling policy of the native modules thread.",
+                allOf: [{ $ref: "#/$defs/threadPolicy" }],
+                type: "object",
+              },
+            },
+          },
         },
         required: ["name", "displayName"],
       },
@@ -190,6 +233,28 @@ export function generateSchema(docs = {}) {
         required: ["storeFile"],
         "exclude-from-codegen": true,
       },
+      threadPolicy: {
+        type: "object",
+        properties: {
+          priority: {
+            description: "Scheduling priority of the thread.",
+            type: "string",
+            enum: ["low", "normal", "high"],
+          },
+          qos: {
+            description: "Quality of service class of the thread.",
+            type: "string",
+            enum: ["background", "utility", "userInitiated", "userInteractive"],
+          },
+          affinity: {
+            description: "Indices of the CPUs the thread may run on.",
+            type: "array",
+            items: { type: "integer", minimum: 0 },
+            uniqueItems: true,
+          },
+        },
+        "exclude-from-codegen": true,
+      },
     },
     allOf: [{ $ref: "#/$defs/manifest" }],
     type: "object",
@@ -223,6 +223,7 @@ export type Docs = {
   introduction: string;
   bundleRoot: string;
   components: string;
+  engine: string;
   resources: string;
   singleApp: string;
   version: string;
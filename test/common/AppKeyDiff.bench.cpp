@@ -0,0 +1,102 @@
+// Measures how long `AppKeyTracker::Update` takes for large lists of app
+// keys, for the updates hosts see on reload: the first registration, an
+// unchanged list, a single component added, 1% of the components replaced,
+// and a reordered list, which falls back to replacing everything.
+//
+// Usage: AppKeyDiffBenchmark [max keys] [rounds]
+
+#include "AppKeyDiff.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ReactTestApp::AppKeyTracker;
+
+namespace
+{
+    std::vector<std::string> MakeAppKeys(size_t count, char const *prefix)
+    {
+        std::vector<std::string> appKeys;
+        appKeys.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            appKeys.push_back(prefix + std::to_string(i));
+        }
+        return appKeys;
+    }
+
+    // Returns the average time it takes to go from `from` to `to`, and the
+    // number of changes reported
+    double MillisecondsPerUpdate(std::vector<std::string> const &from,
+                                 std::vector<std::string> const &to,
+                                 int rounds,
+                                 size_t &changes)
+    {
+        std::chrono::steady_clock::duration total{};
+        for (int round = 0; round < rounds; ++round) {
+            AppKeyTracker tracker;
+            if (!from.empty()) {
+                tracker.Update(from);
+            }
+
+            auto next = to;
+            auto const start = std::chrono::steady_clock::now();
+            changes = tracker.Update(std::move(next)).size();
+            total += std::chrono::steady_clock::now() - start;
+        }
+        return std::chrono::duration<double, std::milli>(total).count() / rounds;
+    }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    auto const maxKeys = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    auto const rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::printf("%d rounds, times in ms (changes reported)\n", rounds);
+    std::printf("%8s %18s %18s %18s %18s %18s\n",
+                "keys",
+                "initial",
+                "unchanged",
+                "1 insert",
+                "1% replaced",
+                "reordered");
+
+    std::mt19937 random{1};
+    for (unsigned long count = 10000; count <= maxKeys; count *= 10) {
+        auto const appKeys = MakeAppKeys(count, "Component");
+
+        auto inserted = appKeys;
+        inserted.insert(inserted.begin() + count / 2, "NewComponent");
+
+        auto replaced = appKeys;
+        auto const replacements = MakeAppKeys(count / 100, "Replacement");
+        for (size_t i = 0; i < replacements.size(); ++i) {
+            replaced[random() % count] = replacements[i];
+        }
+
+        auto reordered = appKeys;
+        std::swap(reordered.front(), reordered.back());
+
+        using AppKeys = std::vector<std::string>;
+        using Update = std::pair<AppKeys const *, AppKeys const *>;
+        std::vector<std::string> const none;
+        std::printf("%8lu", count);
+        for (auto &&[from, to] : {Update{&none, &appKeys},
+                                  Update{&appKeys, &appKeys},
+                                  Update{&appKeys, &inserted},
+                                  Update{&appKeys, &replaced},
+                                  Update{&appKeys, &reordered}}) {
+            size_t changes = 0;
+            auto const elapsed = MillisecondsPerUpdate(*from, *to, rounds, changes);
+            std::printf(" %9.2f (%6zu)", elapsed, changes);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
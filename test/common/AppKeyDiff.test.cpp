@@ -0,0 +1,140 @@
+#include "AppKeyDiff.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+
+using ReactTestApp::AppKeyChange;
+using ReactTestApp::AppKeyTracker;
+
+namespace
+{
+    using AppKeys = std::vector<std::string>;
+
+    // Applies changes the way a host would update its component list
+    bool Apply(AppKeys &appKeys, std::vector<AppKeyChange> const &changes)
+    {
+        for (auto &&change : changes) {
+            if (change.kind == AppKeyChange::Kind::Remove) {
+                if (change.index >= appKeys.size() || appKeys[change.index] != change.appKey) {
+                    return false;
+                }
+                appKeys.erase(appKeys.begin() + change.index);
+            } else {
+                if (change.index > appKeys.size()) {
+                    return false;
+                }
+                appKeys.insert(appKeys.begin() + change.index, change.appKey);
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+TEST(FirstUpdateInsertsEveryKey)
+{
+    AppKeyTracker tracker;
+    auto const changes = tracker.Update({"Example", "Settings"});
+    EXPECT(changes.size() == 2);
+    EXPECT(changes[0].kind == AppKeyChange::Kind::Insert && changes[0].index == 0 &&
+           changes[0].appKey == "Example");
+    EXPECT(changes[1].kind == AppKeyChange::Kind::Insert && changes[1].index == 1 &&
+           changes[1].appKey == "Settings");
+    EXPECT((tracker.AppKeys() == AppKeys{"Example", "Settings"}));
+}
+
+TEST(UnchangedKeysProduceNoChanges)
+{
+    AppKeyTracker tracker;
+    tracker.Update({"a", "b", "c"});
+    EXPECT(tracker.Update({"a", "b", "c"}).empty());
+    EXPECT((tracker.AppKeys() == AppKeys{"a", "b", "c"}));
+}
+
+TEST(ReplacedKeyIsRemovedThenInserted)
+{
+    AppKeyTracker tracker;
+    tracker.Update({"a", "b", "c"});
+
+    auto const changes = tracker.Update({"a", "x", "c"});
+    EXPECT(changes.size() == 2);
+    EXPECT(changes[0].kind == AppKeyChange::Kind::Remove && changes[0].index == 1 &&
+           changes[0].appKey == "b");
+    EXPECT(changes[1].kind == AppKeyChange::Kind::Insert && changes[1].index == 1 &&
+           changes[1].appKey == "x");
+}
+
+TEST(RemovalsComeFirstFromTheHighestIndexDown)
+{
+    AppKeyTracker tracker;
+    tracker.Update({"a", "b", "c", "d"});
+
+    auto const changes = tracker.Update({"b", "d", "e"});
+    EXPECT(changes.size() == 3);
+    EXPECT(changes[0].kind == AppKeyChange::Kind::Remove && changes[0].index == 2);
+    EXPECT(changes[1].kind == AppKeyChange::Kind::Remove && changes[1].index == 0);
+    EXPECT(changes[2].kind == AppKeyChange::Kind::Insert && changes[2].index == 2);
+}
+
+TEST(ReorderedKeysAreAllReplaced)
+{
+    AppKeyTracker tracker;
+    tracker.Update({"a", "b", "c"});
+
+    auto const changes = tracker.Update({"c", "b", "a"});
+    EXPECT(changes.size() == 6);
+    EXPECT(std::count_if(changes.begin(), changes.end(), [](AppKeyChange const &change) {
+               return change.kind == AppKeyChange::Kind::Remove;
+           }) == 3);
+
+    AppKeys appKeys{"a", "b", "c"};
+    EXPECT(Apply(appKeys, changes));
+    EXPECT((appKeys == AppKeys{"c", "b", "a"}));
+}
+
+TEST(ChangesTurnThePreviousKeysIntoTheNewOnes)
+{
+    // Random edits, including duplicate keys, reordering and clearing the
+    // list, must always produce changes that apply cleanly
+    std::mt19937 rng{7};
+    for (int run = 0; run < 2000; ++run) {
+        AppKeyTracker tracker;
+        AppKeys previous;
+        for (int step = 0; step < 6; ++step) {
+            AppKeys pool;
+            for (int i = 0; i < 12; ++i) {
+                pool.push_back("Key" + std::to_string(i % 9));
+            }
+            std::shuffle(pool.begin(), pool.end(), rng);
+
+            AppKeys next;
+            if (previous.empty() || rng() % 3 == 0) {
+                next.assign(pool.begin(), pool.begin() + rng() % 10);
+            } else {
+                next = previous;
+                if (rng() % 2 == 0) {
+                    next.erase(next.begin() + rng() % next.size());
+                }
+                for (auto &&appKey : pool) {
+                    if (std::find(next.begin(), next.end(), appKey) == next.end() &&
+                        rng() % 4 == 0) {
+                        next.insert(next.begin() + rng() % (next.size() + 1), appKey);
+                    }
+                }
+            }
+
+            auto const changes = tracker.Update(next);
+            EXPECT(next != previous || changes.empty());
+
+            auto appKeys = previous;
+            EXPECT(Apply(appKeys, changes));
+            EXPECT(appKeys == next);
+            EXPECT(tracker.AppKeys() == next);
+
+            previous = std::move(next);
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#include "BundleDelta.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "BundleDeltaWriter.h"
+#include "Test.h"
+
+using ReactTestApp::ApplyBundleDelta;
+using ReactTestApp::BundleHasher;
+using ReactTestApp::HashBundle;
+using ReactTestApp::Test::BundleDeltaWriter;
+
+namespace
+{
+    std::string MakeBundle(int modules, int revision)
+    {
+        std::string bundle = "var __BUNDLE_START_TIME__=Date.now();\n";
+        for (int i = 0; i < modules; ++i) {
+            auto const version = i % 7 == 0 ? revision : 0;
+            bundle += "__d(function(g,r,i,a,m,e,d){m.exports=" + std::to_string(i * 31 + version) +
+                      ";}," + std::to_string(i) + ");\n";
+        }
+        bundle += "__r(0);";
+        return bundle;
+    }
+
+    template <typename F>
+    std::string ErrorFrom(F &&f)
+    {
+        try {
+            f();
+        } catch (std::runtime_error const &e) {
+            return e.what();
+        }
+        return {};
+    }
+}  // namespace
+
+TEST(HashIsIndependentOfChunking)
+{
+    auto const bundle = MakeBundle(100, 1);
+    auto const expected = HashBundle(bundle);
+
+    for (size_t chunkSize : {1, 3, 7, 8, 9, 64, 4096}) {
+        BundleHasher hasher;
+        for (size_t offset = 0; offset < bundle.size(); offset += chunkSize) {
+            hasher.Update(std::string_view{bundle}.substr(offset, chunkSize));
+        }
+        EXPECT(hasher.Digest() == expected);
+    }
+
+    EXPECT(HashBundle("") == BundleHasher{}.Digest());
+    EXPECT(HashBundle("a") != HashBundle("b"));
+    EXPECT(HashBundle("12345678") != HashBundle("123456789"));
+}
+
+TEST(DeltaRebuildsTheNewBundle)
+{
+    auto const base = MakeBundle(1000, 1);
+    auto const target = MakeBundle(1000, 2);
+    auto const delta = BundleDeltaWriter::Diff(base, target);
+
+    // Only the changed modules are sent
+    EXPECT(delta.size() < target.size() / 4);
+    EXPECT(ApplyBundleDelta(base, delta) == target);
+}
+
+TEST(DeltaCanAddAndRemoveModules)
+{
+    auto const base = MakeBundle(200, 1);
+    auto const larger = MakeBundle(300, 1);
+    auto const smaller = MakeBundle(100, 1);
+    EXPECT(ApplyBundleDelta(base, BundleDeltaWriter::Diff(base, larger)) == larger);
+    EXPECT(ApplyBundleDelta(base, BundleDeltaWriter::Diff(base, smaller)) == smaller);
+    EXPECT(ApplyBundleDelta("", BundleDeltaWriter::Diff("", "x")) == "x");
+    EXPECT(ApplyBundleDelta(base, BundleDeltaWriter::Diff(base, "")).empty());
+}
+
+TEST(DeltaMustMatchTheBase)
+{
+    auto const base = MakeBundle(10, 1);
+    auto const target = MakeBundle(10, 2);
+    auto const delta = BundleDeltaWriter::Diff(base, target);
+    EXPECT(ErrorFrom([&] { ApplyBundleDelta(target, delta); }) ==
+           "Bundle delta was made against a different bundle");
+    EXPECT(ErrorFrom([&] { ApplyBundleDelta(base, "RNTADLT2" + delta.substr(8)); }) ==
+           "Not a bundle delta");
+}
+
+TEST(MalformedDeltasAreRejected)
+{
+    std::string const base = "0123456789";
+    auto const baseHash = HashBundle(base);
+
+    // Truncated anywhere
+    auto const delta = BundleDeltaWriter::Diff(base, "0123abc");
+    for (size_t size = 0; size < delta.size(); ++size) {
+        EXPECT(!ErrorFrom([&] { ApplyBundleDelta(base, delta.substr(0, size)); }).empty());
+    }
+
+    // Copies past the end of the base, including offsets that would overflow
+    EXPECT(ErrorFrom([&] {
+               ApplyBundleDelta(base, BundleDeltaWriter{baseHash, 0, 4}.Copy(8, 4).Delta());
+           }) == "Bundle delta copies past the end of the bundle");
+    EXPECT(ErrorFrom([&] {
+               ApplyBundleDelta(base, BundleDeltaWriter{baseHash, 0, 4}.Copy(~0ull, 4).Delta());
+           }) == "Bundle delta copies past the end of the bundle");
+
+    // Varints longer than 64 bits
+    auto const longVarint = "\x01" + std::string(10, '\xff');
+    EXPECT(ErrorFrom([&] {
+               ApplyBundleDelta(base, BundleDeltaWriter{baseHash, 0, 4}.Raw(longVarint).Delta());
+           }) == "Bundle delta contains an invalid varint");
+
+    EXPECT(ErrorFrom([&] {
+               ApplyBundleDelta(base, BundleDeltaWriter{baseHash, 0, 4}.Raw("\x03").Delta());
+           }) == "Bundle delta contains an unknown instruction");
+
+    // A huge declared size must not be trusted for allocation
+    EXPECT(ErrorFrom([&] {
+               ApplyBundleDelta(base, BundleDeltaWriter{baseHash, 0, ~0ull}.Copy(0, 4).Delta());
+           }) == "Bundle delta did not produce the expected bundle");
+
+    EXPECT(ErrorFrom([&] {
+               ApplyBundleDelta(base, BundleDeltaWriter{baseHash, 0, 2}.Copy(0, 6).Delta());
+           }) == "Bundle delta produces too many bytes");
+
+    EXPECT(ErrorFrom([&] {
+               ApplyBundleDelta(base, BundleDeltaWriter{baseHash, 0, 4}.Copy(0, 4).Delta());
+           }) == "Bundle delta did not produce the expected bundle");
+}
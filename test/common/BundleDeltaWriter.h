@@ -0,0 +1,140 @@
+#ifndef TEST_COMMON_BUNDLEDELTAWRITER_
+#define TEST_COMMON_BUNDLEDELTAWRITER_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "BundleDelta.h"
+
+namespace ReactTestApp::Test
+{
+    /**
+     * Writes bundle deltas in the format read by `ApplyBundleDelta`. Only
+     * tests need to write them; the bundler middleware is not part of this
+     * repository.
+     */
+    class BundleDeltaWriter
+    {
+    public:
+        BundleDeltaWriter(uint64_t baseHash, uint64_t targetHash, uint64_t targetSize)
+        {
+            delta_ = "RNTADLT1";
+            Fixed64(baseHash);
+            Fixed64(targetHash);
+            Varint(targetSize);
+        }
+
+        BundleDeltaWriter(std::string_view base, std::string_view target)
+            : BundleDeltaWriter(HashBundle(base), HashBundle(target), target.size())
+        {
+        }
+
+        BundleDeltaWriter &Copy(uint64_t offset, uint64_t length)
+        {
+            delta_ += '\x01';
+            Varint(offset);
+            Varint(length);
+            return *this;
+        }
+
+        BundleDeltaWriter &Insert(std::string_view bytes)
+        {
+            delta_ += '\x02';
+            Varint(bytes.size());
+            delta_ += bytes;
+            return *this;
+        }
+
+        BundleDeltaWriter &Raw(std::string_view bytes)
+        {
+            delta_ += bytes;
+            return *this;
+        }
+
+        std::string const &Delta() const
+        {
+            return delta_;
+        }
+
+        /**
+         * Returns a delta that copies every line of `target` that also occurs
+         * in `base`, the way a bundler would reuse unchanged modules.
+         */
+        static std::string Diff(std::string_view base, std::string_view target)
+        {
+            std::unordered_map<std::string_view, size_t> lines;
+            ForEachLine(base, [&lines](std::string_view line, size_t offset) {
+                lines.emplace(line, offset);
+            });
+
+            BundleDeltaWriter writer{base, target};
+            size_t copyOffset = 0;
+            size_t copyLength = 0;
+            std::string insert;
+            auto flush = [&]() {
+                if (copyLength > 0) {
+                    writer.Copy(copyOffset, copyLength);
+                    copyLength = 0;
+                }
+                if (!insert.empty()) {
+                    writer.Insert(insert);
+                    insert.clear();
+                }
+            };
+
+            ForEachLine(target, [&](std::string_view line, size_t) {
+                auto match = lines.find(line);
+                if (match == lines.end()) {
+                    if (copyLength > 0) {
+                        flush();
+                    }
+                    insert += line;
+                } else if (copyLength > 0 && copyOffset + copyLength == match->second) {
+                    copyLength += line.size();
+                } else {
+                    flush();
+                    copyOffset = match->second;
+                    copyLength = line.size();
+                }
+            });
+            flush();
+            return writer.Delta();
+        }
+
+    private:
+        std::string delta_;
+
+        template <typename F>
+        static void ForEachLine(std::string_view text, F &&f)
+        {
+            size_t offset = 0;
+            while (offset < text.size()) {
+                auto end = text.find('\n', offset);
+                end = end == std::string_view::npos ? text.size() : end + 1;
+                f(text.substr(offset, end - offset), offset);
+                offset = end;
+            }
+        }
+
+        void Fixed64(uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i) {
+                delta_ += static_cast<char>(value & 0xff);
+                value >>= 8;
+            }
+        }
+
+        void Varint(uint64_t value)
+        {
+            while (value >= 0x80) {
+                delta_ += static_cast<char>((value & 0x7f) | 0x80);
+                value >>= 7;
+            }
+            delta_ += static_cast<char>(value);
+        }
+    };
+}  // namespace ReactTestApp::Test
+
+#endif  // TEST_COMMON_BUNDLEDELTAWRITER_
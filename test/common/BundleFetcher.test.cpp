@@ -0,0 +1,355 @@
+#include "BundleFetcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "BundleDelta.h"
+#include "BundleDeltaWriter.h"
+#include "Test.h"
+
+using ReactTestApp::BundleFetcher;
+using ReactTestApp::BundleFetchResult;
+using ReactTestApp::HashBundle;
+using ReactTestApp::Test::BundleDeltaWriter;
+
+namespace
+{
+    constexpr char kBundlePath[] = "/index.bundle?platform=windows&dev=true";
+
+    std::string MakeBundle(int modules, int revision)
+    {
+        std::string bundle = "var __BUNDLE_START_TIME__=Date.now();\n";
+        for (int i = 0; i < modules; ++i) {
+            bundle += "__d(function(g,r,i,a,m,e,d){m.exports=\"" + std::string(40, 'a' + i % 26) +
+                      "\";}," + std::to_string(i) + ");\n";
+        }
+        bundle += "__d(function(){/* revision " + std::to_string(revision) + " */}," +
+                  std::to_string(modules) + ");\n__r(0);\n";
+        return bundle;
+    }
+
+    /**
+     * Serves bundles over HTTP on a loopback port, one connection at a time,
+     * the way a bundler with a delta middleware would.
+     */
+    class StandInBundler
+    {
+    public:
+        // Settings are only changed between fetches
+        bool serveDeltas = true;
+        bool corruptDeltas = false;
+        bool chunked = false;
+        size_t writeSize = 0;
+
+        StandInBundler()
+        {
+            listener_ = socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            bind(listener_, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+            listen(listener_, 8);
+
+            socklen_t length = sizeof(address);
+            getsockname(listener_, reinterpret_cast<sockaddr *>(&address), &length);
+            port_ = ntohs(address.sin_port);
+
+            thread_ = std::thread([this, listener = listener_]() {
+                while (true) {
+                    auto connection = accept(listener, nullptr, nullptr);
+                    if (connection < 0) {
+                        return;
+                    }
+                    Serve(connection);
+                    close(connection);
+                }
+            });
+        }
+
+        ~StandInBundler()
+        {
+            Stop();
+        }
+
+        uint16_t Port() const
+        {
+            return port_;
+        }
+
+        int Requests() const
+        {
+            return requests_;
+        }
+
+        std::string const &Current() const
+        {
+            return current_;
+        }
+
+        void Publish(std::string bundle)
+        {
+            versions_[HashBundle(bundle)] = bundle;
+            current_ = std::move(bundle);
+        }
+
+        void Forget()
+        {
+            versions_.clear();
+            versions_[HashBundle(current_)] = current_;
+        }
+
+        void Stop()
+        {
+            if (listener_ >= 0) {
+                // Wakes up `accept`; the socket is closed once the thread is
+                // done with it
+                shutdown(listener_, SHUT_RDWR);
+                thread_.join();
+                close(listener_);
+                listener_ = -1;
+            }
+        }
+
+    private:
+        int listener_ = -1;
+        uint16_t port_ = 0;
+        std::thread thread_;
+        std::atomic<int> requests_{0};
+        std::map<uint64_t, std::string> versions_;
+        std::string current_;
+
+        void Serve(int connection)
+        {
+            ++requests_;
+
+            std::string request;
+            char buffer[4096];
+            while (request.find("\r\n\r\n") == std::string::npos) {
+                auto n = read(connection, buffer, sizeof(buffer));
+                if (n <= 0) {
+                    return;
+                }
+                request.append(buffer, static_cast<size_t>(n));
+            }
+
+            int status = 200;
+            std::string contentType = "application/javascript";
+            std::string body = current_;
+            auto base = request.find("X-Bundle-Base: ");
+            if (serveDeltas && base != std::string::npos) {
+                auto hash = std::stoull(request.substr(base + 15, 16), nullptr, 16);
+                if (hash == HashBundle(current_)) {
+                    status = 304;
+                    body.clear();
+                } else if (auto previous = versions_.find(hash); previous != versions_.end()) {
+                    contentType = ReactTestApp::kBundleDeltaMediaType;
+                    body = BundleDeltaWriter::Diff(previous->second, current_);
+                    if (corruptDeltas) {
+                        body.back() ^= 1;
+                    }
+                }
+            }
+
+            std::string response = "HTTP/1.1 " + std::to_string(status) +
+                                   (status == 200 ? " OK" : " Not Modified") +
+                                   "\r\nContent-Type: " + contentType +
+                                   "; charset=UTF-8\r\nConnection: close\r\n";
+            if (status == 304) {
+                response += "\r\n";
+            } else if (chunked) {
+                response += "Transfer-Encoding: chunked\r\n\r\n";
+                for (size_t offset = 0; offset < body.size(); offset += 10000) {
+                    auto chunk = body.substr(offset, 10000);
+                    char size[32];
+                    std::snprintf(size, sizeof(size), "%zx\r\n", chunk.size());
+                    response += size + chunk + "\r\n";
+                }
+                response += "0\r\n\r\n";
+            } else {
+                response += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+            }
+
+            // Small writes split headers and chunk framing across reads
+            std::string_view remaining{response};
+            while (!remaining.empty()) {
+                auto size = writeSize == 0 ? remaining.size()
+                                           : std::min(writeSize, remaining.size());
+                auto n = send(connection, remaining.data(), size, MSG_NOSIGNAL);
+                if (n <= 0) {
+                    return;
+                }
+                remaining.remove_prefix(static_cast<size_t>(n));
+            }
+        }
+    };
+
+    template <typename F>
+    bool Throws(F &&f)
+    {
+        try {
+            f();
+        } catch (std::exception const &) {
+            return true;
+        }
+        return false;
+    }
+}  // namespace
+
+TEST(DeltaReloadIsOptIn)
+{
+    unsetenv("REACT_TEST_APP_DELTA_RELOAD");
+    EXPECT(!ReactTestApp::IsDeltaReloadEnabled());
+
+    setenv("REACT_TEST_APP_DELTA_RELOAD", "true", 1);
+    EXPECT(!ReactTestApp::IsDeltaReloadEnabled());
+
+    setenv("REACT_TEST_APP_DELTA_RELOAD", "1", 1);
+    EXPECT(ReactTestApp::IsDeltaReloadEnabled());
+
+    unsetenv("REACT_TEST_APP_DELTA_RELOAD");
+}
+
+TEST(LaterFetchesOnlyTransferDeltas)
+{
+    StandInBundler bundler;
+    bundler.Publish(MakeBundle(5000, 1));
+    BundleFetcher fetcher{"localhost", bundler.Port(), kBundlePath};
+
+    auto result = fetcher.Fetch();
+    EXPECT(result.kind == BundleFetchResult::Kind::Full);
+    EXPECT(result.bundle->View() == bundler.Current());
+    EXPECT(result.bytesTransferred == bundler.Current().size());
+
+    result = fetcher.Fetch();
+    EXPECT(result.kind == BundleFetchResult::Kind::Unchanged);
+    EXPECT(result.bundle->View() == bundler.Current());
+    EXPECT(result.bytesTransferred == 0);
+
+    bundler.Publish(MakeBundle(5000, 2));
+    result = fetcher.Fetch();
+    EXPECT(result.kind == BundleFetchResult::Kind::Delta);
+    EXPECT(result.bundle->View() == bundler.Current());
+    EXPECT(result.bytesTransferred < 200);
+    EXPECT(fetcher.ServesDeltas());
+
+    EXPECT(result.ToJSON().rfind("{\"kind\":\"delta\",\"bundleBytes\":" +
+                                     std::to_string(bundler.Current().size()) +
+                                     ",\"bytesTransferred\":",
+                                 0) == 0);
+}
+
+TEST(ResponsesArriveInSmallPieces)
+{
+    for (bool chunked : {false, true}) {
+        StandInBundler bundler;
+        bundler.chunked = chunked;
+        bundler.writeSize = 7;
+        bundler.Publish(MakeBundle(500, 1));
+        BundleFetcher fetcher{"127.0.0.1", bundler.Port(), kBundlePath};
+        EXPECT(fetcher.Fetch().bundle->View() == bundler.Current());
+
+        bundler.Publish(MakeBundle(500, 2));
+        auto result = fetcher.Fetch();
+        EXPECT(result.kind == BundleFetchResult::Kind::Delta);
+        EXPECT(result.bundle->View() == bundler.Current());
+
+        bundler.serveDeltas = false;
+        bundler.Publish(MakeBundle(600, 3));
+        EXPECT(fetcher.Fetch().bundle->View() == bundler.Current());
+    }
+}
+
+TEST(BundlerWithoutDeltasServesWholeBundles)
+{
+    // E.g. plain Metro
+    StandInBundler bundler;
+    bundler.serveDeltas = false;
+    bundler.Publish(MakeBundle(100, 1));
+    BundleFetcher fetcher{"localhost", bundler.Port(), kBundlePath};
+    fetcher.Fetch();
+    EXPECT(fetcher.ServesDeltas());
+
+    bundler.Publish(MakeBundle(100, 2));
+    auto result = fetcher.Fetch();
+    EXPECT(result.kind == BundleFetchResult::Kind::Full);
+    EXPECT(result.bundle->View() == bundler.Current());
+    EXPECT(!fetcher.ServesDeltas());
+}
+
+TEST(BadDeltasFallBackToWholeBundles)
+{
+    StandInBundler bundler;
+    bundler.Publish(MakeBundle(100, 1));
+    BundleFetcher fetcher{"localhost", bundler.Port(), kBundlePath};
+    fetcher.Fetch();
+
+    bundler.corruptDeltas = true;
+    bundler.Publish(MakeBundle(100, 2));
+    auto const requests = bundler.Requests();
+    auto result = fetcher.Fetch();
+    EXPECT(result.kind == BundleFetchResult::Kind::Full);
+    EXPECT(result.bundle->View() == bundler.Current());
+    EXPECT(result.bytesTransferred > bundler.Current().size());
+    EXPECT(bundler.Requests() == requests + 2);
+    bundler.corruptDeltas = false;
+
+    // A bundler that has served deltas before but lost the base, e.g. after
+    // a restart, still counts as serving them
+    bundler.Publish(MakeBundle(100, 3));
+    bundler.Forget();
+    result = fetcher.Fetch();
+    EXPECT(result.kind == BundleFetchResult::Kind::Full);
+    EXPECT(result.bundle->View() == bundler.Current());
+    EXPECT(fetcher.ServesDeltas());
+}
+
+TEST(FailedFetchesKeepThePreviousBundle)
+{
+    auto bundler = std::make_unique<StandInBundler>();
+    bundler->Publish(MakeBundle(100, 1));
+    auto const port = bundler->Port();
+    BundleFetcher fetcher{"localhost", port, kBundlePath};
+    auto const first = fetcher.Fetch().bundle;
+
+    bundler->Stop();
+    EXPECT(Throws([&] { fetcher.Fetch(); }));
+    EXPECT(first->View() == MakeBundle(100, 1));
+}
+
+TEST(TruncatedResponsesThrow)
+{
+    auto listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+    listen(listener, 1);
+    socklen_t length = sizeof(address);
+    getsockname(listener, reinterpret_cast<sockaddr *>(&address), &length);
+
+    std::thread server([listener]() {
+        auto connection = accept(listener, nullptr, nullptr);
+        char buffer[4096];
+        if (read(connection, buffer, sizeof(buffer)) > 0) {
+            std::string_view response = "HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\nshort";
+            send(connection, response.data(), response.size(), MSG_NOSIGNAL);
+        }
+        close(connection);
+    });
+
+    BundleFetcher fetcher{"127.0.0.1", ntohs(address.sin_port), kBundlePath};
+    EXPECT(Throws([&] { fetcher.Fetch(); }));
+    server.join();
+    close(listener);
+}
@@ -0,0 +1,85 @@
+// Measures the per-call overhead `CallStats` adds to native module calls as
+// the number of calling threads grows. Every thread records calls spread over
+// a handful of interned methods, like the JS and native module threads do.
+// The histogram-only column is the floor: what recording the latency alone
+// costs without the per-thread shard lookup and counters.
+//
+// Usage: CallStatsBenchmark [calls per thread] [max threads]
+
+#include "CallStats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Histogram.h"
+
+using ReactTestApp::CallStats;
+using ReactTestApp::Histogram;
+
+namespace
+{
+    constexpr CallStats::MethodId kMethods = 16;
+
+    template <typename Body>
+    double NanosecondsPerCall(unsigned long threadCount, unsigned long calls, Body body)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned long i = 0; i < threadCount; ++i) {
+            threads.emplace_back([&body, calls, i] {
+                for (unsigned long j = 0; j < calls; ++j) {
+                    body(i, j);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        std::chrono::duration<double, std::nano> const elapsed =
+            std::chrono::steady_clock::now() - start;
+        return elapsed.count() / calls;
+    }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    auto const calls = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    auto const maxThreads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+
+    std::printf("%lu hardware threads, %lu calls per thread\n",
+                static_cast<unsigned long>(std::thread::hardware_concurrency()),
+                calls);
+    std::printf("%8s %16s %16s %10s\n", "threads", "RecordCall (ns)", "histogram (ns)", "dropped");
+
+    for (unsigned long threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        CallStats stats;
+        std::vector<CallStats::MethodId> ids;
+        for (CallStats::MethodId i = 0; i < kMethods; ++i) {
+            ids.push_back(stats.Intern("Module", "method" + std::to_string(i)));
+        }
+
+        auto const recordCall =
+            NanosecondsPerCall(threadCount, calls, [&stats, &ids](auto, auto j) {
+                stats.RecordCall(ids[j % kMethods], 64, std::chrono::nanoseconds{j & 0xffff});
+            });
+
+        // `Histogram` takes a single writer, so give each thread its own
+        std::vector<Histogram> histograms(threadCount);
+        auto const histogramOnly =
+            NanosecondsPerCall(threadCount, calls, [&histograms](auto i, auto j) {
+                histograms[i].Record(j & 0xffff);
+            });
+
+        std::printf("%8lu %16.1f %16.1f %10llu\n",
+                    threadCount,
+                    recordCall,
+                    histogramOnly,
+                    static_cast<unsigned long long>(stats.Dropped()));
+    }
+
+    return 0;
+}
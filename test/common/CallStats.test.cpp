@@ -0,0 +1,179 @@
+#include "CallStats.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "Histogram.h"
+#include "Test.h"
+
+using ReactTestApp::CallStats;
+using ReactTestApp::Histogram;
+using ReactTestApp::HistogramBuckets;
+using ReactTestApp::HistogramSnapshot;
+
+namespace
+{
+    HistogramSnapshot Record(std::initializer_list<uint64_t> values)
+    {
+        Histogram histogram;
+        for (auto value : values) {
+            histogram.Record(value);
+        }
+        return histogram.Snapshot();
+    }
+}  // namespace
+
+TEST(SmallValuesHaveABucketEach)
+{
+    for (uint64_t value = 0; value < 8; ++value) {
+        auto index = HistogramBuckets::IndexOf(value);
+        EXPECT(index == value);
+        EXPECT(HistogramBuckets::LowerBound(index) == value);
+        EXPECT(HistogramBuckets::UpperBound(index) == value);
+    }
+}
+
+TEST(BucketBoundariesFollowPowersOfTwo)
+{
+    // Each power of two is split into 8 buckets
+    EXPECT(HistogramBuckets::IndexOf(8) == 8);
+    EXPECT(HistogramBuckets::IndexOf(15) == 15);
+    EXPECT(HistogramBuckets::IndexOf(16) == 16);
+    EXPECT(HistogramBuckets::IndexOf(17) == 16);
+    EXPECT(HistogramBuckets::IndexOf(18) == 17);
+    EXPECT(HistogramBuckets::LowerBound(16) == 16);
+    EXPECT(HistogramBuckets::UpperBound(16) == 17);
+    EXPECT(HistogramBuckets::LowerBound(24) == 32);
+    EXPECT(HistogramBuckets::UpperBound(23) == 31);
+
+    for (uint64_t value = 1; value < (uint64_t{1} << 40); value = value * 3 / 2 + 1) {
+        auto index = HistogramBuckets::IndexOf(value);
+        auto lower = HistogramBuckets::LowerBound(index);
+        auto upper = HistogramBuckets::UpperBound(index);
+        EXPECT(lower <= value && value <= upper);
+        EXPECT(upper - lower <= lower / 8);
+        EXPECT(HistogramBuckets::IndexOf(upper + 1) == index + 1);
+    }
+}
+
+TEST(HugeValuesGoToTheLastBucket)
+{
+    auto const last = HistogramBuckets::kCount - 1;
+    EXPECT(HistogramBuckets::IndexOf(uint64_t{1} << 48) == last);
+    EXPECT(HistogramBuckets::IndexOf(~uint64_t{0}) == last);
+    EXPECT(HistogramBuckets::UpperBound(last) == ~uint64_t{0});
+}
+
+TEST(PercentilesAreUpperBoundsWithinABucket)
+{
+    Histogram histogram;
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        histogram.Record(value);
+    }
+
+    auto snapshot = histogram.Snapshot();
+    EXPECT(snapshot.count == 1000);
+    EXPECT(snapshot.min == 1 && snapshot.max == 1000);
+    EXPECT(snapshot.Mean() == 500.5);
+
+    for (auto percentile : {1.0, 10.0, 50.0, 90.0, 99.0}) {
+        auto const exact = static_cast<uint64_t>(percentile * 10);
+        auto const value = snapshot.Percentile(percentile);
+        EXPECT(value >= exact);
+        EXPECT(value - exact <= exact / 8);
+    }
+
+    // Percentiles never leave the recorded range
+    EXPECT(snapshot.Percentile(0) == 1);
+    EXPECT(snapshot.Percentile(100) == 1000);
+    EXPECT(snapshot.Percentile(150) == 1000);
+}
+
+TEST(PercentilesOfSkewedValues)
+{
+    auto snapshot = Record({5, 5, 5, 5, 5, 5, 5, 5, 5, 1000000});
+    EXPECT(snapshot.Percentile(50) == 5);
+    EXPECT(snapshot.Percentile(90) == 5);
+    EXPECT(snapshot.Percentile(99) == 1000000);
+
+    EXPECT(HistogramSnapshot{}.Percentile(50) == 0);
+}
+
+TEST(SnapshotsMerge)
+{
+    auto snapshot = Record({1, 2, 3});
+    snapshot.Merge(Record({100, 200}));
+    EXPECT(snapshot.count == 5);
+    EXPECT(snapshot.sum == 306);
+    EXPECT(snapshot.min == 1 && snapshot.max == 200);
+    EXPECT(snapshot.Percentile(50) == 3);
+
+    std::string json;
+    Record({}).AppendJSON(json);
+    EXPECT(json == R"({"count":0,"min":0,"max":0,"mean":0,"p50":0,"p90":0,"p99":0})");
+}
+
+TEST(MethodsAreInternedOnce)
+{
+    CallStats stats;
+    auto const get = stats.Intern("Storage", "get");
+    auto const set = stats.Intern("Storage", "set");
+    EXPECT(get != set);
+    EXPECT(stats.Intern("Storage", "get") == get);
+    EXPECT(stats.Intern("Other", "get") != get);
+}
+
+TEST(CallsAreAggregatedAcrossThreads)
+{
+    CallStats stats;
+    auto const get = stats.Intern("Storage", "get");
+    auto const unused = stats.Intern("Storage", "unused");
+
+    std::thread thread([&stats, get] {
+        for (int i = 0; i < 100; ++i) {
+            stats.RecordCall(get, 10, std::chrono::nanoseconds{1000});
+        }
+    });
+    for (int i = 0; i < 50; ++i) {
+        stats.RecordCall(get, 4, std::chrono::nanoseconds{10});
+    }
+    stats.RecordAsync(get, std::chrono::nanoseconds{5000});
+    thread.join();
+
+    auto summaries = stats.Collect();
+    EXPECT(summaries.size() == 2);
+
+    auto &summary = summaries[get];
+    EXPECT(summary.module == "Storage" && summary.method == "get");
+    EXPECT(summary.calls == 150);
+    EXPECT(summary.argumentBytes == 1200);
+    EXPECT(summary.syncLatency.count == 150);
+    EXPECT(summary.syncLatency.min == 10 && summary.syncLatency.max == 1000);
+    EXPECT(summary.syncLatency.Percentile(33) == 10);
+    EXPECT(summary.syncLatency.Percentile(34) == 1000);
+    EXPECT(summary.asyncLatency.count == 1);
+    EXPECT(summaries[unused].calls == 0);
+
+    // Methods that were never called are left out
+    auto json = stats.DumpJSON();
+    EXPECT(json.rfind(R"({"Storage.get":{"calls":150,"argumentBytes":1200,"sync":{"count":150)",
+                      0) == 0);
+    EXPECT(json.find("unused") == std::string::npos);
+}
+
+TEST(CallsBeyondTheMethodLimitAreDropped)
+{
+    CallStats stats;
+    CallStats::MethodId id = 0;
+    for (CallStats::MethodId i = 0; i <= CallStats::kMaxMethods; ++i) {
+        id = stats.Intern("Module", "method" + std::to_string(i));
+    }
+
+    EXPECT(id == CallStats::kMaxMethods);
+    stats.RecordCall(id, 0, std::chrono::nanoseconds{1});
+    stats.RecordCall(id, 0, std::chrono::nanoseconds{1});
+    stats.RecordAsync(id, std::chrono::nanoseconds{1});
+    EXPECT(stats.Dropped() == 2);
+    EXPECT(stats.DumpJSON() == "{}");
+}
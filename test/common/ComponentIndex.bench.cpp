@@ -0,0 +1,137 @@
+// Measures how long it takes to build a `ComponentIndex` over a large
+// manifest, and how long searches take as the user types, compared with
+// scanning every name on each keystroke. Names are made up of a few words
+// from a small vocabulary, so that short queries match many components like
+// they do in real manifests.
+//
+// The scan stops at the first `kMaxResults` matches and does not rank them,
+// so it is only competitive for queries that match a lot of components; the
+// index has to rank every candidate to return the best ones first.
+//
+// Usage: ComponentIndexBenchmark [components] [rounds]
+
+#include "ComponentIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ReactTestApp::ComponentIndex;
+
+namespace
+{
+    // Same cap as the search dialog on Windows
+    constexpr size_t kMaxResults = 100;
+
+    constexpr char const *kWords[] = {
+        "Account", "Banner",  "Button",  "Camera", "Chart",  "Checkout", "Dialog", "Feed",
+        "Gallery", "Header",  "Image",   "List",   "Login",  "Map",      "Menu",   "Modal",
+        "Picker",  "Profile", "Search",  "Slider", "Switch", "Tab",      "Text",   "Video",
+    };
+
+    std::vector<ComponentIndex::Entry> MakeEntries(size_t count)
+    {
+        std::mt19937 random{1};
+        std::vector<ComponentIndex::Entry> entries;
+        entries.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            std::string appKey;
+            std::string displayName;
+            for (int j = 0; j < 3; ++j) {
+                auto word = kWords[random() % std::size(kWords)];
+                appKey += word;
+                displayName += word;
+                displayName += ' ';
+            }
+            appKey += std::to_string(i);
+            displayName += std::to_string(i);
+
+            std::string slug;
+            for (auto c : displayName) {
+                slug += c == ' ' ? '-' : static_cast<char>(std::tolower(c));
+            }
+
+            entries.push_back({std::move(appKey), std::move(displayName), std::move(slug)});
+        }
+        return entries;
+    }
+
+    bool ContainsFolded(std::string const &text, std::string const &query)
+    {
+        auto const equal = [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == b;
+        };
+        return std::search(text.begin(), text.end(), query.begin(), query.end(), equal) !=
+               text.end();
+    }
+
+    // Checks every name on every keystroke, which is what the index avoids
+    std::vector<size_t> Scan(std::vector<ComponentIndex::Entry> const &entries,
+                             std::string const &query)
+    {
+        std::vector<size_t> results;
+        for (size_t i = 0; i < entries.size() && results.size() < kMaxResults; ++i) {
+            auto &entry = entries[i];
+            if (ContainsFolded(entry.appKey, query) || ContainsFolded(entry.displayName, query) ||
+                ContainsFolded(entry.slug, query)) {
+                results.push_back(i);
+            }
+        }
+        return results;
+    }
+
+    template <typename Search>
+    double MicrosecondsPerSearch(int rounds, size_t &results, Search const &search)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            results = search().size();
+        }
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count() / rounds;
+    }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    auto const count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    auto const rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    auto entries = MakeEntries(count);
+    auto copy = entries;
+
+    auto const start = std::chrono::steady_clock::now();
+    ComponentIndex index{std::move(copy)};
+    auto const build = std::chrono::steady_clock::now() - start;
+
+    std::printf("%lu components, %d rounds\n", count, rounds);
+    std::printf("index built in %.1f ms\n\n",
+                std::chrono::duration<double, std::milli>(build).count());
+
+    // Typing "checkout" one character at a time, then a query that matches
+    // nothing and one that matches a single component
+    std::vector<std::string> queries;
+    for (size_t length = 1; length <= 8; ++length) {
+        queries.push_back(std::string{"checkout"}.substr(0, length));
+    }
+    queries.push_back("xyzzy");
+    queries.push_back(std::to_string(count / 2));
+
+    std::printf("%-12s %10s %14s %14s\n", "query", "results", "index (us)", "scan (us)");
+    for (auto &&query : queries) {
+        size_t found = 0;
+        size_t scanned = 0;
+        auto const indexed =
+            MicrosecondsPerSearch(rounds, found, [&] { return index.Search(query, kMaxResults); });
+        auto const scan =
+            MicrosecondsPerSearch(rounds, scanned, [&] { return Scan(entries, query); });
+        std::printf("%-12s %10zu %14.1f %14.1f\n", query.c_str(), found, indexed, scan);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "ComponentIndex.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Test.h"
+
+using ReactTestApp::ComponentIndex;
+
+namespace
+{
+    using Indices = std::vector<size_t>;
+
+    ComponentIndex MakeIndex()
+    {
+        return ComponentIndex{{
+            {"Example", "App", "example"},
+            {"ExampleTwo", "Second Example", "two"},
+            {"MyButton", "Button Playground", "button"},
+            {"listView", "Long List", "long-list"},
+            {"Settings", "", ""},
+            {"ButtonGroup", "", "grp"},
+        }};
+    }
+}  // namespace
+
+TEST(EmptyQueryReturnsEntriesInManifestOrder)
+{
+    auto const index = MakeIndex();
+    EXPECT(index.Size() == 6);
+    EXPECT((index.Search("", 10) == Indices{0, 1, 2, 3, 4, 5}));
+    EXPECT((index.Search("  ", 2) == Indices{0, 1}));
+}
+
+TEST(ExactMatchesRankBeforePrefixMatches)
+{
+    auto const index = MakeIndex();
+    EXPECT((index.Search("example", 10) == Indices{0, 1}));
+    EXPECT((index.Search("button", 10) == Indices{2, 5}));
+    EXPECT((index.Search("e", 1) == Indices{0}));
+}
+
+TEST(MatchingIgnoresCaseAndSurroundingSpaces)
+{
+    auto const index = MakeIndex();
+    EXPECT((index.Search("EXAMPLE", 10) == Indices{0, 1}));
+    EXPECT((index.Search("  but ", 10) == Indices{2, 5}));
+}
+
+TEST(ShortQueriesOnlyMatchWordPrefixes)
+{
+    auto const index = MakeIndex();
+    EXPECT((index.Search("b", 10) == Indices{2, 5}));
+    EXPECT((index.Search("vi", 10) == Indices{3}));
+    EXPECT(index.Search("xa", 10).empty());
+}
+
+TEST(LongerQueriesMatchAnywhere)
+{
+    auto const index = MakeIndex();
+    EXPECT((index.Search("ist", 10) == Indices{3}));
+    EXPECT((index.Search("long l", 10) == Indices{3}));
+    EXPECT((index.Search("playground", 10) == Indices{2}));
+    EXPECT(index.Search("zzz", 10).empty());
+}
+
+TEST(EachEntryIsReturnedOnce)
+{
+    // "list" matches the app key, display name and slug of the same entry
+    auto const index = MakeIndex();
+    EXPECT((index.Search("list", 10) == Indices{3}));
+}
+
+TEST(ResultsAreLimited)
+{
+    std::vector<ComponentIndex::Entry> entries;
+    for (int i = 0; i < 1000; ++i) {
+        auto const n = std::to_string(i);
+        entries.push_back({"Screen" + n, "Screen " + n, "screen-" + n});
+    }
+
+    ComponentIndex index{std::move(entries)};
+    auto const results = index.Search("screen", 50);
+    EXPECT(results.size() == 50);
+
+    // Ties are broken by length, then by manifest order
+    EXPECT((Indices{results.begin(), results.begin() + 3} == Indices{0, 1, 2}));
+    EXPECT(results[10] == 10);
+    EXPECT(index.Search("screen-999", 50) == Indices{999});
+    EXPECT(index.Search("screen", 0).empty());
+}
+
+TEST(EmptyAndMovedIndexes)
+{
+    ComponentIndex empty;
+    EXPECT(empty.Search("", 10).empty());
+    EXPECT(empty.Search("a", 10).empty());
+    EXPECT(empty.Search("abc", 10).empty());
+
+    auto index = MakeIndex();
+    ComponentIndex moved = std::move(index);
+    EXPECT((moved.Search("set", 10) == Indices{4}));
+}
@@ -0,0 +1,162 @@
+#include "ComponentStore.h"
+
+#include <any>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Test.h"
+
+using ReactApp::Component;
+using ReactApp::JSONObject;
+using ReactTestApp::ComponentHandle;
+using ReactTestApp::ComponentStore;
+
+namespace
+{
+    std::atomic<size_t> gAllocations{0};
+
+    size_t Allocations()
+    {
+        return gAllocations.load(std::memory_order_relaxed);
+    }
+
+    std::vector<Component> MakeComponents()
+    {
+        std::vector<Component> components(3);
+        components[0].appKey = "Example";
+        components[0].initialProperties = JSONObject{{"concurrentRoot", true}};
+        components[1].appKey = "Settings";
+        components[1].displayName = "App Settings";
+        components[2].appKey = "Modal";
+        components[2].presentationStyle = "modal";
+        return components;
+    }
+}  // namespace
+
+// Counts every allocation in the test binary, so that tests can check that
+// the paths hosts take when listing and opening components do not allocate.
+// The replacements are kept out of line; once inlined, GCC sees `free()` on
+// memory from `new` and warns about a mismatch.
+[[gnu::noinline]] void *operator new(size_t size)
+{
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+TEST(EmptyStoreHasNoComponents)
+{
+    ComponentStore store;
+    EXPECT(store.Size() == 0);
+    EXPECT(store.begin() == store.end());
+}
+
+TEST(StoreKeepsManifestOrder)
+{
+    ComponentStore store{MakeComponents()};
+    EXPECT(store.Size() == 3);
+    EXPECT(store[0].appKey == "Example");
+    EXPECT(store[1].displayName == "App Settings");
+
+    std::vector<std::string_view> appKeys;
+    for (auto &&component : store) {
+        appKeys.push_back(component.appKey);
+    }
+    EXPECT((appKeys == std::vector<std::string_view>{"Example", "Settings", "Modal"}));
+}
+
+TEST(HandlesShareOwnershipOfTheStore)
+{
+    // Handles alias the store's storage rather than owning copies, so taking
+    // one only bumps the reference count
+    ComponentStore store{MakeComponents()};
+    auto handle = store.Handle(0);
+    auto other = store.Handle(1);
+    EXPECT(handle.get() == &store[0]);
+    EXPECT(other.get() == &store[1]);
+    EXPECT(handle.use_count() == 3);
+
+    auto copy = handle;
+    EXPECT(copy.use_count() == 4);
+    EXPECT(std::any_cast<bool>(copy->initialProperties->at("concurrentRoot")));
+}
+
+TEST(HandlesOutliveTheStore)
+{
+    ComponentHandle handle;
+    {
+        ComponentStore store{MakeComponents()};
+        handle = store.Handle(2);
+    }
+
+    EXPECT(handle->appKey == "Modal");
+    EXPECT(handle->presentationStyle == "modal");
+}
+
+TEST(HandlesOutliveReplacedAppKeys)
+{
+    // Components created from `AppRegistry` refer to keys owned by the store;
+    // a handle must keep them alive after the store has been replaced
+    std::vector<std::string> appKeys{std::string(64, 'a'), std::string(64, 'b')};
+    ComponentStore store{std::move(appKeys)};
+    auto handle = store.Handle(1);
+
+    store = ComponentStore{std::vector<std::string>{"Replacement"}};
+    EXPECT(store.Size() == 1);
+    EXPECT(store[0].appKey == "Replacement");
+    EXPECT(handle->appKey == std::string(64, 'b'));
+}
+
+TEST(CopiesShareComponents)
+{
+    ComponentStore store{MakeComponents()};
+    auto copy = store;
+    EXPECT(&copy[1] == &store[1]);
+}
+
+TEST(ListingAndOpeningComponentsDoesNotAllocate)
+{
+    ComponentStore store{MakeComponents()};
+
+    auto const before = Allocations();
+    size_t length = 0;
+    for (auto &&component : store) {
+        length += component.displayName ? component.displayName->size() : component.appKey.size();
+    }
+    auto handle = store.Handle(0);
+    auto copy = handle;
+    auto const after = Allocations();
+
+    EXPECT(length == 24);
+    EXPECT(copy->appKey == "Example");
+    EXPECT(after == before);
+}
+
+TEST(CopyingAComponentAllocates)
+{
+    // This is what handles replaced; it copies the initial properties
+    ComponentStore store{MakeComponents()};
+
+    auto const before = Allocations();
+    Component copy = store[0];
+    auto const after = Allocations();
+
+    EXPECT(copy.appKey == "Example");
+    EXPECT(after > before);
+}
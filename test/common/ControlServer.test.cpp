@@ -0,0 +1,189 @@
+#include "ControlServer.h"
+
+#include <chrono>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Test.h"
+
+using ReactTestApp::ControlRequest;
+using ReactTestApp::ControlResponse;
+using ReactTestApp::ControlServer;
+
+namespace
+{
+    std::string SocketPath(char const *name)
+    {
+        return "/tmp/rnta-control-" + std::to_string(getpid()) + "-" + name;
+    }
+
+    int Connect(std::string const &path)
+    {
+        auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    std::string ReadLine(int fd)
+    {
+        std::string line;
+        char c;
+        while (read(fd, &c, 1) == 1 && c != '\n') {
+            line += c;
+        }
+        return line;
+    }
+
+    void AddHandlers(ControlServer &server)
+    {
+        server.On("echo", [](ControlRequest const &request) {
+            return ControlResponse::Success("\"" + std::string{request.Param("value")} + "\"");
+        });
+        server.On("fail", [](ControlRequest const &) {
+            return ControlResponse::Failure("nope");
+        });
+    }
+}  // namespace
+
+TEST(EchoesNumericIds)
+{
+    ControlServer server{"unused"};
+    server.On("ping", [](ControlRequest const &) { return ControlResponse::Success(); });
+    EXPECT(server.HandleLine(R"({"id": 42, "command": "ping"})") ==
+           R"({"id":42,"ok":true,"result":null})");
+    EXPECT(server.HandleLine(R"({"id": -1.5, "command": "ping"})") ==
+           R"({"id":-1.5,"ok":true,"result":null})");
+}
+
+TEST(EchoesStringIdsAsStrings)
+{
+    ControlServer server{"unused"};
+    server.On("ping", [](ControlRequest const &) { return ControlResponse::Success(); });
+    EXPECT(server.HandleLine(R"({"id": "1abc", "command": "ping"})") ==
+           R"({"id":"1abc","ok":true,"result":null})");
+    EXPECT(server.HandleLine(R"({"id": "1\"},\"x\":{\"", "command": "ping"})") ==
+           R"({"id":"1\"},\"x\":{\"","ok":true,"result":null})");
+}
+
+TEST(RejectsInvalidIds)
+{
+    ControlServer server{"unused"};
+    EXPECT(server.HandleLine(R"({"id": 1abc, "command": "ping"})") ==
+           R"({"ok":false,"error":"Malformed request"})");
+}
+
+TEST(ReportsErrors)
+{
+    ControlServer server{"unused"};
+    AddHandlers(server);
+    EXPECT(server.HandleLine(R"({"id": 1})") == R"({"id":1,"ok":false,"error":"Missing command"})");
+    EXPECT(server.HandleLine(R"({"command": "x"})") ==
+           R"({"ok":false,"error":"Unknown command: x"})");
+    EXPECT(server.HandleLine(R"({"command": "fail"})") == R"({"ok":false,"error":"nope"})");
+}
+
+TEST(ServesRequestsOverSocket)
+{
+    auto path = SocketPath("serve");
+    ControlServer server{path};
+    AddHandlers(server);
+    EXPECT(server.Start());
+
+    auto fd = Connect(path);
+    EXPECT(fd >= 0);
+
+    std::string requests = "{\"id\":1,\"command\":\"echo\",\"value\":\"a\"}\r\n\n"
+                           "{\"id\":2,\"command\":\"echo\",\"value\":\"b\"}\n";
+    EXPECT(write(fd, requests.data(), requests.size()) == static_cast<ssize_t>(requests.size()));
+    EXPECT(ReadLine(fd) == R"({"id":1,"ok":true,"result":"a"})");
+    EXPECT(ReadLine(fd) == R"({"id":2,"ok":true,"result":"b"})");
+
+    close(fd);
+    server.Stop();
+}
+
+TEST(DropsClientsThatSendOverlongLines)
+{
+    auto path = SocketPath("overlong");
+    ControlServer server{path};
+    AddHandlers(server);
+    EXPECT(server.Start());
+
+    auto fd = Connect(path);
+    std::string garbage(128 * 1024, 'x');
+    EXPECT(write(fd, garbage.data(), garbage.size()) > 0);
+    EXPECT(ReadLine(fd) == R"({"ok":false,"error":"Request too long"})");
+
+    // The server closes the connection and accepts the next client
+    char c;
+    EXPECT(read(fd, &c, 1) <= 0);
+    close(fd);
+
+    fd = Connect(path);
+    std::string request = "{\"command\":\"echo\",\"value\":\"ok\"}\n";
+    EXPECT(write(fd, request.data(), request.size()) == static_cast<ssize_t>(request.size()));
+    EXPECT(ReadLine(fd) == R"({"ok":true,"result":"ok"})");
+    close(fd);
+
+    server.Stop();
+}
+
+TEST(SurvivesClientsThatDisconnectBeforeTheResponse)
+{
+    auto path = SocketPath("disconnect");
+    ControlServer server{path};
+    AddHandlers(server);
+    server.On("large", [](ControlRequest const &) {
+        return ControlResponse::Success("\"" + std::string(4 * 1024 * 1024, 'x') + "\"");
+    });
+    EXPECT(server.Start());
+
+    // Writing the response fails, which would raise `SIGPIPE` and terminate
+    // the test if the server did not suppress it
+    auto fd = Connect(path);
+    std::string request = "{\"command\":\"large\"}\n";
+    EXPECT(write(fd, request.data(), request.size()) == static_cast<ssize_t>(request.size()));
+    close(fd);
+
+    fd = Connect(path);
+    request = "{\"command\":\"echo\",\"value\":\"ok\"}\n";
+    EXPECT(write(fd, request.data(), request.size()) == static_cast<ssize_t>(request.size()));
+    EXPECT(ReadLine(fd) == R"({"ok":true,"result":"ok"})");
+    close(fd);
+
+    server.Stop();
+}
+
+TEST(StopsWhileClientIsIdle)
+{
+    auto path = SocketPath("idle");
+    ControlServer server{path};
+    AddHandlers(server);
+    EXPECT(server.Start());
+
+    auto fd = Connect(path);
+    auto const start = std::chrono::steady_clock::now();
+    server.Stop();
+    EXPECT(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+    close(fd);
+}
+
+TEST(StopsRightAfterStart)
+{
+    auto path = SocketPath("restart");
+    for (int i = 0; i < 50; ++i) {
+        ControlServer server{path};
+        AddHandlers(server);
+        EXPECT(server.Start());
+        server.Stop();
+    }
+}
@@ -0,0 +1,213 @@
+// Compares delivering events to a dispatcher thread through `EventChannel`
+// with posting one task per event, which is what the hosts did before. The
+// dispatcher is modelled as a task queue guarded by a mutex, like the UI
+// dispatchers on each platform.
+//
+// Usage: EventChannelBenchmark [events] [latency samples]
+
+#include "EventChannel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ReactTestApp::EventChannel;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    class Dispatcher
+    {
+    public:
+        Dispatcher() : thread_([this] { Run(); })
+        {
+        }
+
+        ~Dispatcher()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopped_ = true;
+            }
+            wake_.notify_one();
+            thread_.join();
+        }
+
+        void Post(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.push_back(std::move(task));
+            }
+            wake_.notify_one();
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::deque<std::function<void()>> tasks_;
+        bool stopped_ = false;
+        std::thread thread_;
+
+        void Run()
+        {
+            while (true) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                auto task = std::move(tasks_.front());
+                tasks_.pop_front();
+                lock.unlock();
+                task();
+            }
+        }
+    };
+
+    /**
+     * Drains an `EventChannel` on its own dispatcher, the way the hosts
+     * drain theirs on the UI thread.
+     */
+    template <typename T>
+    class DispatchedChannel
+    {
+    public:
+        using Handler = std::function<void(T &&)>;
+
+        DispatchedChannel(size_t capacity, Handler handler)
+            : handler_(std::move(handler)),
+              channel_(capacity, [this] { dispatcher_.Post([this] { channel_.Drain(handler_); }); })
+        {
+        }
+
+        bool Send(T &&event)
+        {
+            return channel_.Send(std::move(event));
+        }
+
+    private:
+        Handler handler_;
+        EventChannel<T> channel_;
+        // Declared last so that its thread is joined before the channel goes
+        Dispatcher dispatcher_;
+    };
+
+    using Payload = std::vector<std::string>;
+
+    Payload MakePayload(size_t i)
+    {
+        return Payload(1 + (i & 3), "component");
+    }
+
+    void WaitFor(std::atomic<size_t> const &received, size_t count)
+    {
+        while (received.load(std::memory_order_acquire) < count) {
+            std::this_thread::yield();
+        }
+    }
+
+    double ChannelThroughput(size_t events)
+    {
+        std::atomic<size_t> received{0};
+        DispatchedChannel<Payload> channel{
+            1024, [&received](Payload &&) { received.fetch_add(1, std::memory_order_release); }};
+
+        auto const start = Clock::now();
+        for (size_t i = 0; i < events; ++i) {
+            while (!channel.Send(MakePayload(i))) {
+                std::this_thread::yield();
+            }
+        }
+        WaitFor(received, events);
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    double PostThroughput(size_t events)
+    {
+        std::atomic<size_t> received{0};
+        Dispatcher dispatcher;
+
+        auto const start = Clock::now();
+        for (size_t i = 0; i < events; ++i) {
+            dispatcher.Post([&received, payload = MakePayload(i)] {
+                received.fetch_add(1, std::memory_order_release);
+            });
+        }
+        WaitFor(received, events);
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Sends one event at a time and waits for it to be handled, so every
+    // sample includes a wakeup
+    template <typename Send>
+    void PrintLatency(char const *name, size_t samples, Send &&send)
+    {
+        std::vector<double> latencies;
+        latencies.reserve(samples);
+        std::atomic<size_t> received{0};
+        auto const record = [&](Clock::time_point sent) {
+            std::chrono::duration<double, std::micro> const latency = Clock::now() - sent;
+            latencies.push_back(latency.count());
+            received.fetch_add(1, std::memory_order_release);
+        };
+
+        for (size_t i = 0; i < samples; ++i) {
+            send(record);
+            WaitFor(received, i + 1);
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        std::printf("%-10s latency (us): p50 %.2f, p99 %.2f, max %.2f\n",
+                    name,
+                    latencies[samples / 2],
+                    latencies[samples * 99 / 100],
+                    latencies.back());
+    }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    auto const events = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    auto const samples = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+
+    auto const channel = ChannelThroughput(events);
+    std::printf("channel    %lu events in %.3f s: %.1fM events/s\n",
+                events,
+                channel,
+                events / channel / 1e6);
+    auto const post = PostThroughput(events);
+    std::printf("post       %lu events in %.3f s: %.1fM events/s\n",
+                events,
+                post,
+                events / post / 1e6);
+
+    {
+        std::function<void(Clock::time_point)> record;
+        DispatchedChannel<Clock::time_point> channel{
+            64, [&record](Clock::time_point &&sent) { record(sent); }};
+        PrintLatency("channel", samples, [&](auto const &recorder) {
+            record = recorder;
+            channel.Send(Clock::now());
+        });
+    }
+
+    {
+        Dispatcher dispatcher;
+        PrintLatency("post", samples, [&](auto const &record) {
+            dispatcher.Post([record, sent = Clock::now()] { record(sent); });
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "EventChannel.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+
+using ReactTestApp::EventChannel;
+using ReactTestApp::SpscQueue;
+
+TEST(QueueRoundsCapacityUpToAPowerOfTwo)
+{
+    SpscQueue<int> queue{5};
+    EXPECT(queue.Capacity() == 8);
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT(queue.TryPush(int{i}));
+    }
+    EXPECT(!queue.TryPush(8));
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT(queue.TryPop() == i);
+    }
+    EXPECT(!queue.TryPop().has_value());
+    EXPECT(queue.IsEmpty());
+}
+
+TEST(QueueMovesPayloads)
+{
+    SpscQueue<std::unique_ptr<std::string>> queue{2};
+    EXPECT(queue.TryPush(std::make_unique<std::string>("appKey")));
+
+    auto value = queue.TryPop();
+    EXPECT(value.has_value() && *value != nullptr && **value == "appKey");
+}
+
+TEST(WakeupsAreCoalescedUntilDrained)
+{
+    int wakeups = 0;
+    EventChannel<int> channel{16, [&wakeups] { ++wakeups; }};
+
+    EXPECT(channel.Send(1));
+    EXPECT(channel.Send(2));
+    EXPECT(channel.Send(3));
+    EXPECT(wakeups == 1);
+
+    std::vector<int> received;
+    EXPECT(channel.Drain([&received](int &&event) { received.push_back(event); }) == 3);
+    EXPECT((received == std::vector<int>{1, 2, 3}));
+
+    EXPECT(channel.Send(4));
+    EXPECT(wakeups == 2);
+}
+
+TEST(FullChannelDropsEvents)
+{
+    EventChannel<int> channel{2, [] {}};
+    EXPECT(channel.Send(1));
+    EXPECT(channel.Send(2));
+    EXPECT(!channel.Send(3));
+    EXPECT(channel.Dropped() == 1);
+}
+
+TEST(EventsArriveInOrderAcrossThreads)
+{
+    constexpr int kEvents = 200000;
+
+    // Drains run on the consumer thread whenever a wakeup has been posted
+    std::atomic<int> pendingWakeups{0};
+    EventChannel<std::vector<int>> channel{
+        64, [&pendingWakeups] { pendingWakeups.fetch_add(1, std::memory_order_release); }};
+
+    int next = 0;
+    bool inOrder = true;
+    std::thread consumer([&] {
+        while (next < kEvents) {
+            if (pendingWakeups.load(std::memory_order_acquire) == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            pendingWakeups.fetch_sub(1, std::memory_order_relaxed);
+            channel.Drain([&](std::vector<int> &&event) {
+                inOrder = inOrder && event.size() == 1 && event[0] == next;
+                ++next;
+            });
+        }
+    });
+
+    for (int i = 0; i < kEvents; ++i) {
+        while (!channel.Send(std::vector<int>{i})) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    EXPECT(inOrder);
+    EXPECT(next == kEvents);
+}
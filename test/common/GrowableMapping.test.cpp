@@ -0,0 +1,77 @@
+#include "GrowableMapping.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "Test.h"
+
+using ReactTestApp::GrowableMapping;
+
+namespace
+{
+    constexpr size_t kMegabyte = 1024 * 1024;
+}  // namespace
+
+TEST(NewMappingIsEmpty)
+{
+    GrowableMapping mapping;
+    EXPECT(mapping.Size() == 0);
+    EXPECT(mapping.Capacity() == GrowableMapping::kDefaultCapacity);
+    EXPECT(mapping.View().empty());
+
+    mapping.Append({});
+    EXPECT(mapping.Size() == 0);
+}
+
+TEST(AppendsAcrossCommitsWithoutMovingData)
+{
+    GrowableMapping mapping{64 * kMegabyte};
+    mapping.Append("a");
+    auto const data = mapping.Data();
+
+    // Grow past several commit steps in odd sized pieces
+    std::string expected = "a";
+    std::string piece(100003, '\0');
+    for (int i = 0; i < 40; ++i) {
+        for (size_t j = 0; j < piece.size(); ++j) {
+            piece[j] = static_cast<char>('a' + (i + j) % 26);
+        }
+        mapping.Append(piece);
+        expected += piece;
+    }
+
+    EXPECT(mapping.Data() == data);
+    EXPECT(mapping.Size() == expected.size());
+    EXPECT(mapping.View() == expected);
+}
+
+TEST(AppendsLargerThanACommitStep)
+{
+    GrowableMapping mapping{16 * kMegabyte};
+    std::string const block(3 * kMegabyte + 1, 'x');
+    mapping.Append(block);
+    mapping.Append(block);
+    EXPECT(mapping.Size() == 2 * block.size());
+    EXPECT(mapping.View().substr(block.size()) == block);
+}
+
+TEST(CapacityIsEnforced)
+{
+    // Capacity that is not a multiple of the commit step or the page size
+    GrowableMapping mapping{kMegabyte + 5};
+    mapping.Append(std::string(kMegabyte, 'x'));
+    mapping.Append("12345");
+    EXPECT(mapping.Size() == mapping.Capacity());
+
+    bool threw = false;
+    try {
+        mapping.Append("6");
+    } catch (std::length_error const &) {
+        threw = true;
+    }
+    EXPECT(threw);
+
+    // A failed append leaves the contents alone
+    EXPECT(mapping.Size() == kMegabyte + 5);
+    EXPECT(mapping.View().substr(kMegabyte) == "12345");
+}
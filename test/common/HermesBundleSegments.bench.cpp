@@ -0,0 +1,118 @@
+// Measures what splitting components into bundle segments buys at startup,
+// and what it costs when a component is opened for the first time. Compares
+// evaluating one bundle with every component in it against evaluating a base
+// bundle, then loading a component's segment with `BundleSegmentLoader`:
+// the first time, again in the same runtime, and in a new runtime that reuses
+// the prepared segment, like after a reload.
+//
+// Sources are evaluated as JS text, i.e. without compiling to bytecode first,
+// like bundles served by the dev server.
+//
+// Only built when `HERMES_SOURCE_DIR` and `HERMES_BUILD_DIR` are set; see
+// `CMakeLists.txt`.
+//
+// Usage: HermesBundleSegmentsBenchmark [components] [functions per component]
+
+#include "BundleSegments.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <hermes/hermes.h>
+#include <jsi/jsi.h>
+
+using facebook::jsi::StringBuffer;
+using ReactTestApp::BundleSegmentLoader;
+
+namespace
+{
+    std::string MakeBase()
+    {
+        return "var components = {};\n"
+               "function register(name, render) { components[name] = render; }\n";
+    }
+
+    std::string MakeComponent(unsigned long index, unsigned long functions)
+    {
+        auto const name = "Component" + std::to_string(index);
+        std::string source = "(function () {\n";
+        for (unsigned long i = 0; i < functions; ++i) {
+            auto const id = std::to_string(i);
+            source += "  function f" + id + "(props) {\n";
+            source += "    var items = [];\n";
+            source += "    for (var i = 0; i < " + std::to_string(i % 7) + "; ++i) {\n";
+            source += "      items.push({ key: '" + name + "' + i, value: props.value + i });\n";
+            source += "    }\n";
+            source += "    return items;\n";
+            source += "  }\n";
+        }
+        source += "  register('" + name + "', function (props) { return f0(props); });\n";
+        source += "})();\n";
+        return source;
+    }
+
+    template <typename Body>
+    double Milliseconds(Body const &body)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        body();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    auto const components = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    auto const functions = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+
+    auto const directory = std::filesystem::temp_directory_path() / "rnta-segments-benchmark";
+    std::filesystem::create_directories(directory);
+
+    auto base = MakeBase();
+    auto everything = base;
+    for (unsigned long i = 0; i < components; ++i) {
+        auto component = MakeComponent(i, functions);
+        everything += component;
+        std::ofstream(directory / ("Component" + std::to_string(i) + ".bundle"),
+                      std::ios::binary)
+            << component;
+    }
+
+    std::printf("%lu components, %lu functions each, %zu KiB in total\n",
+                components,
+                functions,
+                everything.size() / 1024);
+
+    auto const monolithic = Milliseconds([&everything] {
+        auto runtime = facebook::hermes::makeHermesRuntime();
+        runtime->evaluateJavaScript(std::make_shared<StringBuffer>(everything), "index.bundle");
+    });
+
+    BundleSegmentLoader loader{directory.string()};
+    auto runtime = facebook::hermes::makeHermesRuntime();
+    auto const startup = Milliseconds([&] {
+        runtime->evaluateJavaScript(std::make_shared<StringBuffer>(base), "index.bundle");
+    });
+    auto const firstOpen = Milliseconds([&] { loader.Load(*runtime, "Component0"); });
+    auto const reopen = Milliseconds([&] { loader.Load(*runtime, "Component0"); });
+
+    auto reloaded = facebook::hermes::makeHermesRuntime();
+    reloaded->evaluateJavaScript(std::make_shared<StringBuffer>(base), "index.bundle");
+    auto const afterReload = Milliseconds([&] { loader.Load(*reloaded, "Component0"); });
+
+    std::printf("%-36s %10s\n", "", "time (ms)");
+    std::printf("%-36s %10.2f\n", "startup, single bundle", monolithic);
+    std::printf("%-36s %10.2f\n", "startup, base bundle", startup);
+    std::printf("%-36s %10.2f\n", "first open of a segment", firstOpen);
+    std::printf("%-36s %10.2f\n", "open again, same runtime", reopen);
+    std::printf("%-36s %10.2f\n", "first open after reload", afterReload);
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "BundleSegments.h"
+
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <hermes/hermes.h>
+#include <jsi/jsi.h>
+
+#include "Test.h"
+
+using facebook::jsi::Runtime;
+using ReactTestApp::BundleSegmentLoader;
+
+namespace
+{
+    class SegmentDirectory
+    {
+    public:
+        SegmentDirectory()
+            : path_(std::filesystem::temp_directory_path() / "rnta-bundle-segments")
+        {
+            std::filesystem::remove_all(path_);
+            std::filesystem::create_directories(path_);
+        }
+
+        ~SegmentDirectory()
+        {
+            std::filesystem::remove_all(path_);
+        }
+
+        std::string Path() const
+        {
+            return path_.string();
+        }
+
+        void Write(std::string const &name, std::string const &source) const
+        {
+            std::ofstream(path_ / (name + ".bundle"), std::ios::binary) << source;
+        }
+
+        void Remove(std::string const &name) const
+        {
+            std::filesystem::remove(path_ / (name + ".bundle"));
+        }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    double Evaluations(Runtime &runtime)
+    {
+        auto global = runtime.global();
+        if (!global.hasProperty(runtime, "evaluations")) {
+            return 0;
+        }
+        return global.getProperty(runtime, "evaluations").asNumber();
+    }
+
+    template <typename Function>
+    bool Throws(Function const &function)
+    {
+        try {
+            function();
+        } catch (std::exception const &) {
+            return true;
+        }
+        return false;
+    }
+
+    constexpr char kSegment[] = "var evaluations = (this.evaluations || 0) + 1;";
+}  // namespace
+
+TEST(SegmentsAreEvaluatedOncePerRuntime)
+{
+    SegmentDirectory directory;
+    directory.Write("settings", kSegment);
+    BundleSegmentLoader loader{directory.Path()};
+
+    auto runtime = facebook::hermes::makeHermesRuntime();
+    EXPECT(!BundleSegmentLoader::IsLoaded(*runtime, "settings"));
+    EXPECT(loader.Load(*runtime, "settings"));
+    EXPECT(BundleSegmentLoader::IsLoaded(*runtime, "settings"));
+    EXPECT(!loader.Load(*runtime, "settings"));
+    EXPECT(Evaluations(*runtime) == 1);
+}
+
+TEST(PreparedSegmentsAreCachedAcrossRuntimes)
+{
+    SegmentDirectory directory;
+    directory.Write("settings", kSegment);
+    BundleSegmentLoader loader{directory.Path()};
+
+    auto runtime = facebook::hermes::makeHermesRuntime();
+    EXPECT(loader.Load(*runtime, "settings"));
+
+    // A reloaded runtime evaluates the segment again, but from the prepared
+    // form; the file is not read a second time
+    directory.Remove("settings");
+    auto reloaded = facebook::hermes::makeHermesRuntime();
+    EXPECT(!BundleSegmentLoader::IsLoaded(*reloaded, "settings"));
+    EXPECT(loader.Load(*reloaded, "settings"));
+    EXPECT(Evaluations(*reloaded) == 1);
+
+    // A new loader starts out empty
+    BundleSegmentLoader other{directory.Path()};
+    auto fresh = facebook::hermes::makeHermesRuntime();
+    EXPECT(Throws([&] { other.Load(*fresh, "settings"); }));
+}
+
+TEST(FailedSegmentsCanBeRetried)
+{
+    SegmentDirectory directory;
+    directory.Write("broken", "throw new Error('broken');");
+    BundleSegmentLoader loader{directory.Path()};
+
+    auto runtime = facebook::hermes::makeHermesRuntime();
+    EXPECT(Throws([&] { loader.Load(*runtime, "broken"); }));
+    EXPECT(!BundleSegmentLoader::IsLoaded(*runtime, "broken"));
+    EXPECT(Throws([&] { loader.Load(*runtime, "missing"); }));
+    EXPECT(!BundleSegmentLoader::IsLoaded(*runtime, "missing"));
+
+    directory.Write("missing", kSegment);
+    EXPECT(loader.Load(*runtime, "missing"));
+}
+
+TEST(SegmentNamesCannotLeaveTheDirectory)
+{
+    SegmentDirectory directory;
+    BundleSegmentLoader loader{directory.Path()};
+
+    auto runtime = facebook::hermes::makeHermesRuntime();
+    EXPECT(Throws([&] { loader.Load(*runtime, ""); }));
+    EXPECT(Throws([&] { loader.Load(*runtime, ".."); }));
+    EXPECT(Throws([&] { loader.Load(*runtime, "../settings"); }));
+    EXPECT(Throws([&] { loader.Load(*runtime, "nested\\settings"); }));
+}
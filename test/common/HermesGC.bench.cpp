@@ -0,0 +1,114 @@
+// Runs an allocation heavy workload on Hermes under the heap and GC settings
+// that the `engine` section of the app manifest exposes (see
+// `docs/engine.md`), and reports time spent, collections, and heap size for
+// each.
+//
+// `gcMode` is mapped to Hermes' `ReleaseUnused` policy: `lowMemory` returns
+// freed memory to the system after every collection, `throughput` never does,
+// and `default` keeps Hermes' default.
+//
+// Only built when `HERMES_SOURCE_DIR` and `HERMES_BUILD_DIR` are set; see
+// `CMakeLists.txt`.
+//
+// Usage: HermesGCBenchmark [iterations] [maxHeapSizeMB] [initHeapSizeMB]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <hermes/Public/GCConfig.h>
+#include <hermes/hermes.h>
+#include <jsi/jsi.h>
+
+namespace
+{
+    // Builds short-lived trees of objects and strings, and keeps every 16th
+    // one alive to give the collector old generation work as well
+    constexpr char kWorkload[] = R"(
+        var retained = [];
+        function allocate(depth) {
+            if (depth === 0) {
+                return { value: "leaf" + Math.random(), items: [1, 2, 3, 4] };
+            }
+            return { left: allocate(depth - 1), right: allocate(depth - 1) };
+        }
+        function run(iterations) {
+            for (var i = 0; i < iterations; ++i) {
+                var tree = allocate(10);
+                if (i % 16 === 0) {
+                    retained.push(tree);
+                }
+            }
+            return retained.length;
+        }
+    )";
+
+    struct GCMode {
+        char const *name;
+        ::hermes::vm::ReleaseUnused releaseUnused;
+    };
+
+    constexpr GCMode kModes[] = {
+        {"default", ::hermes::vm::kReleaseUnusedOld},
+        {"lowMemory", ::hermes::vm::kReleaseUnusedYoungAlways},
+        {"throughput", ::hermes::vm::kReleaseUnusedNone},
+    };
+
+    double HeapInfo(facebook::jsi::Runtime &runtime, char const *key)
+    {
+        auto info = runtime.instrumentation().getHeapInfo(false);
+        auto value = info.find(key);
+        return value == info.end() ? -1.0 : static_cast<double>(value->second);
+    }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    auto const iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+    auto const maxHeapSizeMB = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 512;
+    auto const initHeapSizeMB = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 0;
+
+    std::printf("%d iterations, maxHeapSizeMB %lu, initHeapSizeMB %lu\n",
+                iterations,
+                maxHeapSizeMB,
+                initHeapSizeMB);
+    std::printf("%12s %10s %12s %14s %14s\n",
+                "gcMode",
+                "time (ms)",
+                "collections",
+                "heap (KiB)",
+                "allocated (KiB)");
+
+    for (auto const &mode : kModes) {
+        auto gcConfig = ::hermes::vm::GCConfig::Builder()
+                            .withMaxHeapSize(static_cast<::hermes::vm::gcheapsize_t>(
+                                maxHeapSizeMB * 1024 * 1024))
+                            .withShouldReleaseUnused(mode.releaseUnused);
+        if (initHeapSizeMB > 0) {
+            gcConfig.withInitHeapSize(
+                static_cast<::hermes::vm::gcheapsize_t>(initHeapSizeMB * 1024 * 1024));
+        }
+
+        auto runtime = facebook::hermes::makeHermesRuntime(
+            ::hermes::vm::RuntimeConfig::Builder().withGCConfig(gcConfig.build()).build());
+        runtime->evaluateJavaScript(std::make_shared<facebook::jsi::StringBuffer>(kWorkload),
+                                    "workload.js");
+        auto run = runtime->global().getPropertyAsFunction(*runtime, "run");
+
+        auto const start = std::chrono::steady_clock::now();
+        run.call(*runtime, iterations);
+        std::chrono::duration<double, std::milli> const elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        std::printf("%12s %10.1f %12.0f %14.0f %14.0f\n",
+                    mode.name,
+                    elapsed.count(),
+                    HeapInfo(*runtime, "hermes_numCollections"),
+                    HeapInfo(*runtime, "hermes_heapSize") / 1024,
+                    HeapInfo(*runtime, "hermes_allocatedBytes") / 1024);
+    }
+
+    return 0;
+}
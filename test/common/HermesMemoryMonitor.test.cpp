@@ -0,0 +1,71 @@
+#include "MemoryMonitor.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <hermes/hermes.h>
+#include <jsi/jsi.h>
+
+#include "Metrics.h"
+#include "Test.h"
+
+using facebook::jsi::StringBuffer;
+using ReactTestApp::CheckComponentMemory;
+using ReactTestApp::MemoryBudget;
+using ReactTestApp::Metrics;
+
+namespace
+{
+    // Keeps a few megabytes alive so that the heap is measurably in use
+    constexpr char kComponent[] = R"(
+        var retained = [];
+        for (var i = 0; i < 1000; ++i) {
+            retained.push(new Array(1000).fill(i));
+        }
+    )";
+
+    std::filesystem::path SnapshotDirectory()
+    {
+        auto directory = std::filesystem::temp_directory_path() / "rnta-heap-snapshots";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+}  // namespace
+
+TEST(HeapUsageIsRecordedPerComponent)
+{
+    auto runtime = facebook::hermes::makeHermesRuntime();
+    runtime->evaluateJavaScript(std::make_shared<StringBuffer>(kComponent), "component.js");
+
+    auto directory = SnapshotDirectory();
+    auto snapshot = CheckComponentMemory(*runtime, "Heavy", MemoryBudget{}, directory.string());
+    EXPECT(!snapshot.has_value());
+    EXPECT(std::filesystem::is_empty(directory));
+
+    auto metrics = Metrics::Shared().Snapshot();
+    EXPECT(metrics.gauges["memory.Heavy.jsHeapBytes"] > 1024 * 1024);
+    EXPECT(metrics.gauges["memory.Heavy.residentBytes"] > 0);
+
+    std::filesystem::remove_all(directory);
+}
+
+// Needs a Hermes build with memory instrumentation, which is the default
+TEST(HeapSnapshotIsWrittenWhenOverBudget)
+{
+    auto runtime = facebook::hermes::makeHermesRuntime();
+    runtime->evaluateJavaScript(std::make_shared<StringBuffer>(kComponent), "component.js");
+
+    auto directory = SnapshotDirectory();
+    auto budget = MemoryBudget::Parse("1", nullptr);
+    auto snapshot = CheckComponentMemory(*runtime, "Heavy", budget, directory.string());
+    EXPECT(snapshot.has_value());
+    if (snapshot.has_value()) {
+        EXPECT(std::filesystem::path{*snapshot}.parent_path() == directory);
+        EXPECT(std::filesystem::path{*snapshot}.extension() == ".heapsnapshot");
+        EXPECT(std::filesystem::file_size(*snapshot) > 0);
+    }
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,150 @@
+#include "MultiInstance.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <hermes/hermes.h>
+#include <jsi/jsi.h>
+
+#include "AppRegistry.h"
+#include "Test.h"
+
+using facebook::jsi::Function;
+using facebook::jsi::PropNameID;
+using facebook::jsi::Runtime;
+using facebook::jsi::StringBuffer;
+using facebook::jsi::Value;
+using ReactTestApp::RunHeadlessInstances;
+
+namespace
+{
+    // Stands in for the bridge and `AppRegistry` that a React Native bundle
+    // sets up. Instance 2 fails to evaluate, and instance 3 registers nothing
+    // but LogBox, which hosts ignore.
+    constexpr char kBundle[] = R"(
+        if (instance === 2) {
+            throw new Error("Instance 2 fails to load");
+        }
+        var appKeys = instance === 3 ? ["LogBox"] : ["LogBox", "Example", "Settings"];
+        var __fbBatchedBridge = {
+            getCallableModule: function (name) {
+                if (name !== "AppRegistry") {
+                    return undefined;
+                }
+                return {
+                    getAppKeys: function () {
+                        return appKeys;
+                    },
+                    runApplication: function (appKey, parameters) {
+                        nativeRunApplication(appKey, parameters.rootTag);
+                    },
+                };
+            },
+        };
+    )";
+
+    class Applications
+    {
+    public:
+        void Add(size_t instance, std::string appKey, int rootTag)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            applications_.emplace_back(instance, std::move(appKey), rootTag);
+        }
+
+        std::vector<std::tuple<size_t, std::string, int>> Sorted()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto applications = applications_;
+            std::sort(applications.begin(), applications.end());
+            return applications;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::vector<std::tuple<size_t, std::string, int>> applications_;
+    };
+}  // namespace
+
+TEST(EveryRuntimeRunsItsFirstComponent)
+{
+    Applications applications;
+    auto createRuntime = [&applications](size_t instance) -> std::unique_ptr<Runtime> {
+        auto runtime = facebook::hermes::makeHermesRuntime();
+        auto global = runtime->global();
+        global.setProperty(*runtime, "instance", static_cast<int>(instance));
+        global.setProperty(
+            *runtime,
+            "nativeRunApplication",
+            Function::createFromHostFunction(
+                *runtime,
+                PropNameID::forAscii(*runtime, "nativeRunApplication"),
+                2,
+                [&applications, instance](
+                    Runtime &runtime, Value const &, Value const *args, size_t count) {
+                    if (count == 2) {
+                        applications.Add(instance,
+                                         args[0].asString(runtime).utf8(runtime),
+                                         static_cast<int>(args[1].asNumber()));
+                    }
+                    return Value::undefined();
+                }));
+        return runtime;
+    };
+
+    auto result = RunHeadlessInstances(
+        4, createRuntime, std::make_shared<StringBuffer>(kBundle), "index.bundle");
+
+    EXPECT(result.instances.size() == 4);
+    if (result.instances.size() != 4) {
+        return;
+    }
+
+    for (size_t i : {0, 1}) {
+        auto &instance = result.instances[i];
+        EXPECT(instance.error.empty());
+        EXPECT((instance.appKeys == std::vector<std::string>{"Example", "Settings"}));
+        EXPECT(instance.duration <= result.duration);
+    }
+    EXPECT(result.instances[2].error.find("Instance 2 fails to load") != std::string::npos);
+    EXPECT(result.instances[3].error == "No components were registered");
+
+    // Root tags of React Native apps end in 1
+    auto ran = applications.Sorted();
+    EXPECT(ran.size() == 2);
+    if (ran.size() == 2) {
+        EXPECT((ran[0] == std::tuple<size_t, std::string, int>{0, "Example", 1}));
+        EXPECT((ran[1] == std::tuple<size_t, std::string, int>{1, "Example", 11}));
+    }
+
+    // Runtimes are measured while they are all alive
+    EXPECT(result.baselineResidentBytes.has_value());
+    EXPECT(result.finalResidentBytes.has_value());
+    EXPECT(result.ResidentBytesPerInstance().has_value());
+}
+
+TEST(RuntimesThatFailToStartAreReported)
+{
+    auto createRuntime = [](size_t instance) -> std::unique_ptr<Runtime> {
+        if (instance == 1) {
+            throw std::runtime_error("Out of runtimes");
+        }
+        auto runtime = facebook::hermes::makeHermesRuntime();
+        runtime->global().setProperty(*runtime, "instance", 3);
+        return runtime;
+    };
+
+    auto result = RunHeadlessInstances(
+        2, createRuntime, std::make_shared<StringBuffer>(kBundle), "index.bundle");
+
+    EXPECT(result.instances.size() == 2);
+    if (result.instances.size() == 2) {
+        EXPECT(result.instances[0].error == "No components were registered");
+        EXPECT(result.instances[1].error == "Out of runtimes");
+    }
+}
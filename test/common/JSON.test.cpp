@@ -0,0 +1,86 @@
+#include "JSON.h"
+
+#include "Test.h"
+
+using ReactTestApp::AppendJSONString;
+using ReactTestApp::JSONScalar;
+using ReactTestApp::ParseFlatJSONObject;
+
+TEST(ParsesScalarsWithTheirTypes)
+{
+    auto object = ParseFlatJSONObject(
+        R"({"s": "text", "n": -1.5e3, "t": true, "f": false, "z": null, "i": 0})");
+    EXPECT(object.has_value());
+    EXPECT(object->at("s").type == JSONScalar::Type::String);
+    EXPECT(object->at("s").value == "text");
+    EXPECT(object->at("n").type == JSONScalar::Type::Number);
+    EXPECT(object->at("n").value == "-1.5e3");
+    EXPECT(object->at("t").type == JSONScalar::Type::Boolean);
+    EXPECT(object->at("f").value == "false");
+    EXPECT(object->at("z").type == JSONScalar::Type::Null);
+    EXPECT(object->at("i").value == "0");
+}
+
+TEST(StringsThatLookLikeNumbersAreStrings)
+{
+    auto object = ParseFlatJSONObject(R"({"id": "1"})");
+    EXPECT(object.has_value());
+    EXPECT(object->at("id").type == JSONScalar::Type::String);
+}
+
+TEST(RejectsMalformedNumbersAndLiterals)
+{
+    EXPECT(!ParseFlatJSONObject(R"({"id": 1abc})").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"id": 01})").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"id": 1.})").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"id": 1e})").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"id": -})").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"id": truex})").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"id": undefined})").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"id": 1"},"x":{"})").has_value());
+}
+
+TEST(RejectsNonObjects)
+{
+    EXPECT(!ParseFlatJSONObject("").has_value());
+    EXPECT(!ParseFlatJSONObject("[]").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"a": 1} x)").has_value());
+    EXPECT(!ParseFlatJSONObject(R"({"a": {}})").has_value());
+    EXPECT(ParseFlatJSONObject(" { } ").has_value());
+}
+
+TEST(DecodesEscapeSequences)
+{
+    auto object = ParseFlatJSONObject(R"({"s": "a\"b\\c\/d\né€"})");
+    EXPECT(object.has_value());
+    EXPECT(object->at("s").value == "a\"b\\c/d\n\xC3\xA9\xE2\x82\xAC");
+}
+
+TEST(CombinesSurrogatePairs)
+{
+    // U+1F600 GRINNING FACE
+    auto object = ParseFlatJSONObject(R"({"s": "😀"})");
+    EXPECT(object.has_value());
+    EXPECT(object->at("s").value == "\xF0\x9F\x98\x80");
+}
+
+TEST(ReplacesUnpairedSurrogates)
+{
+    auto object = ParseFlatJSONObject(R"({"a": "\ud83d", "b": "\ude00x", "c": "\ud83dA"})");
+    EXPECT(object.has_value());
+    EXPECT(object->at("a").value == "\xEF\xBF\xBD");
+    EXPECT(object->at("b").value == "\xEF\xBF\xBDx");
+    EXPECT(object->at("c").value == "\xEF\xBF\xBD"
+                                    "A");
+}
+
+TEST(AppendsEscapedStrings)
+{
+    std::string out;
+    AppendJSONString(out, "a\"b\\c\n\x01");
+    EXPECT(out == R"("a\"b\\c\n\u0001")");
+
+    auto object = ParseFlatJSONObject("{\"s\":" + out + "}");
+    EXPECT(object.has_value());
+    EXPECT(object->at("s").value == "a\"b\\c\n\x01");
+}
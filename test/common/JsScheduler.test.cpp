@@ -0,0 +1,329 @@
+#include "JsScheduler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+
+// `JsScheduler` only passes the runtime through, so a stand-in is enough
+namespace facebook::jsi
+{
+    class Runtime
+    {
+    public:
+        int value = 0;
+    };
+}  // namespace facebook::jsi
+
+using facebook::jsi::Runtime;
+using ReactTestApp::JsScheduler;
+using ReactTestApp::JsTask;
+using ReactTestApp::JsTaskCancelled;
+
+namespace
+{
+    // Collects dispatched batches so that tests decide when the JS thread
+    // gets to them
+    class FakeJsThread
+    {
+    public:
+        explicit FakeJsThread(int value)
+        {
+            runtime_.value = value;
+        }
+
+        JsScheduler::Dispatch Dispatcher()
+        {
+            return [batches = batches_](JsScheduler::Batch batch) {
+                batches->push_back(std::move(batch));
+            };
+        }
+
+        size_t Pending() const
+        {
+            return batches_->size();
+        }
+
+        void RunAll()
+        {
+            auto batches = std::move(*batches_);
+            batches_->clear();
+            for (auto &&batch : batches) {
+                batch(runtime_);
+            }
+        }
+
+    private:
+        Runtime runtime_;
+        std::shared_ptr<std::vector<JsScheduler::Batch>> batches_ =
+            std::make_shared<std::vector<JsScheduler::Batch>>();
+    };
+
+    // Minimal fire-and-forget coroutine, like `winrt::fire_and_forget`
+    struct FireAndForget {
+        struct promise_type {
+            FireAndForget get_return_object()
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend()
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void()
+            {
+            }
+
+            void unhandled_exception()
+            {
+                std::terminate();
+            }
+        };
+    };
+
+    // Mirrors `ReactInstance::LoadBundleSegment`, which must report back
+    // whether or not the job got to run
+    FireAndForget LoadSegment(JsScheduler &scheduler,
+                              std::optional<std::string> &error,
+                              bool &completed)
+    {
+        try {
+            co_await scheduler.RunOnJs([](Runtime &runtime) {
+                if (runtime.value == 0) {
+                    throw std::runtime_error("Bundle segment not found");
+                }
+            });
+        } catch (JsTaskCancelled const &) {
+            error = "Reloaded";
+        } catch (std::exception const &e) {
+            error = e.what();
+        }
+        completed = true;
+    }
+
+    template <typename T>
+    bool IsCancelled(JsTask<T> &task)
+    {
+        if (!task.await_ready()) {
+            return false;
+        }
+
+        try {
+            task.await_resume();
+        } catch (JsTaskCancelled const &) {
+            return true;
+        }
+        return false;
+    }
+}  // namespace
+
+TEST(JobsAreCoalescedIntoOneDispatch)
+{
+    FakeJsThread js{42};
+    JsScheduler scheduler;
+    scheduler.Attach(js.Dispatcher());
+
+    auto value = scheduler.RunOnJs([](Runtime &runtime) { return runtime.value; });
+    auto text = scheduler.RunOnJs([](Runtime &) { return std::string{"appKey"}; });
+    auto error = scheduler.RunOnJs([](Runtime &) -> int { throw std::runtime_error("boom"); });
+    EXPECT(js.Pending() == 1);
+    EXPECT(scheduler.Dispatches() == 1);
+    EXPECT(!value.await_ready());
+
+    js.RunAll();
+    EXPECT(value.await_ready() && value.await_resume() == 42);
+    EXPECT(text.await_ready() && text.await_resume() == "appKey");
+
+    std::string message;
+    try {
+        error.await_resume();
+    } catch (std::runtime_error const &e) {
+        message = e.what();
+    }
+    EXPECT(message == "boom");
+}
+
+TEST(JobsWaitUntilARuntimeIsAttached)
+{
+    FakeJsThread js{1};
+    JsScheduler scheduler;
+
+    auto value = scheduler.RunOnJs([](Runtime &runtime) { return runtime.value; });
+    EXPECT(scheduler.Dispatches() == 0);
+    EXPECT(!value.await_ready());
+
+    scheduler.Attach(js.Dispatcher());
+    EXPECT(js.Pending() == 1);
+
+    js.RunAll();
+    EXPECT(value.await_ready() && value.await_resume() == 1);
+}
+
+TEST(DetachCancelsPendingJobsAndHoldsNewOnes)
+{
+    FakeJsThread first{1};
+    FakeJsThread second{2};
+    JsScheduler scheduler;
+    scheduler.Attach(first.Dispatcher());
+
+    auto stale = scheduler.RunOnJs([](Runtime &runtime) { return runtime.value; });
+    scheduler.Detach();
+    EXPECT(IsCancelled(stale));
+
+    auto next = scheduler.RunOnJs([](Runtime &runtime) { return runtime.value; });
+    EXPECT(scheduler.Dispatches() == 1);
+
+    // The batch dispatched before `Detach` must not run the new job on the
+    // old runtime
+    first.RunAll();
+    EXPECT(!next.await_ready());
+
+    scheduler.Attach(second.Dispatcher());
+    second.RunAll();
+    EXPECT(next.await_ready() && next.await_resume() == 2);
+}
+
+TEST(AttachingAnotherRuntimeCancelsJobsForThePreviousOne)
+{
+    FakeJsThread first{1};
+    FakeJsThread second{2};
+    JsScheduler scheduler;
+    scheduler.Attach(first.Dispatcher());
+
+    auto stale = scheduler.RunOnJs([](Runtime &runtime) { return runtime.value; });
+    scheduler.Attach(second.Dispatcher());
+    EXPECT(IsCancelled(stale));
+    EXPECT(second.Pending() == 0);
+
+    auto next = scheduler.RunOnJs([](Runtime &runtime) { return runtime.value; });
+    first.RunAll();
+    second.RunAll();
+    EXPECT(next.await_ready() && next.await_resume() == 2);
+}
+
+TEST(BatchesOutlivingTheSchedulerDoNothing)
+{
+    FakeJsThread js{1};
+    bool ran = false;
+    JsTask<void> task{nullptr};
+    {
+        JsScheduler scheduler;
+        scheduler.Attach(js.Dispatcher());
+        task = scheduler.RunOnJs([&ran](Runtime &) { ran = true; });
+    }
+
+    EXPECT(IsCancelled(task));
+    js.RunAll();
+    EXPECT(!ran);
+}
+
+TEST(JobsRunOnTheJsThreadWhileReattaching)
+{
+    constexpr int kJobs = 10000;
+
+    std::mutex mutex;
+    std::condition_variable posted;
+    std::deque<JsScheduler::Batch> batches;
+    bool done = false;
+    std::thread jsThread([&] {
+        Runtime runtime;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            posted.wait(lock, [&] { return done || !batches.empty(); });
+            if (batches.empty()) {
+                return;
+            }
+
+            auto batch = std::move(batches.front());
+            batches.pop_front();
+            lock.unlock();
+            batch(runtime);
+            lock.lock();
+        }
+    });
+
+    auto dispatch = [&](JsScheduler::Batch batch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batches.push_back(std::move(batch));
+        }
+        posted.notify_one();
+    };
+
+    std::atomic<int> ran{0};
+    std::vector<JsTask<void>> tasks;
+    {
+        JsScheduler scheduler;
+        scheduler.Attach(dispatch);
+        for (int i = 0; i < kJobs; ++i) {
+            tasks.push_back(scheduler.RunOnJs([&ran](Runtime &) { ++ran; }));
+            if (i % 1000 == 999) {
+                scheduler.Detach();
+                scheduler.Attach(dispatch);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    posted.notify_one();
+    jsThread.join();
+
+    // Every job either ran or was cancelled, never both
+    int completed = 0;
+    for (auto &&task : tasks) {
+        EXPECT(task.await_ready());
+        if (!IsCancelled(task)) {
+            ++completed;
+        }
+    }
+    EXPECT(completed == ran.load());
+}
+
+TEST(AwaitingCoroutinesResumeWhenJobsRunOrAreCancelled)
+{
+    FakeJsThread js{1};
+    FakeJsThread broken{0};
+    JsScheduler scheduler;
+
+    // Requested before the instance has loaded
+    std::optional<std::string> error;
+    bool completed = false;
+    LoadSegment(scheduler, error, completed);
+    EXPECT(!completed);
+
+    scheduler.Attach(js.Dispatcher());
+    js.RunAll();
+    EXPECT(completed && !error.has_value());
+
+    completed = false;
+    LoadSegment(scheduler, error, completed);
+    scheduler.Detach();
+    EXPECT(completed && error == "Reloaded");
+
+    completed = false;
+    error.reset();
+    LoadSegment(scheduler, error, completed);
+    scheduler.Attach(broken.Dispatcher());
+    broken.RunAll();
+    EXPECT(completed && error == "Bundle segment not found");
+}
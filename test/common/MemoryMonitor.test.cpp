@@ -0,0 +1,83 @@
+#include "MemoryMonitor.h"
+
+#include <memory>
+#include <vector>
+
+#include "Metrics.h"
+#include "Test.h"
+
+using ReactTestApp::MemoryBudget;
+using ReactTestApp::MemorySample;
+using ReactTestApp::Metrics;
+using ReactTestApp::ProcessMemoryInfo;
+using ReactTestApp::SampleProcessMemory;
+
+namespace
+{
+    constexpr uint64_t kMegabyte = 1024 * 1024;
+}  // namespace
+
+TEST(ProcessMemoryTracksAllocations)
+{
+    auto before = SampleProcessMemory();
+    EXPECT(before.has_value());
+    if (!before.has_value()) {
+        return;
+    }
+    EXPECT(before->residentBytes > 0);
+    EXPECT(before->peakResidentBytes >= before->residentBytes);
+
+    // Touch every page so that the allocation becomes resident
+    std::vector<char> block(64 * kMegabyte, 1);
+    auto after = SampleProcessMemory();
+    EXPECT(after.has_value() && after->residentBytes >= before->residentBytes + 32 * kMegabyte);
+    EXPECT(after.has_value() && after->peakResidentBytes >= after->residentBytes);
+    EXPECT(block.back() == 1);
+}
+
+TEST(BudgetIsParsedFromMegabytes)
+{
+    auto budget = MemoryBudget::Parse("64", "512");
+    EXPECT(budget.jsHeapBytes == 64 * kMegabyte);
+    EXPECT(budget.residentBytes == 512 * kMegabyte);
+
+    auto unlimited = MemoryBudget::Parse(nullptr, "");
+    EXPECT(!unlimited.jsHeapBytes.has_value());
+    EXPECT(!unlimited.residentBytes.has_value());
+
+    auto invalid = MemoryBudget::Parse("0", "12MB");
+    EXPECT(!invalid.jsHeapBytes.has_value());
+    EXPECT(!invalid.residentBytes.has_value());
+}
+
+TEST(BudgetIsExceededByEitherLimit)
+{
+    auto budget = MemoryBudget::Parse("64", "512");
+
+    MemorySample sample{"Example", 32 * kMegabyte, ProcessMemoryInfo{256 * kMegabyte, 0}};
+    EXPECT(!budget.IsExceededBy(sample));
+
+    sample.jsHeapBytes = 65 * kMegabyte;
+    EXPECT(budget.IsExceededBy(sample));
+
+    sample.jsHeapBytes.reset();
+    sample.process->residentBytes = 513 * kMegabyte;
+    EXPECT(budget.IsExceededBy(sample));
+
+    // Missing measurements never exceed a budget
+    sample.process.reset();
+    EXPECT(!budget.IsExceededBy(sample));
+}
+
+TEST(SamplesAreRecordedPerComponent)
+{
+    ReactTestApp::RecordMemorySample(
+        MemorySample{"Example", 16 * kMegabyte, ProcessMemoryInfo{100, 200}});
+
+    auto snapshot = Metrics::Shared().Snapshot();
+    EXPECT(snapshot.gauges["jsHeapBytes"] == static_cast<int64_t>(16 * kMegabyte));
+    EXPECT(snapshot.gauges["residentBytes"] == 100);
+    EXPECT(snapshot.gauges["peakResidentBytes"] == 200);
+    EXPECT(snapshot.gauges["memory.Example.jsHeapBytes"] == static_cast<int64_t>(16 * kMegabyte));
+    EXPECT(snapshot.gauges["memory.Example.peakResidentBytes"] == 200);
+}
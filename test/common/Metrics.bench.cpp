@@ -0,0 +1,60 @@
+// Measures update throughput of `Metrics` counters and histograms as the
+// number of threads grows. Every thread mixes counter increments with
+// histogram records on handles it shares with all other threads, like hot
+// paths reporting to the shared registry do.
+//
+// Usage: MetricsBenchmark [updates per thread] [max threads]
+
+#include "Metrics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using ReactTestApp::Metrics;
+
+int main(int argc, char *argv[])
+{
+    auto const updates = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    auto const maxThreads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    std::printf("%lu hardware threads, %lu updates per thread\n",
+                static_cast<unsigned long>(std::thread::hardware_concurrency()),
+                updates);
+    std::printf("%8s %14s %16s\n", "threads", "total (ms)", "updates/s");
+
+    for (unsigned long threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        Metrics metrics;
+        auto counter = metrics.GetCounter("calls");
+        auto histogram = metrics.GetHistogram("latency");
+
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned long i = 0; i < threadCount; ++i) {
+            threads.emplace_back([counter, histogram, updates] {
+                for (unsigned long j = 0; j < updates; ++j) {
+                    if ((j & 3) == 0) {
+                        histogram.Record(j & 0xffff);
+                    } else {
+                        counter.Increment();
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        auto const snapshot = metrics.Snapshot();
+        auto const total = snapshot.counters.at("calls") + snapshot.histograms.at("latency").count;
+        std::printf("%8lu %14.1f %16.0f\n",
+                    threadCount,
+                    elapsed.count() * 1000,
+                    static_cast<double>(total) / elapsed.count());
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "Metrics.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "ThreadShards.h"
+
+using ReactTestApp::Metrics;
+using ReactTestApp::ThreadShards;
+
+namespace
+{
+    struct Shard {
+        int value = 0;
+    };
+}  // namespace
+
+TEST(ThreadShardsKeepInstancesApart)
+{
+    ThreadShards<Shard> first;
+    ThreadShards<Shard> second;
+
+    // Alternate between instances that share a shard type
+    for (int i = 0; i < 10; ++i) {
+        first.Local().value += 1;
+        second.Local().value += 2;
+    }
+
+    EXPECT(&first.Local() != &second.Local());
+    EXPECT(first.Local().value == 10);
+    EXPECT(second.Local().value == 20);
+}
+
+TEST(ThreadShardsDoNotOutliveTheirInstance)
+{
+    for (int i = 0; i < 20; ++i) {
+        auto shards = std::make_unique<ThreadShards<Shard>>();
+        EXPECT(shards->Local().value == 0);
+        shards->Local().value = i + 1;
+    }
+}
+
+TEST(ThreadShardsHaveOneShardPerThread)
+{
+    ThreadShards<Shard> shards;
+    shards.Local().value = 1;
+
+    std::thread thread([&shards] { shards.Local().value = 2; });
+    thread.join();
+
+    int count = 0;
+    int sum = 0;
+    shards.ForEach([&](Shard const &shard) {
+        ++count;
+        sum += shard.value;
+    });
+    EXPECT(count == 2);
+    EXPECT(sum == 3);
+}
+
+TEST(SnapshotMergesUpdatesFromAllThreads)
+{
+    Metrics metrics;
+    auto counter = metrics.GetCounter("calls");
+    auto histogram = metrics.GetHistogram("latency");
+    metrics.GetGauge("items").Set(42);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([counter, histogram] {
+            for (int j = 0; j < 1000; ++j) {
+                counter.Increment();
+                histogram.Record(j);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto snapshot = metrics.Snapshot();
+    EXPECT(snapshot.counters["calls"] == 4000);
+    EXPECT(snapshot.gauges["items"] == 42);
+    EXPECT(snapshot.histograms["latency"].count == 4000);
+    EXPECT(snapshot.histograms["latency"].max == 999);
+}
+
+TEST(HandlesForTheSameNameShareAMetric)
+{
+    Metrics metrics;
+    metrics.GetCounter("reloads").Increment(2);
+    metrics.GetCounter("reloads").Increment(3);
+
+    EXPECT(metrics.Snapshot().counters["reloads"] == 5);
+}
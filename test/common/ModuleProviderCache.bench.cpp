@@ -0,0 +1,141 @@
+// Compares walking generated module provider chains on every request with
+// going through `ModuleProviderCache`. The chains are modelled after the
+// generated `autolinking_ModuleProvider` and `rncore_ModuleProvider`, which
+// compare the requested name against every module name in turn.
+//
+// Cached lookups still call the provider that has the module, which walks its
+// own chain; the cache saves walking the providers before it, and the whole
+// walk for modules that do not exist. Existence checks are answered from the
+// cache alone.
+//
+// Usage: ModuleProviderCacheBenchmark [autolinked modules] [rounds]
+
+#include "ModuleProviderCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using ReactTestApp::ModuleProviderCache;
+
+namespace
+{
+    struct Module {
+        int id;
+    };
+
+    class ProviderChain
+    {
+    public:
+        ProviderChain(char const *prefix, size_t count)
+        {
+            names_.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                names_.push_back(std::string{prefix} + "Module" + std::to_string(i));
+            }
+        }
+
+        std::string const &Name(size_t index) const
+        {
+            return names_[index];
+        }
+
+        std::shared_ptr<Module> operator()(std::string const &name) const
+        {
+            for (size_t i = 0; i < names_.size(); ++i) {
+                if (std::strcmp(name.c_str(), names_[i].c_str()) == 0) {
+                    return std::make_shared<Module>(Module{static_cast<int>(i)});
+                }
+            }
+            return nullptr;
+        }
+
+    private:
+        std::vector<std::string> names_;
+    };
+
+    template <typename Lookup>
+    double NanosecondsPerLookup(std::vector<std::string> const &requests,
+                                int rounds,
+                                Lookup const &lookup)
+    {
+        size_t found = 0;
+        auto const start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            for (auto &&name : requests) {
+                found += lookup(name) ? 1 : 0;
+            }
+        }
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+        // Keep the lookups from being optimized away
+        if (found == static_cast<size_t>(-1)) {
+            std::puts("");
+        }
+        return std::chrono::duration<double, std::nano>(elapsed).count() /
+               static_cast<double>(requests.size() * rounds);
+    }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    auto const autolinked = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    auto const rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+    constexpr size_t kCoreModules = 60;
+
+    ProviderChain autolinking{"com.example.autolinked.", autolinked};
+    ProviderChain rncore{"com.facebook.react.", kCoreModules};
+
+    // An app requires a mix of autolinked and core modules, and asks for some
+    // that do not exist, e.g. optional modules probed with `get`
+    std::mt19937 random{1};
+    std::vector<std::string> autolinkedRequests;
+    for (size_t i = 0; i < 200; ++i) {
+        autolinkedRequests.push_back(autolinking.Name(random() % autolinked));
+    }
+    std::vector<std::string> coreRequests;
+    for (size_t i = 0; i < 200; ++i) {
+        coreRequests.push_back(rncore.Name(random() % kCoreModules));
+    }
+    std::vector<std::string> missingRequests;
+    for (size_t i = 0; i < 200; ++i) {
+        missingRequests.push_back("com.example.missing.Module" + std::to_string(i));
+    }
+
+    auto const chain = [&](std::string const &name) {
+        auto module = autolinking(name);
+        return module ? module : rncore(name);
+    };
+
+    ModuleProviderCache cache;
+    auto const cached = [&](std::string const &name) {
+        return cache.Resolve(
+            name, [&]() { return autolinking(name); }, [&]() { return rncore(name); });
+    };
+    auto const contains = [&](std::string const &name) {
+        return cache.Contains(name).value_or(false);
+    };
+
+    std::printf("%lu autolinked + %zu core modules, %d rounds\n", autolinked, kCoreModules, rounds);
+    std::printf("%-12s %16s %16s %16s %16s\n",
+                "request",
+                "chains (ns)",
+                "first (ns)",
+                "cached (ns)",
+                "exists (ns)");
+    for (auto &&[label, requests] : {std::pair{"autolinked", &autolinkedRequests},
+                                     std::pair{"core", &coreRequests},
+                                     std::pair{"missing", &missingRequests}}) {
+        auto const uncached = NanosecondsPerLookup(*requests, rounds, chain);
+        auto const first = NanosecondsPerLookup(*requests, 1, cached);
+        auto const later = NanosecondsPerLookup(*requests, rounds, cached);
+        auto const exists = NanosecondsPerLookup(*requests, rounds, contains);
+        std::printf(
+            "%-12s %16.1f %16.1f %16.1f %16.1f\n", label, uncached, first, later, exists);
+    }
+    return 0;
+}
@@ -0,0 +1,281 @@
+#include "ModuleTrace.h"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+#include <unistd.h>
+
+#include "Test.h"
+
+using ReactTestApp::ModuleTraceReplayer;
+using ReactTestApp::ModuleTraceWriter;
+
+namespace ModuleTrace = ReactTestApp::ModuleTrace;
+
+namespace
+{
+    std::string TracePath(char const *name)
+    {
+        return "/tmp/rnta-trace-" + std::to_string(getpid()) + "-" + name;
+    }
+
+    std::string Tagged(ModuleTrace::Tag tag)
+    {
+        return std::string(1, static_cast<char>(tag));
+    }
+
+    std::string EncodeString(std::string_view value)
+    {
+        auto out = Tagged(ModuleTrace::kString);
+        ModuleTrace::AppendString(out, value);
+        return out;
+    }
+
+    std::string EncodeNumber(double value)
+    {
+        auto out = Tagged(ModuleTrace::kNumber);
+        ModuleTrace::AppendNumber(out, value);
+        return out;
+    }
+
+    std::string EncodeArray(std::initializer_list<std::string> values)
+    {
+        auto out = Tagged(ModuleTrace::kArray);
+        ModuleTrace::AppendVarint(out, values.size());
+        for (auto &&value : values) {
+            out += value;
+        }
+        return out;
+    }
+
+    std::string NestedArrays(int depth)
+    {
+        std::string out;
+        for (int i = 0; i < depth; ++i) {
+            out += Tagged(ModuleTrace::kArray);
+            ModuleTrace::AppendVarint(out, 1);
+        }
+        out += Tagged(ModuleTrace::kNull);
+        return out;
+    }
+}  // namespace
+
+TEST(VarintsRoundTrip)
+{
+    for (uint64_t value : {uint64_t{0},
+                           uint64_t{1},
+                           uint64_t{127},
+                           uint64_t{128},
+                           uint64_t{300},
+                           uint64_t{1} << 35,
+                           std::numeric_limits<uint64_t>::max()}) {
+        std::string out;
+        ModuleTrace::AppendVarint(out, value);
+        std::string_view in{out};
+        EXPECT(ModuleTrace::ReadVarint(in) == value);
+        EXPECT(in.empty());
+    }
+
+    std::string_view truncated{"\x80\x80"};
+    EXPECT(!ModuleTrace::ReadVarint(truncated).has_value());
+}
+
+TEST(StringsAndNumbersRoundTrip)
+{
+    std::string out;
+    ModuleTrace::AppendString(out, std::string_view{"a\0b", 3});
+    ModuleTrace::AppendString(out, "");
+    ModuleTrace::AppendNumber(out, -0.0);
+    ModuleTrace::AppendNumber(out, std::numeric_limits<double>::infinity());
+    ModuleTrace::AppendNumber(out, std::nan(""));
+    ModuleTrace::AppendNumber(out, 1.0 / 3.0);
+
+    std::string_view in{out};
+    EXPECT((ModuleTrace::ReadString(in) == std::string_view{"a\0b", 3}));
+    EXPECT(ModuleTrace::ReadString(in) == "");
+    auto zero = ModuleTrace::ReadNumber(in);
+    EXPECT(zero == 0.0 && std::signbit(*zero));
+    EXPECT(ModuleTrace::ReadNumber(in) == std::numeric_limits<double>::infinity());
+    EXPECT(std::isnan(*ModuleTrace::ReadNumber(in)));
+    EXPECT(ModuleTrace::ReadNumber(in) == 1.0 / 3.0);
+    EXPECT(in.empty());
+    EXPECT(!ModuleTrace::ReadNumber(in).has_value());
+}
+
+TEST(SkipValueReturnsEncodedBytes)
+{
+    auto object = Tagged(ModuleTrace::kObject);
+    ModuleTrace::AppendVarint(object, 2);
+    ModuleTrace::AppendString(object, "name");
+    object += EncodeString("value");
+    ModuleTrace::AppendString(object, "list");
+    object += EncodeArray(
+        {EncodeNumber(1), Tagged(ModuleTrace::kTrue), Tagged(ModuleTrace::kPromise)});
+
+    auto encoded = object + Tagged(ModuleTrace::kNull);
+    std::string_view in{encoded};
+    EXPECT(ModuleTrace::SkipValue(in) == object);
+    EXPECT(ModuleTrace::SkipValue(in) == Tagged(ModuleTrace::kNull));
+    EXPECT(in.empty());
+}
+
+TEST(SkipValueRejectsMalformedInput)
+{
+    for (std::string encoded : {std::string{},
+                                std::string{"\xff"},
+                                EncodeNumber(1).substr(0, 5),
+                                EncodeString("abc").substr(0, 3),
+                                EncodeArray({EncodeNumber(1), EncodeNumber(2)}).substr(0, 12)}) {
+        std::string_view in{encoded};
+        EXPECT(!ModuleTrace::SkipValue(in).has_value());
+    }
+}
+
+TEST(SkipValueLimitsNesting)
+{
+    // The encoder expands objects up to 32 levels deep
+    auto deepest = NestedArrays(32);
+    std::string_view in{deepest};
+    EXPECT(ModuleTrace::SkipValue(in) == deepest);
+
+    auto tooDeep = NestedArrays(33);
+    in = tooDeep;
+    EXPECT(!ModuleTrace::SkipValue(in).has_value());
+
+    // Must fail rather than overflow the stack
+    auto hostile = NestedArrays(1000000);
+    in = hostile;
+    EXPECT(!ModuleTrace::SkipValue(in).has_value());
+}
+
+TEST(RecordedTraceReplaysInOrder)
+{
+    auto path = TracePath("replay");
+    auto args = EncodeArray({EncodeString("key")});
+    {
+        ModuleTraceWriter writer{path};
+        EXPECT(writer.IsOpen());
+        writer.RecordCall(
+            "Storage", "get", args, EncodeString("first"), std::chrono::nanoseconds{10});
+        writer.RecordCall(
+            "Storage", "get", args, EncodeString("second"), std::chrono::nanoseconds{20});
+        auto seq = writer.RecordCall("Storage",
+                                     "load",
+                                     EncodeArray({}),
+                                     Tagged(ModuleTrace::kPromise),
+                                     std::chrono::nanoseconds{30});
+        writer.RecordResolve(seq, EncodeNumber(42), std::chrono::nanoseconds{40});
+        writer.Flush();
+    }
+
+    ModuleTraceReplayer replayer;
+    EXPECT(replayer.Load(path));
+    std::remove(path.c_str());
+
+    auto first = replayer.Next("Storage", "get", args);
+    EXPECT(first.has_value() && first->result == EncodeString("first"));
+    EXPECT(first->duration == std::chrono::nanoseconds{10});
+    auto second = replayer.Next("Storage", "get", args);
+    EXPECT(second.has_value() && second->result == EncodeString("second"));
+    EXPECT(!second->resolution.has_value());
+
+    auto load = replayer.Next("Storage", "load", EncodeArray({}));
+    EXPECT(load.has_value() && load->result == Tagged(ModuleTrace::kPromise));
+    EXPECT(load->resolution == EncodeNumber(42));
+    EXPECT(load->duration == std::chrono::nanoseconds{40});
+
+    EXPECT(replayer.Misses() == 0);
+    EXPECT(!replayer.Next("Storage", "get", args).has_value());
+    EXPECT(!replayer.Next("Storage", "get", EncodeArray({})).has_value());
+    EXPECT(replayer.Misses() == 2);
+}
+
+TEST(RecordsReachTheFileWithoutFlush)
+{
+    // The process is usually killed rather than shut down, so the writer is
+    // neither flushed nor destroyed
+    auto path = TracePath("unflushed");
+    ModuleTraceWriter writer{path};
+    writer.RecordCall("A", "a", EncodeArray({}), EncodeNumber(1), std::chrono::nanoseconds{1});
+
+    ModuleTraceReplayer replayer;
+    EXPECT(replayer.Load(path));
+    auto call = replayer.Next("A", "a", EncodeArray({}));
+    EXPECT(call.has_value() && call->result == EncodeNumber(1));
+
+    std::remove(path.c_str());
+}
+
+TEST(TruncatedTraceLoadsCompleteRecords)
+{
+    std::string trace = "RNTA\x01";
+    trace += '\x01';
+    ModuleTrace::AppendVarint(trace, 0);
+    ModuleTrace::AppendString(trace, "A");
+    ModuleTrace::AppendString(trace, "a");
+    trace += EncodeArray({});
+    trace += Tagged(ModuleTrace::kPromise);
+    ModuleTrace::AppendVarint(trace, 1);
+    auto const complete = trace.size();
+    trace += '\x02';
+    ModuleTrace::AppendVarint(trace, 0);
+    trace += EncodeNumber(2);
+    ModuleTrace::AppendVarint(trace, 2);
+
+    // Cut the resolve record short at every possible point
+    for (auto size = complete; size < trace.size(); ++size) {
+        ModuleTraceReplayer replayer;
+        EXPECT(replayer.Parse(std::string_view{trace}.substr(0, size)));
+        auto call = replayer.Next("A", "a", EncodeArray({}));
+        EXPECT(call.has_value() && call->result == Tagged(ModuleTrace::kPromise));
+        EXPECT(!call->resolution.has_value());
+    }
+
+    ModuleTraceReplayer replayer;
+    EXPECT(replayer.Parse(trace));
+    EXPECT(replayer.Next("A", "a", EncodeArray({}))->resolution == EncodeNumber(2));
+}
+
+TEST(MalformedTraceKeepsLoadedCalls)
+{
+    auto path = TracePath("malformed");
+    {
+        ModuleTraceWriter writer{path};
+        writer.RecordCall("A", "a", EncodeArray({}), EncodeNumber(1), std::chrono::nanoseconds{1});
+    }
+
+    ModuleTraceReplayer replayer;
+    EXPECT(replayer.Load(path));
+
+    // A valid call followed by a record of unknown type
+    std::string trace = "RNTA\x01";
+    trace += '\x01';
+    ModuleTrace::AppendVarint(trace, 0);
+    ModuleTrace::AppendString(trace, "B");
+    ModuleTrace::AppendString(trace, "b");
+    trace += EncodeArray({});
+    trace += EncodeNumber(2);
+    ModuleTrace::AppendVarint(trace, 1);
+    trace += '\x07';
+    ModuleTrace::AppendVarint(trace, 1);
+    EXPECT(!replayer.Parse(trace));
+
+    EXPECT(!replayer.Next("B", "b", EncodeArray({})).has_value());
+    auto call = replayer.Next("A", "a", EncodeArray({}));
+    EXPECT(call.has_value() && call->result == EncodeNumber(1));
+
+    std::remove(path.c_str());
+    EXPECT(!replayer.Load(path));
+}
+
+TEST(RejectsUnknownHeader)
+{
+    ModuleTraceReplayer replayer;
+    EXPECT(!replayer.Parse(""));
+    EXPECT(!replayer.Parse("RNTA"));
+    EXPECT(!replayer.Parse("RNTA\x02"));
+    EXPECT(!replayer.Parse("XNTA\x01"));
+    EXPECT(replayer.Parse(std::string_view{"RNTA\x01", 5}));
+}
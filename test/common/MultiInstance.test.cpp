@@ -0,0 +1,179 @@
+#include "MultiInstance.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Metrics.h"
+#include "Test.h"
+
+using ReactTestApp::Metrics;
+using ReactTestApp::MultiInstanceOptions;
+using ReactTestApp::MultiInstanceResult;
+using ReactTestApp::MultiInstanceTracker;
+
+TEST(OptionsNeedAtLeastTwoInstances)
+{
+    unsetenv("REACT_TEST_APP_INSTANCE_PORTS");
+
+    unsetenv("REACT_TEST_APP_INSTANCES");
+    EXPECT(!MultiInstanceOptions::FromEnvironment().has_value());
+
+    setenv("REACT_TEST_APP_INSTANCES", "1", 1);
+    EXPECT(!MultiInstanceOptions::FromEnvironment().has_value());
+
+    setenv("REACT_TEST_APP_INSTANCES", "x4", 1);
+    EXPECT(!MultiInstanceOptions::FromEnvironment().has_value());
+
+    setenv("REACT_TEST_APP_INSTANCES", "-3", 1);
+    EXPECT(!MultiInstanceOptions::FromEnvironment().has_value());
+
+    setenv("REACT_TEST_APP_INSTANCES", "3", 1);
+    auto options = MultiInstanceOptions::FromEnvironment();
+    EXPECT(options.has_value() && options->instances == 3);
+    EXPECT(options.has_value() && options->bundlerPorts.empty());
+}
+
+TEST(InvalidPortsAreLeftUnset)
+{
+    setenv("REACT_TEST_APP_INSTANCES", "4", 1);
+    setenv("REACT_TEST_APP_INSTANCE_PORTS", "8082,,99999,8084", 1);
+
+    auto options = MultiInstanceOptions::FromEnvironment();
+    EXPECT(options.has_value() && options->instances == 4);
+    EXPECT(options.has_value() && (options->bundlerPorts == std::vector<int>{8082, 0, 0, 8084}));
+
+    unsetenv("REACT_TEST_APP_INSTANCES");
+    unsetenv("REACT_TEST_APP_INSTANCE_PORTS");
+}
+
+TEST(TrackerCompletesOnceEveryInstanceHasReported)
+{
+    int calls = 0;
+    MultiInstanceResult result;
+    auto completion = [&](MultiInstanceResult const &r) {
+        ++calls;
+        result = r;
+    };
+    MultiInstanceTracker tracker{3, completion};
+
+    tracker.OnLoaded(0, {"Example"});
+    tracker.OnLoaded(0, {"ReportedAgain"});
+    tracker.OnFailed(7, "Out of range");
+    tracker.OnFailed(1, {});
+    EXPECT(calls == 0);
+
+    tracker.OnLoaded(2, {"Example", "Settings"});
+    EXPECT(calls == 1);
+
+    // Reloads after the run are ignored
+    tracker.OnLoaded(1, {"Late"});
+    EXPECT(calls == 1);
+
+    EXPECT(result.instances.size() == 3);
+    EXPECT(result.instances[0].appKeys == std::vector<std::string>{"Example"});
+    EXPECT(result.instances[1].error == "Unknown error");
+    EXPECT(result.instances[2].appKeys.size() == 2);
+    EXPECT(result.instances[2].duration >= result.instances[0].duration);
+    EXPECT(result.duration >= result.instances[2].duration);
+    EXPECT(result.baselineResidentBytes.has_value());
+    EXPECT(result.finalResidentBytes.has_value());
+}
+
+TEST(TrackerAcceptsReportsFromAnyThread)
+{
+    constexpr size_t kInstances = 16;
+
+    std::atomic<int> calls{0};
+    MultiInstanceResult result;
+    auto completion = [&](MultiInstanceResult const &r) {
+        result = r;
+        ++calls;
+    };
+    MultiInstanceTracker tracker{kInstances, completion};
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kInstances; ++i) {
+        threads.emplace_back([&tracker, i]() {
+            tracker.OnLoaded(i, {"App" + std::to_string(i)});
+            tracker.OnFailed(i, "Reported twice");
+        });
+    }
+    for (auto &&thread : threads) {
+        thread.join();
+    }
+
+    EXPECT(calls == 1);
+    EXPECT(result.instances.size() == kInstances);
+    for (size_t i = 0; i < result.instances.size(); ++i) {
+        EXPECT(result.instances[i].error.empty());
+        EXPECT(result.instances[i].appKeys == std::vector<std::string>{"App" + std::to_string(i)});
+    }
+}
+
+TEST(TrackerRecordsMetrics)
+{
+    auto const before = Metrics::Shared().Snapshot();
+    auto const it = before.histograms.find("instanceLoadMicroseconds");
+    auto const recorded = it == before.histograms.end() ? 0 : it->second.count;
+
+    MultiInstanceTracker tracker{2, {}};
+    tracker.OnLoaded(0, {"Example"});
+    tracker.OnFailed(1, "SyntaxError");
+
+    // Only successful loads count towards load times
+    auto const after = Metrics::Shared().Snapshot();
+    EXPECT(after.histograms.at("instanceLoadMicroseconds").count == recorded + 1);
+}
+
+TEST(MemoryIsSplitBetweenLoadedInstances)
+{
+    MultiInstanceResult result;
+    result.instances.resize(3);
+    EXPECT(!result.ResidentBytesPerInstance().has_value());
+
+    result.instances[1].error = "SyntaxError";
+    result.baselineResidentBytes = 100;
+    result.finalResidentBytes = 500;
+    EXPECT(result.ResidentBytesPerInstance() == 200u);
+
+    // Memory returned to the system must not wrap around
+    result.finalResidentBytes = 50;
+    EXPECT(result.ResidentBytesPerInstance() == 0u);
+
+    result.instances[0].error = "SyntaxError";
+    result.instances[2].error = "SyntaxError";
+    EXPECT(!result.ResidentBytesPerInstance().has_value());
+}
+
+TEST(ResultIsSerializedToJSON)
+{
+    MultiInstanceResult result;
+    result.duration = std::chrono::microseconds{1500};
+    result.baselineResidentBytes = 1000;
+    result.instances.resize(2);
+    result.instances[0].appKeys = {"Example", "Settings"};
+    result.instances[0].duration = std::chrono::microseconds{1200};
+    result.instances[1].error = "Unexpected \"token\"";
+
+    EXPECT(result.ToJSON() ==
+           "{\"durationMicroseconds\":1500,\"baselineResidentBytes\":1000,"
+           "\"finalResidentBytes\":null,\"residentBytesPerInstance\":null,\"instances\":["
+           "{\"appKeys\":[\"Example\",\"Settings\"],\"durationMicroseconds\":1200,\"error\":null},"
+           "{\"appKeys\":[],\"durationMicroseconds\":0,\"error\":\"Unexpected \\\"token\\\"\"}]}");
+}
+
+TEST(HeadlessInstancesNeedJSI)
+{
+    // This build has no JS engine, so every instance reports that instead of
+    // hanging the run
+    auto const result = ReactTestApp::RunHeadlessInstances(3, {}, nullptr, "index.bundle");
+    EXPECT(result.instances.size() == 3);
+    for (auto &&instance : result.instances) {
+        EXPECT(instance.error == "JSI is not available");
+    }
+
+    EXPECT(ReactTestApp::RunHeadlessInstances(0, {}, nullptr, {}).instances.empty());
+}
@@ -0,0 +1,157 @@
+#include "ReloadStress.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "LiveObjects.h"
+#include "Test.h"
+
+using ReactTestApp::EvaluateReloadStress;
+using ReactTestApp::GetLiveObjectCounter;
+using ReactTestApp::GetLiveObjectCounts;
+using ReactTestApp::LiveObject;
+using ReactTestApp::ReloadStressDriver;
+using ReactTestApp::ReloadStressOptions;
+using ReactTestApp::ReloadStressResult;
+using ReactTestApp::ReloadStressSample;
+using ReactTestApp::TrackLifetime;
+
+namespace
+{
+    struct Module {
+        int value = 0;
+    };
+
+    /**
+     * Stands in for a React instance: owns a runtime and a few native
+     * modules, and optionally leaks a module on every reload.
+     */
+    class FakeInstance
+    {
+    public:
+        explicit FakeInstance(bool leak) : leak_(leak)
+        {
+        }
+
+        void Reload()
+        {
+            runtime_.reset();
+            modules_.clear();
+
+            runtime_.emplace(GetLiveObjectCounter("test.runtimes"));
+            static auto &modules = GetLiveObjectCounter("test.modules");
+            for (int i = 0; i < 3; ++i) {
+                modules_.push_back(TrackLifetime(std::make_shared<Module>(), modules));
+            }
+            if (leak_) {
+                leaked_.push_back(modules_.back());
+            }
+        }
+
+    private:
+        bool leak_;
+        std::optional<LiveObject> runtime_;
+        std::vector<std::shared_ptr<Module>> modules_;
+        std::vector<std::shared_ptr<Module>> leaked_;
+    };
+
+    std::optional<ReloadStressResult> RunStress(FakeInstance &instance, int iterations)
+    {
+        ReloadStressOptions options;
+        options.iterations = iterations;
+        options.objectTolerance = 1;
+        // Resident memory is too noisy in a test process to assert on
+        options.memoryTolerance = 100.0;
+
+        std::optional<ReloadStressResult> result;
+        bool reloadRequested = false;
+        ReloadStressDriver driver{
+            options,
+            [&reloadRequested] { reloadRequested = true; },
+            [&result](ReloadStressResult const &r) { result = r; }};
+
+        // Reload the way a host would: asynchronously, then report back
+        driver.Start();
+        while (reloadRequested) {
+            reloadRequested = false;
+            instance.Reload();
+            driver.OnReloaded();
+        }
+
+        EXPECT(!driver.IsRunning());
+        return result;
+    }
+}  // namespace
+
+TEST(LiveObjectsAreCounted)
+{
+    auto &counter = GetLiveObjectCounter("test.counted");
+    {
+        LiveObject first{counter};
+        LiveObject copy{first};
+        EXPECT(counter.Count() == 2);
+        EXPECT(GetLiveObjectCounts()["test.counted"] == 2);
+    }
+    EXPECT(counter.Count() == 0);
+}
+
+TEST(TrackedPointersCountUntilTheLastCopyIsReleased)
+{
+    auto &counter = GetLiveObjectCounter("test.tracked");
+    auto object = TrackLifetime(std::make_shared<Module>(), counter);
+    auto copy = object;
+    EXPECT(counter.Count() == 1);
+
+    object.reset();
+    EXPECT(counter.Count() == 1);
+    copy.reset();
+    EXPECT(counter.Count() == 0);
+
+    EXPECT(TrackLifetime(std::shared_ptr<Module>{}, counter) == nullptr);
+    EXPECT(counter.Count() == 0);
+}
+
+TEST(StressPassesWithoutLeaks)
+{
+    FakeInstance instance{false};
+    auto result = RunStress(instance, 10);
+
+    EXPECT(result.has_value());
+    if (result.has_value()) {
+        EXPECT(result->Passed());
+        EXPECT(result->iterations == 10);
+        EXPECT(result->final.liveObjects["test.runtimes"] == 1);
+        EXPECT(result->final.liveObjects["test.modules"] == 3);
+    }
+}
+
+TEST(StressFailsWhenModulesLeak)
+{
+    FakeInstance instance{true};
+    auto result = RunStress(instance, 10);
+
+    EXPECT(result.has_value());
+    if (result.has_value()) {
+        EXPECT(!result->Passed());
+        EXPECT(result->failures.size() == 1);
+        EXPECT(result->ToJSON().find("\"passed\":false") != std::string::npos);
+    }
+}
+
+TEST(MemoryGrowthBeyondToleranceFails)
+{
+    ReloadStressOptions options;
+    options.memoryTolerance = 0.1;
+
+    ReloadStressSample baseline;
+    baseline.residentBytes = 100 * 1024 * 1024;
+    ReloadStressSample grown;
+    grown.residentBytes = 105 * 1024 * 1024;
+    EXPECT(EvaluateReloadStress(options, baseline, grown).Passed());
+
+    grown.residentBytes = 120 * 1024 * 1024;
+    auto result = EvaluateReloadStress(options, baseline, grown);
+    EXPECT(!result.Passed());
+    EXPECT(result.failures.size() == 1);
+}
@@ -0,0 +1,74 @@
+#include "ResizeCoalescer.h"
+
+#include "Test.h"
+
+using ReactTestApp::LogicalSize;
+using ReactTestApp::ResizeCoalescer;
+
+TEST(FirstFlushArrangesLogicalSize)
+{
+    ResizeCoalescer coalescer{2.0f};
+    EXPECT(coalescer.Resize(800, 600));
+
+    auto size = coalescer.Flush();
+    EXPECT(size.has_value());
+    EXPECT((size == LogicalSize{400, 300}));
+}
+
+TEST(ResizesWithinAFrameAreCoalesced)
+{
+    ResizeCoalescer coalescer{1.0f};
+    EXPECT(coalescer.Resize(100, 100));
+    EXPECT(!coalescer.Resize(200, 200));
+    EXPECT(!coalescer.Resize(300, 200));
+
+    EXPECT((coalescer.Flush() == LogicalSize{300, 200}));
+
+    // A new frame is requested once the previous one has been flushed
+    EXPECT(coalescer.Resize(400, 200));
+}
+
+TEST(UnchangedSizeIsNotArrangedAgain)
+{
+    ResizeCoalescer coalescer{1.0f};
+    coalescer.Resize(100, 100);
+    EXPECT(coalescer.Flush().has_value());
+
+    EXPECT(coalescer.Resize(100, 100));
+    EXPECT(!coalescer.Flush().has_value());
+
+    // Growing and shrinking back within a frame is a no-op as well
+    coalescer.Resize(200, 200);
+    coalescer.Resize(100, 100);
+    EXPECT(!coalescer.Flush().has_value());
+}
+
+TEST(RescaleChangesLogicalSize)
+{
+    ResizeCoalescer coalescer{1.0f};
+    coalescer.Resize(300, 300);
+    coalescer.Flush();
+
+    EXPECT(coalescer.Rescale(1.5f));
+    EXPECT(coalescer.ScaleFactor() == 1.5f);
+    EXPECT((coalescer.Flush() == LogicalSize{200, 200}));
+}
+
+TEST(RescaleIgnoresSameOrInvalidScaleFactor)
+{
+    ResizeCoalescer coalescer{1.0f};
+    EXPECT(!coalescer.Rescale(1.0f));
+    EXPECT(!coalescer.Rescale(0.0f));
+    EXPECT(!coalescer.Rescale(-1.0f));
+    EXPECT(coalescer.ScaleFactor() == 1.0f);
+}
+
+TEST(ResetForcesNextArrange)
+{
+    ResizeCoalescer coalescer{1.0f};
+    coalescer.Resize(100, 100);
+    coalescer.Flush();
+
+    coalescer.Reset();
+    EXPECT((coalescer.Flush() == LogicalSize{100, 100}));
+}
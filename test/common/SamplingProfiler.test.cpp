@@ -0,0 +1,52 @@
+#include "SamplingProfiler.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "Test.h"
+
+using ReactTestApp::SamplingProfiler;
+
+namespace
+{
+    std::string WriteProfile(char const *name, std::string_view contents)
+    {
+        auto path = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream(path, std::ios::trunc) << contents;
+        return path;
+    }
+}  // namespace
+
+TEST(WithoutHermesSamplingIsUnsupported)
+{
+    // The test build does not define `USE_HERMES`
+    EXPECT(!SamplingProfiler::IsAvailable());
+
+    SamplingProfiler profiler;
+    EXPECT(!profiler.Start("test"));
+    EXPECT(!profiler.IsRunning());
+    EXPECT(!profiler.Stop().has_value());
+}
+
+TEST(ProfileWithSamplesIsRecognized)
+{
+    auto path = WriteProfile("rnta-sampled.cpuprofile",
+                             R"({"traceEvents":[],"samples": [ {"cpu":"-1","ts":"1","sf":1} ],)"
+                             R"("stackFrames":{"1":{"name":"render"}}})");
+    EXPECT(SamplingProfiler::HasSamples(path));
+    std::filesystem::remove(path);
+}
+
+TEST(ProfileWithoutSamplesIsRecognized)
+{
+    auto empty = WriteProfile("rnta-empty.cpuprofile",
+                              R"({"traceEvents":[],"samples":[  ],"stackFrames":{}})");
+    EXPECT(!SamplingProfiler::HasSamples(empty));
+    std::filesystem::remove(empty);
+
+    auto truncated = WriteProfile("rnta-truncated.cpuprofile", R"({"samples":)");
+    EXPECT(!SamplingProfiler::HasSamples(truncated));
+    std::filesystem::remove(truncated);
+
+    EXPECT(!SamplingProfiler::HasSamples("/nonexistent/rnta.cpuprofile"));
+}
@@ -0,0 +1,143 @@
+#include "StallWatchdog.h"
+
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+
+using ReactTestApp::GetStallThreshold;
+using ReactTestApp::StallEvent;
+using ReactTestApp::StallWatchdog;
+using namespace std::chrono_literals;
+
+namespace
+{
+    /**
+     * Stands in for the JS thread: runs posted tasks in order on its own
+     * thread.
+     */
+    class TaskThread
+    {
+    public:
+        TaskThread() : thread_([this] { Run(); })
+        {
+        }
+
+        ~TaskThread()
+        {
+            Post(nullptr);
+            thread_.join();
+        }
+
+        void Post(StallWatchdog::Task task)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+            wake_.notify_one();
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::deque<StallWatchdog::Task> tasks_;
+        std::thread thread_;
+
+        void Run()
+        {
+            while (true) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return !tasks_.empty(); });
+                auto task = std::move(tasks_.front());
+                tasks_.pop_front();
+                lock.unlock();
+
+                if (!task) {
+                    return;
+                }
+                task();
+            }
+        }
+    };
+
+    class EventLog
+    {
+    public:
+        StallWatchdog::Listener Listener()
+        {
+            return [this](StallEvent const &event) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                events_.push_back(event);
+            };
+        }
+
+        std::vector<StallEvent> Events()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return events_;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::vector<StallEvent> events_;
+    };
+}  // namespace
+
+TEST(ResponsiveThreadIsNotReported)
+{
+    EventLog log;
+    TaskThread js;
+    {
+        StallWatchdog watchdog{
+            50ms, [&js](StallWatchdog::Task task) { js.Post(std::move(task)); }, log.Listener()};
+        std::this_thread::sleep_for(300ms);
+    }
+
+    EXPECT(log.Events().empty());
+}
+
+TEST(StallIsReportedAndRecoveryIsTimed)
+{
+    EventLog log;
+    TaskThread js;
+    {
+        StallWatchdog watchdog{
+            50ms, [&js](StallWatchdog::Task task) { js.Post(std::move(task)); }, log.Listener()};
+        std::this_thread::sleep_for(100ms);
+        js.Post([] { std::this_thread::sleep_for(400ms); });
+        std::this_thread::sleep_for(700ms);
+    }
+
+    auto events = log.Events();
+    EXPECT(events.size() == 2);
+    if (events.size() == 2) {
+        EXPECT(events[0].phase == StallEvent::Phase::Stalled);
+        EXPECT(events[0].duration >= 50ms);
+        EXPECT(events[1].phase == StallEvent::Phase::Recovered);
+        EXPECT(events[1].duration >= 300ms);
+        EXPECT(events[1].duration <= 500ms);
+    }
+}
+
+TEST(WatchdogIsOptIn)
+{
+    unsetenv("REACT_TEST_APP_STALL_THRESHOLD_MS");
+    EXPECT(!GetStallThreshold().has_value());
+
+    setenv("REACT_TEST_APP_STALL_THRESHOLD_MS", "", 1);
+    EXPECT(!GetStallThreshold().has_value());
+
+    setenv("REACT_TEST_APP_STALL_THRESHOLD_MS", "0", 1);
+    EXPECT(!GetStallThreshold().has_value());
+
+    setenv("REACT_TEST_APP_STALL_THRESHOLD_MS", "1s", 1);
+    EXPECT(!GetStallThreshold().has_value());
+
+    setenv("REACT_TEST_APP_STALL_THRESHOLD_MS", "250", 1);
+    EXPECT(GetStallThreshold() == 250ms);
+
+    unsetenv("REACT_TEST_APP_STALL_THRESHOLD_MS");
+}
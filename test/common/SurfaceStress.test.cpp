@@ -0,0 +1,214 @@
+#include "SurfaceStress.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AppRegistry.h"
+#include "Metrics.h"
+#include "Test.h"
+
+// `RunHeadlessSurfaces` only passes the runtime on to `RunApplication`,
+// which is replaced below, so a stand-in is enough
+namespace facebook::jsi
+{
+    class Runtime
+    {
+    public:
+        std::set<int> rootTags;
+        int failingRootTag = -1;
+    };
+}  // namespace facebook::jsi
+
+using facebook::jsi::Runtime;
+using ReactTestApp::Metrics;
+using ReactTestApp::SurfaceStressOptions;
+using ReactTestApp::SurfaceStressResult;
+using ReactTestApp::SurfaceStressTracker;
+
+std::vector<std::string> ReactTestApp::GetAppKeys(Runtime &)
+{
+    return {};
+}
+
+bool ReactTestApp::RunApplication(Runtime &runtime, std::string const &, int rootTag)
+{
+    if (rootTag == runtime.failingRootTag) {
+        throw std::runtime_error("Invariant Violation");
+    }
+
+    runtime.rootTags.insert(rootTag);
+    return true;
+}
+
+TEST(OptionsNeedAPositiveSurfaceCount)
+{
+    unsetenv("REACT_TEST_APP_SURFACE_COMPONENT");
+
+    unsetenv("REACT_TEST_APP_SURFACES");
+    EXPECT(!SurfaceStressOptions::FromEnvironment().has_value());
+
+    for (auto value : {"", "0", "-4", "8x"}) {
+        setenv("REACT_TEST_APP_SURFACES", value, 1);
+        EXPECT(!SurfaceStressOptions::FromEnvironment().has_value());
+    }
+
+    setenv("REACT_TEST_APP_SURFACES", "32", 1);
+    auto options = SurfaceStressOptions::FromEnvironment();
+    EXPECT(options.has_value() && options->surfaces == 32 && options->component.empty());
+
+    setenv("REACT_TEST_APP_SURFACE_COMPONENT", "example-list", 1);
+    options = SurfaceStressOptions::FromEnvironment();
+    EXPECT(options.has_value() && options->component == "example-list");
+
+    unsetenv("REACT_TEST_APP_SURFACES");
+    unsetenv("REACT_TEST_APP_SURFACE_COMPONENT");
+}
+
+TEST(TrackerCompletesOnceEverySurfaceHasMounted)
+{
+    int calls = 0;
+    SurfaceStressResult result;
+    auto completion = [&](SurfaceStressResult const &r) {
+        ++calls;
+        result = r;
+    };
+    SurfaceStressTracker tracker{"Example", 3, completion};
+    EXPECT(tracker.IsRunning());
+
+    tracker.OnMounted(1);
+    tracker.OnMounted(1);
+    tracker.OnMounted(3);
+    tracker.OnMounted(0);
+    EXPECT(calls == 0);
+
+    tracker.OnMounted(2);
+    EXPECT(calls == 1);
+    EXPECT(!tracker.IsRunning());
+
+    // Neither late reports nor finishing again complete the run twice
+    tracker.OnMounted(0);
+    tracker.Finish();
+    EXPECT(calls == 1);
+
+    EXPECT(result.component == "Example");
+    EXPECT(result.MountedSurfaces() == 3);
+    EXPECT(result.mountDurations[0] >= result.mountDurations[1]);
+    EXPECT(result.duration >= *result.mountDurations[2]);
+    EXPECT(result.baselineResidentBytes.has_value());
+    EXPECT(result.finalResidentBytes.has_value());
+}
+
+TEST(FinishReportsSurfacesThatNeverMounted)
+{
+    int calls = 0;
+    SurfaceStressResult result;
+    auto completion = [&](SurfaceStressResult const &r) {
+        ++calls;
+        result = r;
+    };
+    SurfaceStressTracker tracker{"Example", 4, completion};
+    tracker.OnMounted(2);
+    tracker.Finish();
+    tracker.OnMounted(0);
+
+    EXPECT(calls == 1);
+    EXPECT(result.mountDurations.size() == 4);
+    EXPECT(result.MountedSurfaces() == 1);
+    EXPECT(!result.mountDurations[0].has_value());
+    EXPECT(result.mountDurations[2].has_value());
+}
+
+TEST(TrackerAcceptsReportsFromAnyThread)
+{
+    constexpr size_t kSurfaces = 64;
+
+    std::atomic<int> calls{0};
+    SurfaceStressResult result;
+    auto completion = [&](SurfaceStressResult const &r) {
+        result = r;
+        ++calls;
+    };
+    SurfaceStressTracker tracker{"Example", kSurfaces, completion};
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&tracker, i]() {
+            for (size_t surface = i; surface < kSurfaces; surface += 2) {
+                tracker.OnMounted(surface);
+            }
+        });
+    }
+    for (auto &&thread : threads) {
+        thread.join();
+    }
+
+    EXPECT(calls == 1);
+    EXPECT(result.MountedSurfaces() == kSurfaces);
+}
+
+TEST(MountTimesAreRecordedToMetrics)
+{
+    auto count = [] {
+        auto snapshot = Metrics::Shared().Snapshot();
+        auto it = snapshot.histograms.find("surfaceMountMicroseconds");
+        return it == snapshot.histograms.end() ? 0 : it->second.count;
+    };
+
+    auto const before = count();
+    SurfaceStressTracker tracker{"Example", 2, {}};
+    tracker.OnMounted(0);
+    tracker.OnMounted(1);
+    EXPECT(count() == before + 2);
+}
+
+TEST(MemoryIsSplitBetweenMountedSurfaces)
+{
+    SurfaceStressResult result;
+    result.mountDurations = {
+        std::chrono::microseconds{10},
+        std::nullopt,
+        std::chrono::microseconds{20},
+    };
+    EXPECT(!result.ResidentBytesPerSurface().has_value());
+
+    result.baselineResidentBytes = 1000;
+    result.finalResidentBytes = 3000;
+    EXPECT(result.ResidentBytesPerSurface() == 1000u);
+
+    result.finalResidentBytes = 500;
+    EXPECT(result.ResidentBytesPerSurface() == 0u);
+}
+
+TEST(ResultIsSerializedToJSON)
+{
+    SurfaceStressResult result;
+    result.component = "Example \"List\"";
+    result.mountDurations = {std::chrono::microseconds{100}, std::nullopt};
+    result.duration = std::chrono::microseconds{250};
+
+    auto const json = result.ToJSON();
+    EXPECT(json.rfind("{\"component\":\"Example \\\"List\\\"\",\"surfaces\":2,"
+                      "\"mountedSurfaces\":1,\"durationMicroseconds\":250,"
+                      "\"mountMicroseconds\":{",
+                      0) == 0);
+    EXPECT(json.find(",\"baselineResidentBytes\":null,\"finalResidentBytes\":null,"
+                     "\"residentBytesPerSurface\":null}") != std::string::npos);
+}
+
+TEST(HeadlessSurfacesGetDistinctRootTags)
+{
+    Runtime runtime;
+    runtime.failingRootTag = 31;
+
+    auto const result = ReactTestApp::RunHeadlessSurfaces(runtime, "Example", 5);
+    EXPECT(result.component == "Example");
+    EXPECT(result.mountDurations.size() == 5);
+    EXPECT(result.MountedSurfaces() == 4);
+    EXPECT(!result.mountDurations[3].has_value());
+    EXPECT((runtime.rootTags == std::set<int>{1, 11, 21, 41}));
+}
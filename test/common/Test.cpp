@@ -0,0 +1,56 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <exception>
+#include <vector>
+
+namespace
+{
+    struct TestCase {
+        char const *name;
+        void (*run)();
+    };
+
+    std::vector<TestCase> &TestCases()
+    {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    int failures = 0;
+}  // namespace
+
+bool ReactTestApp::Test::Register(char const *name, void (*test)())
+{
+    TestCases().push_back({name, test});
+    return true;
+}
+
+void ReactTestApp::Test::Fail(char const *file, int line, char const *expression)
+{
+    std::fprintf(stderr, "%s:%d: expected %s\n", file, line, expression);
+    ++failures;
+}
+
+int main()
+{
+    size_t failed = 0;
+    for (auto &&testCase : TestCases()) {
+        auto const before = failures;
+        try {
+            testCase.run();
+        } catch (std::exception const &e) {
+            std::fprintf(stderr, "%s: uncaught exception: %s\n", testCase.name, e.what());
+            ++failures;
+        }
+
+        auto const passed = failures == before;
+        std::printf("%s %s\n", passed ? "ok  " : "FAIL", testCase.name);
+        if (!passed) {
+            ++failed;
+        }
+    }
+
+    std::printf("%zu passed, %zu failed\n", TestCases().size() - failed, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+#ifndef TEST_COMMON_TEST_
+#define TEST_COMMON_TEST_
+
+namespace ReactTestApp::Test
+{
+    /**
+     * Registers a test case to be run by the test binary. Use `TEST` instead
+     * of calling this directly.
+     */
+    bool Register(char const *name, void (*test)());
+
+    /**
+     * Reports a failed expectation. The current test case keeps running, but
+     * the test binary exits with a non-zero status.
+     */
+    void Fail(char const *file, int line, char const *expression);
+}  // namespace ReactTestApp::Test
+
+#define TEST(name)                                                                                 \
+    static void name();                                                                            \
+    static bool const name##Registered = ReactTestApp::Test::Register(#name, name);                \
+    static void name()
+
+#define EXPECT(expression)                                                                         \
+    ((expression) ? static_cast<void>(0)                                                           \
+                  : ReactTestApp::Test::Fail(__FILE__, __LINE__, #expression))
+
+#endif  // TEST_COMMON_TEST_
@@ -0,0 +1,90 @@
+#include "ThreadPolicy.h"
+
+#include <thread>
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Test.h"
+
+using ReactTestApp::ApplyThreadPolicy;
+using ReactTestApp::ThreadPolicy;
+
+namespace
+{
+    int CurrentNiceValue()
+    {
+        return getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    }
+
+    // Policies are applied to the calling thread, so run each case on its own
+    // thread to keep them from leaking into other tests
+    template <typename Fn>
+    void OnNewThread(Fn &&fn)
+    {
+        std::thread(std::forward<Fn>(fn)).join();
+    }
+}  // namespace
+
+TEST(PoliciesAreParsed)
+{
+    EXPECT(ThreadPolicy::ParsePriority("low") == ThreadPolicy::Priority::Low);
+    EXPECT(ThreadPolicy::ParsePriority("high") == ThreadPolicy::Priority::High);
+    EXPECT(!ThreadPolicy::ParsePriority("urgent").has_value());
+
+    EXPECT(ThreadPolicy::ParseQualityOfService("utility") ==
+           ThreadPolicy::QualityOfService::Utility);
+    EXPECT(ThreadPolicy::ParseQualityOfService("userInteractive") ==
+           ThreadPolicy::QualityOfService::UserInteractive);
+    EXPECT(!ThreadPolicy::ParseQualityOfService("Utility").has_value());
+
+    EXPECT(ThreadPolicy{}.IsEmpty());
+}
+
+TEST(PriorityIsAppliedToTheCallingThreadOnly)
+{
+    auto const before = CurrentNiceValue();
+    OnNewThread([] {
+        ThreadPolicy policy;
+        policy.priority = ThreadPolicy::Priority::Low;
+        EXPECT(ApplyThreadPolicy(policy).empty());
+        EXPECT(CurrentNiceValue() == 10);
+    });
+    EXPECT(CurrentNiceValue() == before);
+}
+
+TEST(QualityOfServiceIsUsedWithoutPriority)
+{
+    OnNewThread([] {
+        ThreadPolicy policy;
+        policy.qos = ThreadPolicy::QualityOfService::Utility;
+        EXPECT(ApplyThreadPolicy(policy).empty());
+        EXPECT(CurrentNiceValue() == 5);
+    });
+}
+
+TEST(AffinityIsApplied)
+{
+    OnNewThread([] {
+        ThreadPolicy policy;
+        policy.affinity = {0};
+        EXPECT(ApplyThreadPolicy(policy).empty());
+
+        cpu_set_t cpus;
+        EXPECT(sched_getaffinity(0, sizeof(cpus), &cpus) == 0);
+        EXPECT(CPU_COUNT(&cpus) == 1);
+        EXPECT(CPU_ISSET(0, &cpus));
+    });
+}
+
+TEST(InvalidAffinityIsReported)
+{
+    OnNewThread([] {
+        ThreadPolicy policy;
+        policy.affinity = {CPU_SETSIZE};
+        auto failures = ApplyThreadPolicy(policy);
+        EXPECT(failures.size() == 1);
+    });
+}
@@ -34,6 +34,7 @@ Manifest ReactApp::GetManifest()
                 "Example",
                 std::nullopt,
                 std::nullopt,
+                std::nullopt,
                 std::nullopt
             },
             Component{
@@ -41,9 +42,11 @@ Manifest ReactApp::GetManifest()
                 "Template",
                 JSONObject{},
                 "modal",
-                "single"
+                "single",
+                "segment"
             },
-        })
+        }),
+        std::nullopt
     };
 }
 
@@ -77,7 +80,8 @@ Manifest ReactApp::GetManifest()
         std::nullopt,
         std::nullopt,
         std::nullopt,
-        std::make_optional<std::vector<Component>>({})
+        std::make_optional<std::vector<Component>>({}),
+        std::nullopt
     };
 }
 
@@ -233,9 +237,50 @@ Manifest ReactApp::GetManifest()
                     },
                 },
                 std::nullopt,
+                std::nullopt,
                 std::nullopt
             },
-        })
+        }),
+        std::nullopt
+    };
+}
+
+std::string_view ReactApp::GetManifestChecksum()
+{
+    return "0";
+}
+`
+    );
+  });
+
+  it("embeds engine configuration", () => {
+    equal(
+      generate(fixtures.engine),
+      `// clang-format off
+#include "Manifest.h"
+
+#include <cstdint>
+
+using ReactApp::Component;
+using ReactApp::JSONObject;
+using ReactApp::Manifest;
+
+Manifest ReactApp::GetManifest()
+{
+    using namespace std::literals::string_view_literals;
+
+    return Manifest{
+        "Example",
+        "Example",
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        std::make_optional<std::vector<Component>>({}),
+        JSONObject{
+            {"maxHeapSizeMB", INT64_C(512)},
+            {"gcMode", "lowMemory"sv},
+            {"bytecodeOnly", true},
+        }
     };
 }
 
@@ -16,6 +16,7 @@ export const simple = {
       initialProperties: {},
       presentationStyle: "modal",
       slug: "single",
+      bundleSegment: "segment",
     },
   ],
   resources: ["dist/res", "dist/main.jsbundle"],
@@ -134,3 +135,12 @@ export const extended = {
   ],
   resources: ["dist/res", "dist/main.jsbundle"],
 };
+
+export const engine = {
+  name: "Example",
+  engine: {
+    maxHeapSizeMB: 512,
+    gcMode: "lowMemory",
+    bytecodeOnly: true,
+  },
+};
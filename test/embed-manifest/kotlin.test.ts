@@ -32,6 +32,7 @@ class ManifestProvider {
                         "Example",
                         null,
                         null,
+                        null,
                         null
                     ),
                     Component(
@@ -39,9 +40,11 @@ class ManifestProvider {
                         "Template",
                         Bundle(),
                         "modal",
-                        "single"
+                        "single",
+                        "segment"
                     ),
-                )
+                ),
+                null
             )
         }
     }
@@ -70,7 +73,8 @@ class ManifestProvider {
                 null,
                 null,
                 null,
-                arrayListOf<Any>()
+                arrayListOf<Any>(),
+                null
             )
         }
     }
@@ -221,9 +225,45 @@ class ManifestProvider {
                             )
                         },
                         null,
+                        null,
                         null
                     ),
-                )
+                ),
+                null
+            )
+        }
+    }
+}
+`
+    );
+  });
+
+  it("embeds engine configuration", () => {
+    equal(
+      generate(fixtures.engine),
+      `package com.microsoft.reacttestapp.manifest
+
+import android.os.Bundle
+
+class ManifestProvider {
+    companion object {
+        fun checksum(): String {
+            return "0"
+        }
+
+        fun manifest(): Manifest {
+            return Manifest(
+                "Example",
+                "Example",
+                null,
+                null,
+                null,
+                arrayListOf<Any>(),
+                Bundle().apply {
+                    putInt("maxHeapSizeMB", 512)
+                    putString("gcMode", "lowMemory")
+                    putBoolean("bytecodeOnly", true)
+                }
             )
         }
     }
@@ -29,16 +29,19 @@ extension Manifest {
                     displayName: "Example",
                     initialProperties: nil,
                     presentationStyle: nil,
-                    slug: nil
+                    slug: nil,
+                    bundleSegment: nil
                 ),
                 Component(
                     appKey: "Example",
                     displayName: "Template",
                     initialProperties: [:],
                     presentationStyle: "modal",
-                    slug: "single"
+                    slug: "single",
+                    bundleSegment: "segment"
                 ),
-            ]
+            ],
+            engine: nil
         )
     }
 }`
@@ -62,7 +65,8 @@ extension Manifest {
             version: nil,
             bundleRoot: nil,
             singleApp: nil,
-            components: []
+            components: [],
+            engine: nil
         )
     }
 }`
@@ -193,8 +197,39 @@ extension Manifest {
                         ],
                     ],
                     presentationStyle: nil,
-                    slug: nil
+                    slug: nil,
+                    bundleSegment: nil
                 ),
+            ],
+            engine: nil
+        )
+    }
+}`
+    );
+  });
+
+  it("embeds engine configuration", () => {
+    equal(
+      generate(fixtures.engine),
+      `import Foundation
+
+extension Manifest {
+    static func checksum() -> String {
+        "0"
+    }
+
+    static func load() -> Self {
+        Manifest(
+            name: "Example",
+            displayName: "Example",
+            version: nil,
+            bundleRoot: nil,
+            singleApp: nil,
+            components: [],
+            engine: [
+                "maxHeapSizeMB": 512,
+                "gcMode": "lowMemory",
+                "bytecodeOnly": true,
             ]
         )
     }
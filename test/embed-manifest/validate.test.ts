@@ -114,6 +114,30 @@ describe("validate()", () => {
     );
   });
 
+  it("catches invalid values for `engine.gcMode`", (t) => {
+    const errorMock = t.mock.method(console, "error", () => null);
+    setMockFiles({
+      "app.json": `{
+        "name": "Example",
+        "displayName": "Example",
+        "engine": {
+          "gcMode": "generational"
+        }
+      }`,
+    });
+
+    equal(validate(findFile("app.json")), 1001);
+    equal(errorMock.mock.calls.length, 2);
+    match(
+      errorMock.mock.calls[0].arguments[0],
+      /app.json: error: app.json is not a valid app manifest$/
+    );
+    match(
+      errorMock.mock.calls[1].arguments[0],
+      /app.json: error: \/engine\/gcMode must be equal to one of the allowed values$/
+    );
+  });
+
   it("catches invalid values for resources", (t) => {
     const errorMock = t.mock.method(console, "error", () => null);
     setMockFiles({
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Manifest.h"
+
+namespace ReactTestApp
+{
+    /**
+     * Reference to an immutable component. Copying a handle only bumps a
+     * reference count; the component and its initial properties are never
+     * copied.
+     */
+    using ComponentHandle = std::shared_ptr<::ReactApp::Component const>;
+
+    /**
+     * Immutable store of components, shared by every handle into it. Handles
+     * stay valid after the store itself has been replaced, e.g. by components
+     * registered after a reload.
+     */
+    class ComponentStore
+    {
+    public:
+        ComponentStore() = default;
+
+        explicit ComponentStore(std::vector<::ReactApp::Component> components)
+        {
+            auto storage = std::make_shared<Storage>();
+            storage->components = std::move(components);
+            storage_ = std::move(storage);
+        }
+
+        /**
+         * Creates components for app keys retrieved from `AppRegistry`. The
+         * store owns the keys, so that components do not refer to strings
+         * that may be replaced on the next reload.
+         */
+        explicit ComponentStore(std::vector<std::string> appKeys)
+        {
+            auto storage = std::make_shared<Storage>();
+            storage->appKeys = std::move(appKeys);
+            storage->components.reserve(storage->appKeys.size());
+            for (auto &&appKey : storage->appKeys) {
+                storage->components.emplace_back().appKey = appKey;
+            }
+            storage_ = std::move(storage);
+        }
+
+        size_t Size() const
+        {
+            return storage_ ? storage_->components.size() : 0;
+        }
+
+        ::ReactApp::Component const &operator[](size_t index) const
+        {
+            assert(index < Size());
+            return storage_->components[index];
+        }
+
+        /**
+         * Returns a handle to the component at `index`. This does not
+         * allocate; the handle shares ownership of the whole store.
+         */
+        ComponentHandle Handle(size_t index) const
+        {
+            assert(index < Size());
+            return ComponentHandle{storage_, &storage_->components[index]};
+        }
+
+        auto begin() const
+        {
+            return storage_ ? storage_->components.cbegin() : Iterator{};
+        }
+
+        auto end() const
+        {
+            return storage_ ? storage_->components.cend() : Iterator{};
+        }
+
+    private:
+        using Iterator = std::vector<::ReactApp::Component>::const_iterator;
+
+        struct Storage {
+            std::vector<std::string> appKeys;
+            std::vector<::ReactApp::Component> components;
+        };
+
+        std::shared_ptr<Storage const> storage_;
+    };
+}  // namespace ReactTestApp
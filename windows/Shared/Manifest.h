@@ -19,6 +19,7 @@ namespace ReactApp
         std::optional<JSONObject> initialProperties;
         std::optional<std::string_view> presentationStyle;
         std::optional<std::string_view> slug;
+        std::optional<std::string_view> bundleSegment;
     };
 
     struct Manifest {
@@ -28,6 +29,7 @@ namespace ReactApp
         std::optional<std::string_view> bundleRoot;
         std::optional<std::string_view> singleApp;
         std::optional<std::vector<Component>> components;
+        std::optional<JSONObject> engine;
     };
 
     Manifest GetManifest();
@@ -4,6 +4,7 @@
 
 #include <NativeModules.h>
 #include <filesystem>
+#include <fstream>
 
 #if __has_include(<JSI/JsiApiContext.h>)
 #include <JSI/JsiApiContext.h>
@@ -14,11 +15,29 @@
 
 #if __has_include("AppRegistry.h")
 #include "AppRegistry.h"
+#include "LiveObjects.h"
+#include "Metrics.h"
 #endif  // __has_include("AppRegistry.h")
+#include "MemoryMonitor.h"
+#include "ReloadStress.h"
+#include "SamplingProfiler.h"
+#include "StallWatchdog.h"
 #include "AutolinkedNativeModules.g.h"
 
 using facebook::jsi::Runtime;
+using ReactTestApp::BundleFetcher;
+using ReactTestApp::GetStallThreshold;
+using ReactTestApp::JsScheduler;
+using ReactTestApp::JsTaskCancelled;
+using ReactTestApp::MakeStallRecorder;
 using ReactTestApp::ReactInstance;
+using ReactTestApp::ReloadStressDriver;
+using ReactTestApp::ReloadStressOptions;
+using ReactTestApp::ReloadStressResult;
+using ReactTestApp::SamplingProfiler;
+using ReactTestApp::StallEvent;
+using ReactTestApp::StallWatchdog;
+using ReactTestApp::ThreadPolicy;
 
 namespace winrt
 {
@@ -29,7 +48,9 @@ namespace winrt
     using winrt::Windows::Foundation::IInspectable;
     using winrt::Windows::Foundation::PropertyValue;
     using winrt::Windows::Foundation::Uri;
+    using winrt::Windows::Foundation::Collections::IPropertySet;
     using winrt::Windows::Storage::ApplicationData;
+    using winrt::Windows::Storage::ApplicationDataCreateDisposition;
     using winrt::Windows::Web::Http::HttpClient;
 }  // namespace winrt
 
@@ -42,9 +63,12 @@ namespace
     winrt::hstring const kUseFastRefresh = L"useFastRefresh";
     winrt::hstring const kUseWebDebugger = L"useWebDebugger";
 
+    constexpr std::wstring_view const bundleExtension = L".bundle";
+
+    constexpr char const kDevServerBundlePath[] = "/index.bundle?platform=windows&dev=true";
+
     std::optional<winrt::hstring> GetBundleName(std::optional<winrt::hstring> const &bundleRoot)
     {
-        constexpr std::wstring_view const bundleExtension = L".bundle";
 
         std::filesystem::path bundlePath{L"Bundle\\"};
         if (bundleRoot.has_value()) {
@@ -67,17 +91,42 @@ namespace
         return std::nullopt;
     }
 
-    bool RetrieveLocalSetting(winrt::hstring const &key, bool defaultValue)
+    bool IsHermesBytecode(std::filesystem::path const &bundlePath)
+    {
+        // Hermes bytecode files start with the magic number 0x1F1903C103BC1FC6
+        constexpr uint64_t kHermesBytecodeMagic = 0x1F1903C103BC1FC6;
+
+        uint64_t magic = 0;
+        std::ifstream bundle{bundlePath, std::ios::binary};
+        bundle.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        return bundle.gcount() == sizeof(magic) && magic == kHermesBytecodeMagic;
+    }
+
+    winrt::IPropertySet LocalSettings(winrt::hstring const &settingsNamespace)
     {
         auto localSettings = winrt::ApplicationData::Current().LocalSettings();
-        auto values = localSettings.Values();
+        if (settingsNamespace.empty()) {
+            return localSettings.Values();
+        }
+
+        return localSettings
+            .CreateContainer(settingsNamespace, winrt::ApplicationDataCreateDisposition::Always)
+            .Values();
+    }
+
+    bool RetrieveLocalSetting(winrt::hstring const &settingsNamespace,
+                              winrt::hstring const &key,
+                              bool defaultValue)
+    {
+        auto values = LocalSettings(settingsNamespace);
         return winrt::unbox_value_or<bool>(values.Lookup(key), defaultValue);
     }
 
-    void StoreLocalSetting(winrt::hstring const &key, bool value)
+    void StoreLocalSetting(winrt::hstring const &settingsNamespace,
+                           winrt::hstring const &key,
+                           bool value)
     {
-        auto localSettings = winrt::ApplicationData::Current().LocalSettings();
-        auto values = localSettings.Values();
+        auto values = LocalSettings(settingsNamespace);
         values.Insert(key, winrt::PropertyValue::CreateBoolean(value));
     }
 
@@ -89,6 +138,57 @@ namespace
             AddAttributedModules(packageBuilder, true);
         }
     };
+
+    /**
+     * Stored in the properties of every React context so that contexts which
+     * are never released show up as live objects.
+     */
+    struct ContextLifetimeToken
+        : winrt::implements<ContextLifetimeToken, winrt::Windows::Foundation::IInspectable> {
+        ReactTestApp::LiveObject token{ReactTestApp::GetLiveObjectCounter("reactContexts")};
+    };
+
+    ThreadPolicy ParseThreadPolicy(std::any const &value)
+    {
+        ThreadPolicy policy;
+        auto object = std::any_cast<ReactApp::JSONObject>(&value);
+        if (object == nullptr) {
+            return policy;
+        }
+
+        for (auto &&[key, setting] : *object) {
+            if (key == "priority") {
+                if (auto priority = std::any_cast<std::string_view>(&setting)) {
+                    policy.priority = ThreadPolicy::ParsePriority(*priority);
+                }
+            } else if (key == "qos") {
+                if (auto qos = std::any_cast<std::string_view>(&setting)) {
+                    policy.qos = ThreadPolicy::ParseQualityOfService(*qos);
+                }
+            } else if (key == "affinity") {
+                if (auto cpus = std::any_cast<std::vector<std::any>>(&setting)) {
+                    for (auto &&cpu : *cpus) {
+                        if (auto index = std::any_cast<int64_t>(&cpu)) {
+                            policy.affinity.push_back(static_cast<int>(*index));
+                        }
+                    }
+                }
+            }
+        }
+        return policy;
+    }
+
+    void LogStall(StallEvent const &event)
+    {
+        std::string message = event.phase == StallEvent::Phase::Stalled ? "JS thread stalled"
+                                                                         : "JS thread recovered";
+        message += " after " + std::to_string(event.duration.count()) + " ms";
+        if (!event.samplesPath.empty()) {
+            message += "; samples: " + event.samplesPath;
+        }
+        message += '\n';
+        OutputDebugStringA(message.c_str());
+    }
 }  // namespace
 
 std::vector<std::wstring_view> const ReactTestApp::JSBundleNames = {
@@ -101,35 +201,82 @@ std::vector<std::wstring_view> const ReactTestApp::JSBundleNames = {
 };
 
 ReactInstance::ReactInstance()
+    : registrations_(8, [this]() {
+          reactNativeHost_.InstanceSettings().UIDispatcher().Post([this]() {
+              registrations_.Drain([this](std::vector<std::string> &&appKeys) {
+                  if (onComponentsRegistered_) {
+                      onComponentsRegistered_(appKeys);
+                  }
+              });
+          });
+      })
 {
+    SamplingProfiler::Shared().OutputDirectory(std::filesystem::temp_directory_path().string());
+
+    defaultBundleRootPath_ = reactNativeHost_.InstanceSettings().BundleRootPath();
+
     reactNativeHost_.PackageProviders().Append(winrt::make<ReactPackageProvider>());
     winrt::Microsoft::ReactNative::RegisterAutolinkedNativeModulePackages(
         reactNativeHost_.PackageProviders());
 
     reactNativeHost_.InstanceSettings().InstanceLoaded(
         [this](winrt::IInspectable const & /*sender*/, winrt::InstanceLoadedEventArgs const &args) {
-            context_ = args.Context();
-
-#if __has_include("AppRegistry.h") && __has_include(<JSI/JsiApiContext.h>)
-            if (!onComponentsRegistered_) {
+            auto context = winrt::Microsoft::ReactNative::ReactContext{args.Context()};
+            if (!context) {
                 return;
             }
 
-            winrt::Microsoft::ReactNative::ExecuteJsi(context_, [this](Runtime &runtime) noexcept {
-                try {
-                    onComponentsRegistered_(ReactTestApp::GetAppKeys(runtime));
-                } catch ([[maybe_unused]] std::exception const &e) {
-#if defined(_DEBUG) && !defined(DISABLE_XAML_GENERATED_BREAK_ON_UNHANDLED_EXCEPTION)
-                    if (IsDebuggerPresent()) {
-                        __debugbreak();
+            {
+                std::lock_guard<std::mutex> lock(contextMutex_);
+                context_ = context;
+            }
+            context.Handle().Properties().Set(
+                winrt::Microsoft::ReactNative::ReactPropertyBagHelper::GetName(
+                    nullptr, L"ReactTestApp.ContextLifetime"),
+                winrt::make<ContextLifetimeToken>());
+
+#if __has_include(<JSI/JsiApiContext.h>)
+            // Jobs scheduled for the previous runtime are cancelled, and any
+            // that were waiting for this one are dispatched
+            jsScheduler_.Attach([context](JsScheduler::Batch batch) {
+                winrt::Microsoft::ReactNative::ExecuteJsi(context, std::move(batch));
+            });
+
+            watchdog_.reset();
+            if (auto threshold = GetStallThreshold()) {
+                watchdog_ = std::make_unique<StallWatchdog>(
+                    *threshold,
+                    [context](StallWatchdog::Task task) {
+                        winrt::Microsoft::ReactNative::ExecuteJsi(
+                            context, [task = std::move(task)](Runtime &) noexcept { task(); });
+                    },
+                    MakeStallRecorder(LogStall));
+            }
+#endif  // __has_include(<JSI/JsiApiContext.h>)
+
+#if __has_include("AppRegistry.h") && __has_include(<JSI/JsiApiContext.h>)
+            InitializeRuntime();
+#endif  // __has_include("AppRegistry.h") && __has_include(<JSI/JsiApiContext.h>)
+
+            if (!jsThreadPolicy_.IsEmpty()) {
+                context.JSDispatcher().Post([policy = jsThreadPolicy_]() {
+                    for (auto &&failure : ReactTestApp::ApplyThreadPolicy(policy)) {
+                        auto message = "Failed to apply JS thread policy: " + failure + '\n';
+                        OutputDebugStringA(message.c_str());
                     }
-#endif  // defined(_DEBUG) && !defined(DISABLE_XAML_GENERATED_BREAK_ON_UNHANDLED_EXCEPTION)
+                });
+            }
+
+            context.UIDispatcher().Post([this]() {
+                if (reloadStress_) {
+                    reloadStress_->OnReloaded();
                 }
             });
-#endif  // __has_include("AppRegistry.h") && __has_include(<JSI/JsiApiContext.h>)
         });
 }
 
+ReactInstance::~ReactInstance() = default;
+
 #if __has_include(<winrt/Microsoft.UI.Composition.h>)
 ReactInstance::ReactInstance(HWND hwnd,
                              winrt::Microsoft::UI::Composition::Compositor const &compositor)
@@ -159,6 +306,15 @@ bool ReactInstance::LoadJSBundleFrom(JSBundleSource source)
             if (!bundleName.has_value()) {
                 return false;
             }
+            if (bytecodeOnly_) {
+                std::filesystem::path bundlePath{L"Bundle\\"};
+                bundlePath.replace_filename(std::wstring_view{*bundleName}) += bundleExtension;
+                if (!IsHermesBytecode(bundlePath)) {
+                    OutputDebugStringA("'engine.bytecodeOnly' is set, but the embedded bundle is "
+                                       "not Hermes bytecode\n");
+                    return false;
+                }
+            }
             instanceSettings.JavaScriptBundleFile(bundleName.value());
             break;
     }
@@ -190,24 +346,93 @@ void ReactInstance::Reload()
     instanceSettings.SourceBundleHost(host);
     instanceSettings.SourceBundlePort(static_cast<uint16_t>(port));
 
+    // Fast Refresh and the web debugger load the bundle from the dev server
+    // themselves, so deltas are only used while both are off
+    if (source_ == JSBundleSource::DevServer && ReactTestApp::IsDeltaReloadEnabled() &&
+        !useFastRefresh && !UseWebDebugger()) {
+        if (auto fetcher = DeltaBundleFetcher()) {
+            ReloadFromDelta(std::move(fetcher));
+            return;
+        }
+    }
+
+    instanceSettings.BundleRootPath(defaultBundleRootPath_);
+    if (source_ == JSBundleSource::DevServer) {
+        instanceSettings.JavaScriptBundleFile(L"index");
+    }
+
+    // The watchdog posts heartbeats to the runtime that is about to go away;
+    // a new one is started once the next context is ready
+    jsScheduler_.Detach();
+    watchdog_.reset();
     reactNativeHost_.ReloadInstance();
 }
 
+void ReactInstance::EngineConfig(std::optional<ReactApp::JSONObject> const &engine)
+{
+    bytecodeOnly_ = false;
+    jsThreadPolicy_ = {};
+    if (!engine.has_value()) {
+        return;
+    }
+
+    for (auto &&[key, value] : *engine) {
+        if (key == "bytecodeOnly") {
+            if (auto bytecodeOnly = std::any_cast<bool>(&value)) {
+                bytecodeOnly_ = *bytecodeOnly;
+            }
+        } else if (key == "jsThread") {
+            jsThreadPolicy_ = ParseThreadPolicy(value);
+        } else {
+            // React Native for Windows does not expose Hermes' heap or GC
+            // configuration, nor the native modules thread
+            auto message = "'engine." + std::string{key} + "' is not supported on Windows\n";
+            OutputDebugStringA(message.c_str());
+        }
+    }
+}
+
+bool ReactInstance::IsReloadStressRunning() const
+{
+    return reloadStressRunning_.load(std::memory_order_acquire);
+}
+
+void ReactInstance::StartReloadStress(ReloadStressOptions const &options,
+                                      std::function<void(ReloadStressResult const &)> completion)
+{
+    if (IsReloadStressRunning()) {
+        return;
+    }
+
+    // `OnReloaded` is called on the UI thread, so reloading from it has to be
+    // deferred until the instance has finished loading
+    auto dispatcher = reactNativeHost_.InstanceSettings().UIDispatcher();
+    reloadStressRunning_.store(true, std::memory_order_release);
+    reloadStress_ = std::make_unique<ReloadStressDriver>(
+        options,
+        [this, dispatcher]() { dispatcher.Post([this]() { Reload(); }); },
+        [this, completion = std::move(completion)](ReloadStressResult const &result) {
+            // Report the result before the run is seen as finished
+            completion(result);
+            reloadStressRunning_.store(false, std::memory_order_release);
+        });
+    reloadStress_->Start();
+}
+
 bool ReactInstance::BreakOnFirstLine() const
 {
-    return RetrieveLocalSetting(kBreakOnFirstLine, false);
+    return RetrieveLocalSetting(settingsNamespace_, kBreakOnFirstLine, false);
 }
 
 void ReactInstance::BreakOnFirstLine(bool breakOnFirstLine)
 {
-    StoreLocalSetting(kBreakOnFirstLine, breakOnFirstLine);
+    StoreLocalSetting(settingsNamespace_, kBreakOnFirstLine, breakOnFirstLine);
     Reload();
 }
 
 std::tuple<winrt::hstring, int> ReactInstance::BundlerAddress() const
 {
-    auto localSettings = winrt::ApplicationData::Current().LocalSettings();
-    auto values = localSettings.Values();
+    auto values = LocalSettings(settingsNamespace_);
     auto host = winrt::unbox_value_or<winrt::hstring>(values.Lookup(kBundlerHost), {});
     auto port = winrt::unbox_value_or<int>(values.Lookup(kBundlerPort), 0);
     return {host, port};
@@ -215,8 +440,7 @@ std::tuple<winrt::hstring, int> ReactInstance::BundlerAddress() const
 
 void ReactInstance::BundlerAddress(winrt::hstring host, int port)
 {
-    auto localSettings = winrt::ApplicationData::Current().LocalSettings();
-    auto values = localSettings.Values();
+    auto values = LocalSettings(settingsNamespace_);
 
     if (host.empty()) {
         values.Remove(kBundlerHost);
@@ -230,56 +454,244 @@ void ReactInstance::BundlerAddress(winrt::hstring host, int port)
         values.Insert(kBundlerPort, winrt::PropertyValue::CreateInt32(port));
     }
 
-    Reload();
+    // Nothing to reload if no bundle has been loaded yet
+    if (!reactNativeHost_.InstanceSettings().JavaScriptBundleFile().empty()) {
+        Reload();
+    }
+}
+
+std::shared_ptr<BundleFetcher> ReactInstance::DeltaBundleFetcher()
+{
+    auto [host, port] = BundlerAddress();
+    auto bundlerHost = host.empty() ? std::string{"localhost"} : winrt::to_string(host);
+    auto bundlerPort = static_cast<uint16_t>(port > 0 ? port : 8081);
+    if (!bundleFetcher_ || bundleFetcher_->Host() != bundlerHost ||
+        bundleFetcher_->Port() != bundlerPort) {
+        bundleFetcher_ =
+            std::make_shared<BundleFetcher>(bundlerHost, bundlerPort, kDevServerBundlePath);
+    }
+
+    if (!bundleFetcher_->ServesDeltas()) {
+        OutputDebugStringA("The bundler does not serve deltas; reloading from the dev server\n");
+        return nullptr;
+    }
+
+    return bundleFetcher_;
+}
+
+winrt::fire_and_forget ReactInstance::ReloadFromDelta(std::shared_ptr<BundleFetcher> fetcher)
+{
+    // The runtime may still have the previous bundle mapped, so write each
+    // one to a new file, alternating between two
+    auto directory = std::filesystem::temp_directory_path() /
+                     (L"ReactTestApp" + std::wstring{settingsNamespace_});
+    auto bundleName = std::wstring{L"delta-"} + std::to_wstring(deltaReloads_++ % 2);
+    auto dispatcher = reactNativeHost_.InstanceSettings().UIDispatcher();
+    std::weak_ptr<void const> lifetime = lifetime_;
+
+    co_await winrt::resume_background();
+
+    bool loaded = false;
+    try {
+        auto result = fetcher->Fetch();
+        std::filesystem::create_directories(directory);
+        std::ofstream file{directory / (bundleName + std::wstring{bundleExtension}),
+                           std::ios::binary | std::ios::trunc};
+        file.write(result.bundle->Data(), static_cast<std::streamsize>(result.bundle->Size()));
+        file.close();
+        loaded = file.good();
+
+        auto message = "Fetched bundle: " + result.ToJSON() + '\n';
+        OutputDebugStringA(message.c_str());
+    } catch (std::exception const &e) {
+        auto message = std::string{"Failed to fetch bundle delta: "} + e.what() + '\n';
+        OutputDebugStringA(message.c_str());
+    }
+
+    // The instance is destroyed on the UI thread, so it cannot go away while
+    // this runs
+    dispatcher.Post([this, lifetime, loaded, directory, bundleName]() {
+        if (lifetime.expired()) {
+            return;
+        }
+
+        auto instanceSettings = reactNativeHost_.InstanceSettings();
+        if (loaded) {
+            instanceSettings.BundleRootPath(winrt::hstring{(directory / L"").wstring()});
+            instanceSettings.JavaScriptBundleFile(winrt::hstring{bundleName});
+        } else {
+            // Fall back to a full reload from the dev server
+            instanceSettings.BundleRootPath(defaultBundleRootPath_);
+            instanceSettings.JavaScriptBundleFile(L"index");
+        }
+
+        jsScheduler_.Detach();
+        watchdog_.reset();
+        reactNativeHost_.ReloadInstance();
+    });
+}
+
+winrt::fire_and_forget ReactInstance::LoadBundleSegment(std::string name,
+                                                        OnBundleSegmentLoaded completion)
+{
+    auto dispatcher = reactNativeHost_.InstanceSettings().UIDispatcher();
+    std::optional<std::string> error;
+#if __has_include(<JSI/JsiApiContext.h>)
+    if (source_ == JSBundleSource::Embedded) {
+        try {
+            co_await jsScheduler_.RunOnJs(
+                [this, name](Runtime &runtime) { bundleSegments_.Load(runtime, name); });
+        } catch (JsTaskCancelled const &) {
+            // Loads requested before the first instance has loaded wait for
+            // it; only a reload gets here
+            error = "The instance was reloaded before the bundle segment '" + name +
+                    "' could be loaded";
+        } catch (std::exception const &e) {
+            error = e.what();
+        }
+    }
+#endif  // __has_include(<JSI/JsiApiContext.h>)
+    dispatcher.Post([completion = std::move(completion), error = std::move(error)]() {
+        completion(error);
+    });
+    co_return;
 }
 
 void ReactInstance::ToggleElementInspector() const
 {
-    if (!context_) {
+    auto context = Context();
+    if (!context) {
         return;
     }
 
-    context_.CallJSFunction(L"RCTDeviceEventEmitter", L"emit", L"toggleElementInspector");
+    context.CallJSFunction(L"RCTDeviceEventEmitter", L"emit", L"toggleElementInspector");
+}
+
+void ReactInstance::CheckComponentMemory(std::string component) const
+{
+#if __has_include(<JSI/JsiApiContext.h>)
+    auto context = Context();
+    if (!context) {
+        return;
+    }
+
+    winrt::Microsoft::ReactNative::ExecuteJsi(
+        context, [component = std::move(component)](Runtime &runtime) noexcept {
+            static auto const budget = ReactTestApp::MemoryBudget::FromEnvironment();
+            try {
+                auto snapshot = ReactTestApp::CheckComponentMemory(
+                    runtime,
+                    component,
+                    budget,
+                    std::filesystem::temp_directory_path().string());
+                if (snapshot.has_value()) {
+                    auto message = component + " exceeded its memory budget; heap snapshot: " +
+                                   *snapshot + '\n';
+                    OutputDebugStringA(message.c_str());
+                }
+            } catch (std::exception const &) {
+                // Sampling is best effort
+            }
+        });
+#endif  // __has_include(<JSI/JsiApiContext.h>)
+}
+
+winrt::Microsoft::ReactNative::ReactContext ReactInstance::Context() const
+{
+    std::lock_guard<std::mutex> lock(contextMutex_);
+    return context_;
+}
+
+winrt::fire_and_forget ReactInstance::InitializeRuntime()
+{
+#if __has_include("AppRegistry.h") && __has_include(<JSI/JsiApiContext.h>)
+    try {
+        // Submitted together so that they run in a single JS thread hop
+        auto lifetime = jsScheduler_.RunOnJs(
+            [](Runtime &runtime) { ReactTestApp::TrackRuntimeLifetime(runtime); });
+        auto metrics =
+            jsScheduler_.RunOnJs([](Runtime &runtime) { ReactTestApp::InstallMetrics(runtime); });
+        auto appKeys = jsScheduler_.RunOnJs(
+            [](Runtime &runtime) { return ReactTestApp::GetAppKeys(runtime); });
+
+        co_await lifetime;
+        co_await metrics;
+        registrations_.Send(co_await appKeys);
+    } catch (JsTaskCancelled const &) {
+        // The instance was reloaded before the jobs could run
+    } catch ([[maybe_unused]] std::exception const &e) {
+#if defined(_DEBUG) && !defined(DISABLE_XAML_GENERATED_BREAK_ON_UNHANDLED_EXCEPTION)
+        if (IsDebuggerPresent()) {
+            __debugbreak();
+        }
+#endif  // defined(_DEBUG) && !defined(DISABLE_XAML_GENERATED_BREAK_ON_UNHANDLED_EXCEPTION)
+    }
+#else
+    co_return;
+#endif  // __has_include("AppRegistry.h") && __has_include(<JSI/JsiApiContext.h>)
+}
+
+bool ReactInstance::IsSamplingProfilerAvailable() const
+{
+    return SamplingProfiler::IsAvailable();
+}
+
+bool ReactInstance::IsSamplingProfilerRunning() const
+{
+    return SamplingProfiler::Shared().IsRunning();
+}
+
+std::optional<std::string> ReactInstance::ToggleSamplingProfiler(std::string_view label)
+{
+    auto &profiler = SamplingProfiler::Shared();
+    if (profiler.IsRunning()) {
+        return profiler.Stop();
+    }
+
+    profiler.Start(label);
+    return std::nullopt;
 }
 
 bool ReactInstance::UseDirectDebugger() const
 {
-    return RetrieveLocalSetting(kUseDirectDebugger, false);
+    return RetrieveLocalSetting(settingsNamespace_, kUseDirectDebugger, false);
 }
 
 void ReactInstance::UseDirectDebugger(bool useDirectDebugger)
 {
     if (useDirectDebugger) {
         // Remote debugging is incompatible with direct debugging
-        StoreLocalSetting(kUseWebDebugger, false);
+        StoreLocalSetting(settingsNamespace_, kUseWebDebugger, false);
     }
-    StoreLocalSetting(kUseDirectDebugger, useDirectDebugger);
+    StoreLocalSetting(settingsNamespace_, kUseDirectDebugger, useDirectDebugger);
     Reload();
 }
 
 bool ReactInstance::UseFastRefresh() const
 {
-    return IsFastRefreshAvailable() && RetrieveLocalSetting(kUseFastRefresh, true);
+    return IsFastRefreshAvailable() &&
+           RetrieveLocalSetting(settingsNamespace_, kUseFastRefresh, true);
 }
 
 void ReactInstance::UseFastRefresh(bool useFastRefresh)
 {
-    StoreLocalSetting(kUseFastRefresh, useFastRefresh);
+    StoreLocalSetting(settingsNamespace_, kUseFastRefresh, useFastRefresh);
     Reload();
 }
 
 bool ReactInstance::UseWebDebugger() const
 {
-    return IsWebDebuggerAvailable() && RetrieveLocalSetting(kUseWebDebugger, false);
+    return IsWebDebuggerAvailable() &&
+           RetrieveLocalSetting(settingsNamespace_, kUseWebDebugger, false);
 }
 
 void ReactInstance::UseWebDebugger(bool useWebDebugger)
 {
     if (useWebDebugger) {
         // Remote debugging is incompatible with direct debugging
-        StoreLocalSetting(kUseDirectDebugger, false);
+        StoreLocalSetting(settingsNamespace_, kUseDirectDebugger, false);
     }
-    StoreLocalSetting(kUseWebDebugger, useWebDebugger);
+    StoreLocalSetting(settingsNamespace_, kUseWebDebugger, useWebDebugger);
     Reload();
 }
 
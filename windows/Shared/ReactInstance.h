@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -16,8 +19,20 @@
 
 #include <ReactContext.h>
 
+#include "BundleFetcher.h"
+#include "BundleSegments.h"
+#include "EventChannel.h"
+#include "JsScheduler.h"
+#include "Manifest.h"
+#include "ThreadPolicy.h"
+
 namespace ReactTestApp
 {
+    class ReloadStressDriver;
+    class StallWatchdog;
+    struct ReloadStressOptions;
+    struct ReloadStressResult;
+
     extern std::vector<std::wstring_view> const JSBundleNames;
 
     enum class JSBundleSource {
@@ -26,6 +41,7 @@ namespace ReactTestApp
     };
 
     using OnComponentsRegistered = std::function<void(std::vector<std::string> const &)>;
+    using OnBundleSegmentLoaded = std::function<void(std::optional<std::string> const &error)>;
 
     class ReactInstance
     {
@@ -33,6 +49,7 @@ namespace ReactTestApp
         static constexpr uint32_t Version = REACT_NATIVE_VERSION;
 
         ReactInstance();
+        ~ReactInstance();
 
 #if __has_include(<winrt/Microsoft.UI.Composition.h>)
         ReactInstance(HWND hwnd, winrt::Microsoft::UI::Composition::Compositor const &);
@@ -59,6 +76,23 @@ namespace ReactTestApp
             bundleRoot_ = std::move(bundleRoot);
         }
 
+        /**
+         * Applies the `engine` section of the app manifest. Must be called
+         * before the first bundle is loaded.
+         */
+        void EngineConfig(std::optional<ReactApp::JSONObject> const &engine);
+
+        /**
+         * Stores this instance's settings in a container of their own rather
+         * than in the app's local settings, so that several instances can be
+         * configured independently. Must be called before the first bundle is
+         * loaded.
+         */
+        void SettingsNamespace(winrt::hstring settingsNamespace)
+        {
+            settingsNamespace_ = std::move(settingsNamespace);
+        }
+
         std::tuple<winrt::hstring, int> BundlerAddress() const;
         void BundlerAddress(winrt::hstring host, int port);
 
@@ -72,14 +106,57 @@ namespace ReactTestApp
             return source_ == JSBundleSource::DevServer;
         }
 
+        /**
+         * Sets the delegate that receives registered app keys. It is called on
+         * the UI thread.
+         */
         template <typename F>
         void SetComponentsRegisteredDelegate(F &&f)
         {
             onComponentsRegistered_ = std::forward<F>(f);
         }
 
+        /**
+         * Evaluates bundle segment `name` unless it already has been, then
+         * calls `completion` on the UI thread with an error message if it
+         * failed. Segments are only loaded with embedded bundles; the dev
+         * server serves the whole app. Segments requested before the instance
+         * has loaded are loaded as soon as it has. If the instance is reloaded
+         * first, `completion` is called with an error.
+         */
+        winrt::fire_and_forget LoadBundleSegment(std::string name,
+                                                 OnBundleSegmentLoaded completion);
+
         void ToggleElementInspector() const;
 
+        /**
+         * Records memory used while `component` was presented, and writes a
+         * heap snapshot to the temp directory if it exceeds the budget.
+         */
+        void CheckComponentMemory(std::string component) const;
+
+        /**
+         * Returns whether a reload stress run is in progress. Unlike the rest
+         * of the reload stress API, this may be called from any thread.
+         */
+        bool IsReloadStressRunning() const;
+
+        /**
+         * Reloads repeatedly and reports whether JS runtimes, React contexts,
+         * native modules or memory grew beyond the given tolerances.
+         */
+        void StartReloadStress(ReloadStressOptions const &,
+                               std::function<void(ReloadStressResult const &)> completion);
+
+        bool IsSamplingProfilerAvailable() const;
+        bool IsSamplingProfilerRunning() const;
+
+        /**
+         * Starts the sampling profiler, or stops it and returns the path of
+         * the written profile.
+         */
+        std::optional<std::string> ToggleSamplingProfiler(std::string_view label);
+
         bool UseCustomDeveloperMenu() const
         {
             return true;
@@ -95,11 +172,55 @@ namespace ReactTestApp
         void UseWebDebugger(bool);
 
     private:
+        /**
+         * Returns the context of the current instance. `InstanceLoaded` may
+         * fire on another thread than the one calling in.
+         */
+        winrt::Microsoft::ReactNative::ReactContext Context() const;
+
+        /**
+         * Installs host objects in the newly loaded runtime and forwards
+         * registered app keys to the UI thread.
+         */
+        winrt::fire_and_forget InitializeRuntime();
+
+        /**
+         * Returns the fetcher for the current bundler address, or nothing if
+         * the bundler has been found not to serve deltas.
+         */
+        std::shared_ptr<BundleFetcher> DeltaBundleFetcher();
+
+        /**
+         * Downloads the bundle from the dev server, as a delta against the
+         * previous one if the bundler serves deltas, and reloads from the
+         * patched copy. Falls back to loading from the dev server if the
+         * download fails. Only used while Fast Refresh is off, since it would
+         * load the whole bundle from the dev server again.
+         */
+        winrt::fire_and_forget ReloadFromDelta(std::shared_ptr<BundleFetcher> fetcher);
+
         winrt::Microsoft::ReactNative::ReactNativeHost reactNativeHost_;
+        mutable std::mutex contextMutex_;
         winrt::Microsoft::ReactNative::ReactContext context_;
         std::optional<winrt::hstring> bundleRoot_;
+        winrt::hstring defaultBundleRootPath_;
+        winrt::hstring settingsNamespace_;
         JSBundleSource source_ = JSBundleSource::DevServer;
+        bool bytecodeOnly_ = false;
+        ThreadPolicy jsThreadPolicy_;
         OnComponentsRegistered onComponentsRegistered_;
+        EventChannel<std::vector<std::string>> registrations_;
+        JsScheduler jsScheduler_;
+        BundleSegmentLoader bundleSegments_{"Bundle"};
+        std::shared_ptr<BundleFetcher> bundleFetcher_;
+        uint32_t deltaReloads_ = 0;
+        std::unique_ptr<StallWatchdog> watchdog_;
+        std::unique_ptr<ReloadStressDriver> reloadStress_;
+        std::atomic<bool> reloadStressRunning_{false};
+
+        // Lets callbacks that outlive a `co_await` check that the instance
+        // still exists
+        std::shared_ptr<void const> lifetime_ = std::make_shared<bool>(true);
     };
 
     winrt::Windows::Foundation::IAsyncOperation<bool> IsDevServerRunning();
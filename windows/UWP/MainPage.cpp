@@ -13,12 +13,17 @@
 #include "JSValueWriterHelper.h"
 #include "MainPage.g.cpp"
 #include "Manifest.g.cpp"
+#include "SamplingProfiler.h"
 #include "Session.h"
 
-using ReactApp::Component;
+using ReactTestApp::ComponentHandle;
+using ReactTestApp::ComponentIndex;
+using ReactTestApp::ComponentStore;
 using ReactTestApp::JSBundleSource;
 using ReactTestApp::ReactInstance;
 using ReactTestApp::Session;
+using ReactTestApp::SurfaceStressResult;
+using ReactTestApp::SurfaceStressTracker;
 using winrt::Microsoft::ReactNative::IJSValueWriter;
 using winrt::Microsoft::ReactNative::ReactNativeHost;
 using winrt::Microsoft::ReactNative::ReactRootView;
@@ -33,14 +38,20 @@ using winrt::Windows::UI::Colors;
 using winrt::Windows::UI::Core::CoreDispatcherPriority;
 using winrt::Windows::UI::Popups::MessageDialog;
 using winrt::Windows::UI::ViewManagement::ApplicationView;
+using winrt::Windows::UI::Xaml::HorizontalAlignment;
 using winrt::Windows::UI::Xaml::RoutedEventArgs;
+using winrt::Windows::UI::Xaml::SizeChangedEventArgs;
+using winrt::Windows::UI::Xaml::VerticalAlignment;
 using winrt::Windows::UI::Xaml::Visibility;
 using winrt::Windows::UI::Xaml::Window;
 using winrt::Windows::UI::Xaml::Automation::Peers::MenuBarItemAutomationPeer;
 using winrt::Windows::UI::Xaml::Controls::ContentDialogButtonClickEventArgs;
+using winrt::Windows::UI::Xaml::Controls::ContentDialogClosedEventArgs;
+using winrt::Windows::UI::Xaml::Controls::ItemClickEventArgs;
 using winrt::Windows::UI::Xaml::Controls::MenuFlyoutItem;
 using winrt::Windows::UI::Xaml::Controls::MenuFlyoutSeparator;
 using winrt::Windows::UI::Xaml::Controls::TextBoxBeforeTextChangingEventArgs;
+using winrt::Windows::UI::Xaml::Controls::TextChangedEventArgs;
 using winrt::Windows::UI::Xaml::Controls::ToggleMenuFlyoutItem;
 using winrt::Windows::UI::Xaml::Input::KeyboardAccelerator;
 using winrt::Windows::UI::Xaml::Navigation::NavigationEventArgs;
@@ -54,6 +65,11 @@ namespace
 #endif  // _DEBUG
     constexpr bool kSingleAppMode = static_cast<bool>(ENABLE_SINGLE_APP_MODE);
 
+    // Components beyond the ones with keyboard accelerators (Ctrl+Shift+1-9)
+    // are only reachable through "Find Component…", whose list is virtualized
+    constexpr size_t kMaxComponentMenuItems = 9;
+    constexpr size_t kMaxSearchResults = 100;
+
     void SetMenuItemText(IInspectable const &sender,
                          bool const isEnabled,
                          winrt::hstring const &enableText,
@@ -79,6 +95,11 @@ namespace
         SetMenuItemText(sender, value, L"Enable Fast Refresh", L"Disable Fast Refresh");
     }
 
+    void SetSamplingProfilerMenuItem(IInspectable const &sender, bool const value)
+    {
+        SetMenuItemText(sender, value, L"Start Sampling Profiler", L"Stop Sampling Profiler");
+    }
+
     void SetWebDebuggerMenuItem(IInspectable const &sender, bool const value)
     {
         SetMenuItemText(
@@ -87,24 +108,24 @@ namespace
 
     void InitializeReactRootView(ReactNativeHost const &reactNativeHost,
                                  ReactRootView reactRootView,
-                                 Component const &component)
+                                 ComponentHandle const &component)
     {
         if (reactRootView.ReactNativeHost() == nullptr) {
             reactRootView.ReactNativeHost(reactNativeHost);
         }
 
-        reactRootView.ComponentName(winrt::to_hstring(component.appKey));
-        reactRootView.InitialProps(
-            [initialProps = component.initialProperties](IJSValueWriter const &writer) {
-                if (initialProps.has_value()) {
-                    writer.WriteObjectBegin();
-                    for (auto &[key, value] : initialProps.value()) {
-                        writer.WritePropertyName(winrt::to_hstring(key));
-                        ReactApp::JSValueWriterWriteValue(writer, value);
-                    }
-                    writer.WriteObjectEnd();
+        reactRootView.ComponentName(winrt::to_hstring(component->appKey));
+        reactRootView.InitialProps([component](IJSValueWriter const &writer) {
+            auto &initialProps = component->initialProperties;
+            if (initialProps.has_value()) {
+                writer.WriteObjectBegin();
+                for (auto &[key, value] : initialProps.value()) {
+                    writer.WritePropertyName(winrt::to_hstring(key));
+                    ReactApp::JSValueWriterWriteValue(writer, value);
                 }
-            });
+                writer.WriteObjectEnd();
+            }
+        });
     }
 
     // According to
@@ -129,15 +150,19 @@ MainPage::MainPage()
     reactInstance_.BundleRoot(manifest.bundleRoot.has_value()
                                   ? std::make_optional(to_hstring(manifest.bundleRoot.value()))
                                   : std::nullopt);
+    reactInstance_.EngineConfig(manifest.engine);
 
     if constexpr (kSingleAppMode) {
         assert(manifest.singleApp.has_value() ||
                !"`ENABLE_SINGLE_APP_MODE` shouldn't have been true");
         assert(manifest.components.has_value() || !"At least one component must be declared");
 
-        for (auto &component : *manifest.components) {
-            if (component.slug == *manifest.singleApp) {
-                InitializeReactRootView(reactInstance_.ReactHost(), ReactRootView(), component);
+        // The component menu is not used in single app mode
+        ComponentStore components{std::move(*manifest.components)};
+        for (size_t i = 0; i < components.Size(); ++i) {
+            if (components[i].slug == *manifest.singleApp) {
+                InitializeReactRootView(
+                    reactInstance_.ReactHost(), ReactRootView(), components.Handle(i));
                 break;
             }
         }
@@ -184,6 +209,112 @@ void MainPage::ToggleRememberLastComponent(IInspectable const &sender, RoutedEve
     Session::ShouldRememberLastComponent(item.IsChecked());
 }
 
+void MainPage::FindComponent(IInspectable const &, RoutedEventArgs)
+{
+    ComponentSearchBox().Text({});
+    UpdateComponentSearchResults();
+    FindComponentDialog().ShowAsync();
+}
+
+void MainPage::ComponentSearchBox_TextChanged(IInspectable const &, TextChangedEventArgs const &)
+{
+    UpdateComponentSearchResults();
+}
+
+void MainPage::ComponentList_ItemClick(IInspectable const &, ItemClickEventArgs const &args)
+{
+    uint32_t position = 0;
+    if (!ComponentList().Items().IndexOf(args.ClickedItem(), position) ||
+        position >= searchResults_.size()) {
+        return;
+    }
+
+    // Modal components are presented in another dialog, which cannot be
+    // shown until this one has closed. The handle keeps the component alive
+    // even if components are registered again in the meantime.
+    FindComponentDialog().Hide();
+    CoreApplication::MainView().CoreWindow().Dispatcher().RunAsync(
+        CoreDispatcherPriority::Low, [this, result = searchResults_[position]]() {
+            LoadReactComponent(result.first, result.second);
+        });
+}
+
+void MainPage::FindComponentDialog_Closed(IInspectable const &,
+                                          ContentDialogClosedEventArgs const &)
+{
+    searchResults_.clear();
+    ComponentList().ItemsSource(nullptr);
+}
+
+void MainPage::StartSurfaceStress(IInspectable const &, RoutedEventArgs)
+{
+    SurfaceStressSummary().Text({});
+    SurfaceStressDialog().ShowAsync();
+}
+
+void MainPage::SurfaceStressDialog_Mount(IInspectable const &,
+                                         ContentDialogButtonClickEventArgs const &args)
+{
+    // Keep the dialog open; it hosts the surfaces. A previous run is
+    // discarded rather than finished, since it is being replaced.
+    args.Cancel(true);
+    surfaceStress_ = nullptr;
+    SurfaceGrid().Children().Clear();
+
+    auto const rawValue = SurfaceCount().Value();
+    auto const surfaces = std::isnan(rawValue) || rawValue < 1 ? 0 : static_cast<size_t>(rawValue);
+    if (surfaces == 0 || components_.Size() == 0) {
+        return;
+    }
+
+    // Mount the component currently presented, or the first one
+    size_t index = 0;
+    for (size_t i = 0; i < components_.Size(); ++i) {
+        if (components_[i].slug.value_or(components_[i].appKey) == currentComponent_) {
+            index = i;
+            break;
+        }
+    }
+    auto component = components_.Handle(index);
+
+    SurfaceStressSummary().Text(L"Mounting…");
+    surfaceStress_ = std::make_shared<SurfaceStressTracker>(
+        component->slug.value_or(component->appKey),
+        surfaces,
+        [this, dispatcher = Dispatcher()](SurfaceStressResult const &result) {
+            dispatcher.RunAsync(CoreDispatcherPriority::Normal,
+                                [this, summary = to_hstring(result.ToJSON())]() {
+                                    SurfaceStressSummary().Text(summary);
+                                });
+        });
+
+    auto children = SurfaceGrid().Children();
+    for (size_t i = 0; i < surfaces; ++i) {
+        // Root views are sized by their content, so they only grow once the
+        // component has mounted
+        ReactRootView rootView;
+        rootView.HorizontalAlignment(HorizontalAlignment::Left);
+        rootView.VerticalAlignment(VerticalAlignment::Top);
+        rootView.SizeChanged([tracker = std::weak_ptr{surfaceStress_}, i](
+                                 IInspectable const &, SizeChangedEventArgs const &args) {
+            auto const size = args.NewSize();
+            if (size.Width > 0 && size.Height > 0) {
+                if (auto t = tracker.lock()) {
+                    t->OnMounted(i);
+                }
+            }
+        });
+        InitializeReactRootView(reactInstance_.ReactHost(), rootView, component);
+        children.Append(rootView);
+    }
+}
+
+void MainPage::SurfaceStressDialog_Closed(IInspectable const &,
+                                          ContentDialogClosedEventArgs const &)
+{
+    StopSurfaceStress();
+}
+
 void MainPage::ConfigureBundler(IInspectable const &, RoutedEventArgs)
 {
     auto [host, port] = reactInstance_.BundlerAddress();
@@ -242,6 +373,20 @@ void MainPage::ToggleInspector(IInspectable const &, RoutedEventArgs)
     reactInstance_.ToggleElementInspector();
 }
 
+void MainPage::ToggleSamplingProfiler(IInspectable const &sender, RoutedEventArgs)
+{
+    auto path = reactInstance_.ToggleSamplingProfiler(currentComponent_);
+    SetSamplingProfilerMenuItem(sender, reactInstance_.IsSamplingProfilerRunning());
+    if (path.has_value()) {
+        auto message = L"Profile was written to " + to_hstring(*path);
+        if (!::ReactTestApp::SamplingProfiler::HasSamples(*path)) {
+            message = message + L", but it contains no samples. Sampling does not work while "
+                                L"using the web debugger.";
+        }
+        MessageDialog(message).ShowAsync();
+    }
+}
+
 void MainPage::ToggleWebDebugger(IInspectable const &sender, RoutedEventArgs)
 {
     auto const useWebDebugger = !reactInstance_.UseWebDebugger();
@@ -267,10 +412,52 @@ bool MainPage::LoadJSBundleFrom(JSBundleSource source)
     return true;
 }
 
-void MainPage::LoadReactComponent(Component const &component)
+void MainPage::LoadReactComponent(ComponentHandle const &component)
 {
-    auto title = to_hstring(component.displayName.value_or(component.appKey));
-    auto &&presentationStyle = component.presentationStyle.value_or("");
+    // Only the component requested last is presented, even if an earlier one
+    // is still waiting for its bundle segment
+    auto const request = ++componentRequest_;
+    if (!component->bundleSegment.has_value()) {
+        PresentReactComponent(component);
+        return;
+    }
+
+    reactInstance_.LoadBundleSegment(
+        std::string{*component->bundleSegment},
+        [this, component, request](std::optional<std::string> const &error) {
+            if (request != componentRequest_) {
+                return;
+            }
+            if (error.has_value()) {
+                MessageDialog(to_hstring(*error)).ShowAsync();
+                return;
+            }
+            PresentReactComponent(component);
+        });
+}
+
+void MainPage::LoadReactComponent(size_t index)
+{
+    LoadReactComponent(index, components_.Handle(index));
+}
+
+void MainPage::LoadReactComponent(size_t index, ComponentHandle const &component)
+{
+    LoadReactComponent(component);
+    Session::StoreComponent(static_cast<int>(index), ::ReactApp::GetManifestChecksum());
+}
+
+void MainPage::PresentReactComponent(ComponentHandle const &component)
+{
+    if (!currentComponent_.empty()) {
+        reactInstance_.CheckComponentMemory(currentComponent_);
+    }
+
+    currentComponent_ = component->slug.value_or(component->appKey);
+    ::ReactTestApp::SamplingProfiler::Shared().BeginComponentSession(currentComponent_);
+
+    auto title = to_hstring(component->displayName.value_or(component->appKey));
+    auto &&presentationStyle = component->presentationStyle.value_or("");
     if (presentationStyle == "modal") {
         InitializeReactRootView(reactInstance_.ReactHost(), DialogReactRootView(), component);
         ContentDialog().Title(box_value(title));
@@ -297,6 +484,10 @@ void MainPage::InitializeDebugMenu()
         SetFastRefreshMenuItem(FastRefreshMenuItem(), reactInstance_.UseFastRefresh());
         FastRefreshMenuItem().IsEnabled(reactInstance_.IsFastRefreshAvailable());
 
+        SetSamplingProfilerMenuItem(SamplingProfilerMenuItem(),
+                                    reactInstance_.IsSamplingProfilerRunning());
+        SamplingProfilerMenuItem().IsEnabled(reactInstance_.IsSamplingProfilerAvailable());
+
         DebugMenuBarItem().IsEnabled(true);
     }
 }
@@ -313,17 +504,16 @@ void MainPage::InitializeReactMenu(::ReactApp::Manifest manifest)
             if (!components.has_value() || components->empty()) {
                 reactInstance_.SetComponentsRegisteredDelegate(
                     [this](std::vector<std::string> const &appKeys) {
-                        std::vector<Component> components;
-                        components.reserve(appKeys.size());
-                        std::transform(std::begin(appKeys),
-                                       std::end(appKeys),
-                                       std::back_inserter(components),
-                                       [](std::string const &appKey) { return Component{appKey}; });
-                        OnComponentsRegistered(std::move(components));
+                        // Keep the menu and search index if nothing changed,
+                        // unless the only component needs to be reloaded
+                        auto changes = appKeyTracker_.Update(appKeys);
+                        if (!changes.empty() || appKeys.size() == 1) {
+                            OnComponentsRegistered(ComponentStore{appKeyTracker_.AppKeys()});
+                        }
                         PresentReactMenu();
                     });
             } else {
-                OnComponentsRegistered(std::move(components.value()));
+                OnComponentsRegistered(ComponentStore{std::move(components.value())});
                 reactInstance_.SetComponentsRegisteredDelegate(
                     [this](std::vector<std::string> const &) { PresentReactMenu(); });
             }
@@ -350,7 +540,7 @@ bool MainPage::IsPresenting()
     return !ReactRootView().ComponentName().empty();
 }
 
-void MainPage::OnComponentsRegistered(std::vector<Component> components)
+void MainPage::OnComponentsRegistered(ComponentStore components)
 {
     auto coreDispatcher = CoreApplication::MainView().CoreWindow().Dispatcher();
     if (!coreDispatcher.HasThreadAccess()) {
@@ -364,20 +554,20 @@ void MainPage::OnComponentsRegistered(std::vector<Component> components)
     if (IsLoaded()) {
         // When components are retrieved directly from `AppRegistry`, don't use
         // session data as an invalid index may be stored.
-        if (components.size() == 1) {
+        if (components.Size() == 1) {
             coreDispatcher.RunAsync(
                 CoreDispatcherPriority::Normal,
-                [this, component = components[0]]() { LoadReactComponent(component); });
+                [this, component = components.Handle(0)]() { LoadReactComponent(component); });
         }
     } else {
         // If only one component is present, load it right away. Otherwise,
         // check whether we can reopen a component from previous session.
-        auto index = components.size() == 1
+        auto index = components.Size() == 1
                          ? 0
                          : Session::GetLastOpenedComponent(::ReactApp::GetManifestChecksum());
         if (index.has_value()) {
-            Loaded([this, component = components[index.value()]](IInspectable const &,
-                                                                 RoutedEventArgs const &) {
+            Loaded([this, component = components.Handle(index.value())](IInspectable const &,
+                                                                        RoutedEventArgs const &) {
                 LoadReactComponent(component);
             });
         }
@@ -393,39 +583,40 @@ void MainPage::OnComponentsRegistered(std::vector<Component> components)
         menuItems.RemoveAtEnd();
     }
 
-    auto keyboardAcceleratorKey = VirtualKey::Number1;
-    for (int i = 0; i < static_cast<int>(components.size()); ++i) {
-        auto &component = components[i];
+    components_ = std::move(components);
+
+    // Search results refer to the previous components; if the search dialog
+    // is open, rebuild them for the new ones
+    componentIndex_.reset();
+    if (!searchResults_.empty()) {
+        UpdateComponentSearchResults();
+    }
+
+    auto const menuItemCount = std::min(components_.Size(), kMaxComponentMenuItems);
+    for (size_t i = 0; i < menuItemCount; ++i) {
+        auto &component = components_[i];
 
         MenuFlyoutItem newMenuItem;
         newMenuItem.Text(to_hstring(component.displayName.value_or(component.appKey)));
         newMenuItem.Click(
-            [this, component = std::move(component), i](IInspectable const &, RoutedEventArgs) {
-                LoadReactComponent(component);
-                Session::StoreComponent(i, ::ReactApp::GetManifestChecksum());
-            });
-
-        // Add keyboard accelerator for first nine (1-9) components
-        if (keyboardAcceleratorKey <= VirtualKey::Number9) {
-            auto const num = std::underlying_type_t<VirtualKey>(keyboardAcceleratorKey) -
-                             std::underlying_type_t<VirtualKey>(VirtualKey::Number0);
-            newMenuItem.AccessKey(to_hstring(num));
+            [this, i](IInspectable const &, RoutedEventArgs) { LoadReactComponent(i); });
 
-            KeyboardAccelerator keyboardAccelerator;
-            keyboardAccelerator.Modifiers(VirtualKeyModifiers::Control |
-                                          VirtualKeyModifiers::Shift);
-            keyboardAccelerator.Key(keyboardAcceleratorKey);
+        auto const keyboardAcceleratorKey = static_cast<VirtualKey>(
+            static_cast<int32_t>(VirtualKey::Number1) + static_cast<int32_t>(i));
+        newMenuItem.AccessKey(to_hstring(i + 1));
 
-            newMenuItem.KeyboardAccelerators().Append(keyboardAccelerator);
+        KeyboardAccelerator keyboardAccelerator;
+        keyboardAccelerator.Modifiers(VirtualKeyModifiers::Control | VirtualKeyModifiers::Shift);
+        keyboardAccelerator.Key(keyboardAcceleratorKey);
 
-            keyboardAcceleratorKey =
-                static_cast<VirtualKey>(static_cast<int32_t>(keyboardAcceleratorKey) + 1);
-        }
+        newMenuItem.KeyboardAccelerators().Append(keyboardAccelerator);
 
         menuItems.Append(newMenuItem);
     }
 
-    RememberLastComponentMenuItem().IsEnabled(components.size() > 1);
+    FindComponentMenuItem().IsEnabled(components_.Size() > 1);
+    SurfaceStressMenuItem().IsEnabled(components_.Size() > 0);
+    RememberLastComponentMenuItem().IsEnabled(components_.Size() > 1);
 }
 
 // Adjust height of custom title bar to match close, minimize and maximize icons
@@ -445,3 +636,45 @@ void MainPage::PresentReactMenu()
             }
         });
 }
+
+void MainPage::StopSurfaceStress()
+{
+    // Surfaces that have not mounted yet are reported as such
+    if (surfaceStress_) {
+        surfaceStress_->Finish();
+        surfaceStress_ = nullptr;
+    }
+
+    SurfaceGrid().Children().Clear();
+}
+
+void MainPage::UpdateComponentSearchResults()
+{
+    if (!componentIndex_.has_value()) {
+        std::vector<ComponentIndex::Entry> entries;
+        entries.reserve(components_.Size());
+        for (auto &&component : components_) {
+            entries.push_back({std::string{component.appKey},
+                               std::string{component.displayName.value_or("")},
+                               std::string{component.slug.value_or("")}});
+        }
+        componentIndex_.emplace(std::move(entries));
+    }
+
+    // Results are capped so that the list stays cheap to rebuild on every
+    // keystroke; the list view only realizes the visible items
+    auto const query = to_string(ComponentSearchBox().Text());
+    auto const matches = componentIndex_->Search(query, kMaxSearchResults);
+
+    searchResults_.clear();
+    searchResults_.reserve(matches.size());
+
+    std::vector<IInspectable> items;
+    items.reserve(matches.size());
+    for (auto index : matches) {
+        auto &component = components_[index];
+        searchResults_.emplace_back(index, components_.Handle(index));
+        items.push_back(box_value(to_hstring(component.displayName.value_or(component.appKey))));
+    }
+    ComponentList().ItemsSource(winrt::single_threaded_observable_vector(std::move(items)));
+}
@@ -2,12 +2,19 @@
 
 #include <any>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "AppKeyDiff.h"
+#include "ComponentIndex.h"
+#include "ComponentStore.h"
 #include "MainPage.g.h"
 #include "Manifest.h"
 #include "ReactInstance.h"
+#include "SurfaceStress.h"
 
 namespace winrt::ReactTestApp::implementation
 {
@@ -24,6 +31,26 @@ namespace winrt::ReactTestApp::implementation
         void ToggleRememberLastComponent(Windows::Foundation::IInspectable const &,
                                          Windows::UI::Xaml::RoutedEventArgs);
 
+        void FindComponent(Windows::Foundation::IInspectable const &,
+                           Windows::UI::Xaml::RoutedEventArgs);
+        void ComponentSearchBox_TextChanged(
+            Windows::Foundation::IInspectable const &,
+            Windows::UI::Xaml::Controls::TextChangedEventArgs const &);
+        void ComponentList_ItemClick(Windows::Foundation::IInspectable const &,
+                                     Windows::UI::Xaml::Controls::ItemClickEventArgs const &);
+        void FindComponentDialog_Closed(
+            Windows::Foundation::IInspectable const &,
+            Windows::UI::Xaml::Controls::ContentDialogClosedEventArgs const &);
+
+        void StartSurfaceStress(Windows::Foundation::IInspectable const &,
+                                Windows::UI::Xaml::RoutedEventArgs);
+        void SurfaceStressDialog_Mount(
+            Windows::Foundation::IInspectable const &,
+            Windows::UI::Xaml::Controls::ContentDialogButtonClickEventArgs const &);
+        void SurfaceStressDialog_Closed(
+            Windows::Foundation::IInspectable const &,
+            Windows::UI::Xaml::Controls::ContentDialogClosedEventArgs const &);
+
         // Debug menu
 
         void ConfigureBundler(Windows::Foundation::IInspectable const &,
@@ -44,6 +71,8 @@ namespace winrt::ReactTestApp::implementation
                                Windows::UI::Xaml::RoutedEventArgs);
         void ToggleInspector(Windows::Foundation::IInspectable const &,
                              Windows::UI::Xaml::RoutedEventArgs);
+        void ToggleSamplingProfiler(Windows::Foundation::IInspectable const &,
+                                    Windows::UI::Xaml::RoutedEventArgs);
         void ToggleWebDebugger(Windows::Foundation::IInspectable const &,
                                Windows::UI::Xaml::RoutedEventArgs);
 
@@ -54,6 +83,14 @@ namespace winrt::ReactTestApp::implementation
         using Base = MainPageT;
 
         ::ReactTestApp::ReactInstance reactInstance_;
+        std::string currentComponent_;
+
+        ::ReactTestApp::ComponentStore components_;
+        ::ReactTestApp::AppKeyTracker appKeyTracker_;
+        std::optional<::ReactTestApp::ComponentIndex> componentIndex_;
+        std::vector<std::pair<size_t, ::ReactTestApp::ComponentHandle>> searchResults_;
+        std::shared_ptr<::ReactTestApp::SurfaceStressTracker> surfaceStress_;
+        uint32_t componentRequest_ = 0;
 
         void InitializeDebugMenu();
         void InitializeReactMenu(::ReactApp::Manifest);
@@ -62,15 +99,22 @@ namespace winrt::ReactTestApp::implementation
         bool IsPresenting();
 
         bool LoadJSBundleFrom(::ReactTestApp::JSBundleSource);
-        void LoadReactComponent(::ReactApp::Component const &);
+        void LoadReactComponent(::ReactTestApp::ComponentHandle const &);
+        void LoadReactComponent(size_t index);
+        void LoadReactComponent(size_t index, ::ReactTestApp::ComponentHandle const &);
 
-        void OnComponentsRegistered(std::vector<::ReactApp::Component>);
+        void OnComponentsRegistered(::ReactTestApp::ComponentStore);
 
         void OnCoreTitleBarLayoutMetricsChanged(
             Windows::ApplicationModel::Core::CoreApplicationViewTitleBar const &,
             Windows::Foundation::IInspectable const &);
 
+        void PresentReactComponent(::ReactTestApp::ComponentHandle const &);
         void PresentReactMenu();
+
+        void StopSurfaceStress();
+
+        void UpdateComponentSearchResults();
     };
 }  // namespace winrt::ReactTestApp::implementation
 
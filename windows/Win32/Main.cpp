@@ -2,25 +2,61 @@
 
 #include "Main.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <TraceLoggingProvider.h>
+
+#include "ComponentStore.h"
+#include "ControlServer.h"
+#include "JSON.h"
 #include "JSValueWriterHelper.h"
 #include "Manifest.g.cpp"
+#include "Metrics.h"
+#include "MultiInstance.h"
 #include "ReactInstance.h"
+#include "ReloadStress.h"
+#include "ResizeCoalescer.h"
+#include "SamplingProfiler.h"
+#include "Session.h"
+#include "SurfaceStress.h"
+
+// {d9ab3bd5-cc9f-5843-41eb-ade5ef4341b7}
+TRACELOGGING_DEFINE_PROVIDER(
+    g_traceProvider,
+    "ReactTestApp",
+    (0xd9ab3bd5, 0xcc9f, 0x5843, 0x41, 0xeb, 0xad, 0xe5, 0xef, 0x43, 0x41, 0xb7));
 
 namespace winrt
 {
     using winrt::Microsoft::ReactNative::IJSValueWriter;
     using winrt::Microsoft::ReactNative::LayoutDirection;
     using winrt::Microsoft::ReactNative::ReactCoreInjection;
+    using winrt::Microsoft::ReactNative::ReactNativeHost;
     using winrt::Microsoft::ReactNative::ReactNativeIsland;
     using winrt::Microsoft::ReactNative::ReactViewOptions;
     using winrt::Microsoft::UI::Composition::Compositor;
+    using winrt::Microsoft::UI::Composition::ContainerVisual;
+    using winrt::Microsoft::UI::Composition::Visual;
+    using winrt::Microsoft::UI::Content::ContentIsland;
+    using winrt::Microsoft::UI::Content::ContentIslandStateChangedEventArgs;
     using winrt::Microsoft::UI::Content::ContentSizePolicy;
     using winrt::Microsoft::UI::Content::DesktopChildSiteBridge;
+    using winrt::Microsoft::UI::Dispatching::DispatcherQueue;
     using winrt::Microsoft::UI::Dispatching::DispatcherQueueController;
+    using winrt::Microsoft::UI::Dispatching::DispatcherQueuePriority;
+    using winrt::Microsoft::UI::Input::InputKeyboardSource;
+    using winrt::Microsoft::UI::Input::KeyEventArgs;
     using winrt::Microsoft::UI::Windowing::AppWindow;
     using winrt::Microsoft::UI::Windowing::AppWindowChangedEventArgs;
     using winrt::Microsoft::UI::Windowing::OverlappedPresenter;
     using winrt::Microsoft::UI::Windowing::OverlappedPresenterState;
+    using winrt::Windows::Graphics::RectInt32;
     using winrt::Windows::Foundation::AsyncStatus;
     using winrt::Windows::Foundation::Size;
 }  // namespace winrt
@@ -33,47 +69,737 @@ namespace
     constexpr bool kDebug = false;
 #endif
     constexpr bool kSingleAppMode = static_cast<bool>(ENABLE_SINGLE_APP_MODE);
+    constexpr auto kBundleSource =
+        kDebug ? ReactTestApp::JSBundleSource::DevServer : ReactTestApp::JSBundleSource::Embedded;
 
     float ScaleFactor(HWND hwnd) noexcept
     {
         return GetDpiForWindow(hwnd) / static_cast<float>(USER_DEFAULT_SCREEN_DPI);
     }
 
-    void UpdateRootViewSizeToAppWindow(winrt::ReactNativeIsland const &rootView,
-                                       winrt::AppWindow const &window)
+    void LogReloadStress(ReactTestApp::ReloadStressResult const &result)
+    {
+        auto message = "Reload stress " + std::string{result.Passed() ? "passed" : "failed"} +
+                       ": " + result.ToJSON() + '\n';
+        OutputDebugStringA(message.c_str());
+    }
+
+    void LogMultiInstance(ReactTestApp::MultiInstanceResult const &result)
+    {
+        auto message = "Multi-instance run: " + result.ToJSON() + '\n';
+        OutputDebugStringA(message.c_str());
+    }
+
+    void LogSurfaceStress(ReactTestApp::SurfaceStressResult const &result)
+    {
+        auto message = "Surface stress run: " + result.ToJSON() + '\n';
+        OutputDebugStringA(message.c_str());
+    }
+
+    void ApplyScaleFactor(winrt::ReactNativeIsland const &rootView, float scaleFactor)
+    {
+        auto invScale = 1.0f / scaleFactor;
+        rootView.RootVisual().Scale({invScale, invScale, invScale});
+        rootView.ScaleFactor(scaleFactor);
+    }
+
+    void ArrangeRootView(winrt::ReactNativeIsland const &rootView,
+                         winrt::AppWindow const &window,
+                         ReactTestApp::ResizeCoalescer &resizeCoalescer)
     {
+        auto size = resizeCoalescer.Flush();
+
         // Do not relayout when minimized
         auto windowState = window.Presenter().as<winrt::OverlappedPresenter>().State();
         if (windowState == winrt::OverlappedPresenterState::Minimized) {
+            resizeCoalescer.Reset();
             return;
         }
 
-        auto hwnd = winrt::Microsoft::UI::GetWindowFromWindowId(window.Id());
-        auto scaleFactor = ScaleFactor(hwnd);
-        winrt::Size size{window.ClientSize().Width / scaleFactor,
-                         window.ClientSize().Height / scaleFactor};
-        rootView.Arrange({size, size, winrt::LayoutDirection::Undefined}, {0, 0});
+        if (size.has_value()) {
+            winrt::Size layoutSize{size->width, size->height};
+            rootView.Arrange({layoutSize, layoutSize, winrt::LayoutDirection::Undefined}, {0, 0});
+        }
     }
 
-    winrt::ReactViewOptions MakeReactViewOptions(ReactApp::Component const &component)
+    winrt::ReactViewOptions MakeReactViewOptions(ReactTestApp::ComponentHandle const &component)
     {
         winrt::ReactViewOptions viewOptions;
-        viewOptions.ComponentName(winrt::to_hstring(component.appKey));
-
-        auto initialProps = component.initialProperties.value_or<ReactApp::JSONObject>({});
-        initialProps["concurrentRoot"] = true;
-        viewOptions.InitialProps(
-            [initialProps = std::move(initialProps)](winrt::IJSValueWriter const &writer) {
-                writer.WriteObjectBegin();
-                for (auto &[key, value] : initialProps) {
-                    writer.WritePropertyName(winrt::to_hstring(key));
-                    ReactApp::JSValueWriterWriteValue(writer, value);
+        viewOptions.ComponentName(winrt::to_hstring(component->appKey));
+
+        // `concurrentRoot` is written separately so that the initial
+        // properties can be shared rather than copied
+        viewOptions.InitialProps([component](winrt::IJSValueWriter const &writer) {
+            constexpr std::string_view kConcurrentRoot = "concurrentRoot";
+            writer.WriteObjectBegin();
+            if (auto &initialProps = component->initialProperties; initialProps.has_value()) {
+                for (auto &[key, value] : *initialProps) {
+                    if (key != kConcurrentRoot) {
+                        writer.WritePropertyName(winrt::to_hstring(key));
+                        ReactApp::JSValueWriterWriteValue(writer, value);
+                    }
                 }
-                writer.WriteObjectEnd();
-            });
+            }
+            writer.WritePropertyName(winrt::to_hstring(kConcurrentRoot));
+            writer.WriteBoolean(true);
+            writer.WriteObjectEnd();
+        });
 
         return viewOptions;
     }
+
+    /**
+     * Presents components in a single `ReactNativeIsland`. Switching between
+     * components only replaces the view host; the island, compositor and
+     * content bridge are reused. Must be used on the UI thread.
+     */
+    class ComponentPresenter
+    {
+    public:
+        ComponentPresenter(winrt::ReactNativeIsland rootView,
+                           ReactTestApp::ReactInstance &instance,
+                           ReactTestApp::ComponentStore components)
+            : rootView_(std::move(rootView)), instance_(instance),
+              components_(std::move(components))
+        {
+        }
+
+        ComponentPresenter(ComponentPresenter const &) = delete;
+        ComponentPresenter &operator=(ComponentPresenter const &) = delete;
+
+        auto const &Components() const
+        {
+            return components_;
+        }
+
+        auto LastSwitchDuration() const
+        {
+            return std::chrono::microseconds{lastSwitchDuration_.load()};
+        }
+
+        /**
+         * Presents the component at `index`, once its bundle segment, if any,
+         * has been loaded. Only the component requested last is presented.
+         */
+        bool Present(size_t index)
+        {
+            if (index >= components_.Size()) {
+                return false;
+            }
+
+            auto component = components_.Handle(index);
+            auto const request = ++request_;
+            if (!component->bundleSegment.has_value()) {
+                Show(component, index);
+                return true;
+            }
+
+            instance_.LoadBundleSegment(
+                std::string{*component->bundleSegment},
+                [this, component, index, request](std::optional<std::string> error) {
+                    // `request_` is only touched on the UI thread
+                    RunOnUIThread([this, component, index, request, error = std::move(error)]() {
+                        if (request != request_) {
+                            return;
+                        }
+                        if (error.has_value()) {
+                            auto message = "Failed to load bundle segment: " + *error + '\n';
+                            OutputDebugStringA(message.c_str());
+                            return;
+                        }
+                        Show(component, index);
+                    });
+                });
+            return true;
+        }
+
+        bool Present(std::string_view slug)
+        {
+            for (size_t i = 0; i < components_.Size(); ++i) {
+                if (components_[i].slug == slug) {
+                    return Present(i);
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Presents the component opened in the previous session, or the first
+         * one if there is nothing to restore. Sessions are only remembered
+         * when enabled, e.g. by setting `REACT_TEST_APP_REMEMBER_LAST_COMPONENT`
+         * to 1 or through the `rememberLastComponent` setting of the control
+         * channel.
+         */
+        void RestoreSession()
+        {
+            char value[2];
+            if (GetEnvironmentVariableA("REACT_TEST_APP_REMEMBER_LAST_COMPONENT", value, 2) == 1) {
+                ReactTestApp::Session::ShouldRememberLastComponent(value[0] == '1');
+            }
+
+            auto index = ReactTestApp::Session::GetLastOpenedComponent(
+                ReactApp::GetManifestChecksum());
+            if (!index.has_value() || !Present(static_cast<size_t>(*index))) {
+                Present(size_t{0});
+            }
+        }
+
+    private:
+        void Show(ReactTestApp::ComponentHandle const &component, size_t index)
+        {
+            if (!currentComponent_.empty()) {
+                instance_.CheckComponentMemory(currentComponent_);
+            }
+
+            currentComponent_ = component->slug.value_or(component->appKey);
+            ReactTestApp::SamplingProfiler::Shared().BeginComponentSession(currentComponent_);
+
+            // A switch that has not mounted yet is superseded by this one
+            pendingSwitch_ = PendingSwitch{std::string{component->appKey},
+                                           index,
+                                           std::chrono::steady_clock::now(),
+                                           MountedVisual(),
+                                           ++switch_};
+
+            rootView_.ReactViewHost(winrt::ReactCoreInjection::MakeViewHost(
+                instance_.ReactHost(), MakeReactViewOptions(component)));
+            WaitForMount(switch_);
+
+            if constexpr (!kSingleAppMode) {
+                ReactTestApp::Session::StoreComponent(static_cast<int>(index),
+                                                      ReactApp::GetManifestChecksum());
+            }
+        }
+
+        template <typename F>
+        void RunOnUIThread(F &&f)
+        {
+            if (dispatcherQueue_.HasThreadAccess()) {
+                f();
+            } else {
+                dispatcherQueue_.TryEnqueue(std::forward<F>(f));
+            }
+        }
+
+        /**
+         * Returns the visual of the component mounted in the island, if any.
+         * Fabric adds it to the island's root visual once the component has
+         * mounted, and removes it when the component is torn down.
+         */
+        winrt::Visual MountedVisual() const
+        {
+            auto container = rootView_.RootVisual().try_as<winrt::ContainerVisual>();
+            if (!container || container.Children().Count() == 0) {
+                return nullptr;
+            }
+            return container.Children().First().Current();
+        }
+
+        /**
+         * Checks after every frame whether the component of switch `id` has
+         * mounted. Unlike `SizeChanged`, this also works when the component
+         * is laid out at the same size as the one it replaces.
+         */
+        void WaitForMount(uint32_t id)
+        {
+            rootView_.RootVisual().Compositor().RequestCommitAsync().Completed(
+                [this, id](auto &&, auto &&) {
+                    dispatcherQueue_.TryEnqueue([this, id]() {
+                        if (!pendingSwitch_.has_value() || pendingSwitch_->id != id) {
+                            return;
+                        }
+
+                        auto visual = MountedVisual();
+                        if (visual && visual != pendingSwitch_->previousVisual) {
+                            OnMounted();
+                        } else if (std::chrono::steady_clock::now() - pendingSwitch_->start <
+                                   kMountTimeout) {
+                            WaitForMount(id);
+                        } else {
+                            pendingSwitch_.reset();
+                        }
+                    });
+                });
+        }
+
+        void OnMounted()
+        {
+            auto const pending = *std::exchange(pendingSwitch_, std::nullopt);
+            auto const duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - pending.start);
+            lastSwitchDuration_ = duration.count();
+            switchDurations_.Record(static_cast<uint64_t>(duration.count()));
+            TraceLoggingWrite(g_traceProvider,
+                              "ComponentSwitch",
+                              TraceLoggingString(pending.appKey.c_str(), "AppKey"),
+                              TraceLoggingUInt64(pending.index, "Index"),
+                              TraceLoggingInt64(duration.count(), "DurationMicroseconds"));
+        }
+
+        // Switches that take longer than this are not recorded, e.g. when
+        // the component failed to render
+        static constexpr auto kMountTimeout = std::chrono::seconds{30};
+
+        struct PendingSwitch {
+            std::string appKey;
+            size_t index;
+            std::chrono::steady_clock::time_point start;
+            winrt::Visual previousVisual;
+            uint32_t id;
+        };
+
+        winrt::ReactNativeIsland rootView_;
+        ReactTestApp::ReactInstance &instance_;
+        ReactTestApp::ComponentStore components_;
+        winrt::DispatcherQueue dispatcherQueue_ = winrt::DispatcherQueue::GetForCurrentThread();
+        std::string currentComponent_;
+        std::optional<PendingSwitch> pendingSwitch_;
+        uint32_t request_ = 0;
+        uint32_t switch_ = 0;
+        std::atomic<int64_t> lastSwitchDuration_ = 0;
+        ReactTestApp::HistogramMetric switchDurations_ =
+            ReactTestApp::Metrics::Shared().GetHistogram("componentSwitchMicroseconds");
+    };
+
+    /**
+     * Mounts one component on many `ReactNativeIsland`s at once, laid out in
+     * a grid in a window of its own. The islands share the compositor and the
+     * instance of the main window. The grid stays up after the run so that
+     * the result can be inspected, until it is stopped or replaced.
+     */
+    class SurfaceStressRunner
+    {
+    public:
+        SurfaceStressRunner(winrt::Compositor compositor,
+                            ReactTestApp::ReactInstance const &instance,
+                            ComponentPresenter const &presenter)
+            : compositor_(std::move(compositor)), instance_(instance), presenter_(presenter)
+        {
+        }
+
+        SurfaceStressRunner(SurfaceStressRunner const &) = delete;
+        SurfaceStressRunner &operator=(SurfaceStressRunner const &) = delete;
+
+        ~SurfaceStressRunner()
+        {
+            Stop();
+        }
+
+        /**
+         * Returns whether a run is in progress. Like `LastResult()`, this may
+         * be called from any thread, e.g. by the control server.
+         */
+        bool IsRunning() const
+        {
+            std::lock_guard<std::mutex> lock(status_->mutex);
+            return status_->running;
+        }
+
+        std::string LastResult() const
+        {
+            std::lock_guard<std::mutex> lock(status_->mutex);
+            return status_->lastResult;
+        }
+
+        /**
+         * Returns the index of the component matching `component` by slug or
+         * app key, or the first component if `component` is empty.
+         */
+        std::optional<size_t> FindComponent(std::string_view component) const
+        {
+            auto &components = presenter_.Components();
+            if (component.empty()) {
+                return components.Size() > 0 ? std::make_optional(size_t{0}) : std::nullopt;
+            }
+
+            for (size_t i = 0; i < components.Size(); ++i) {
+                if (components[i].slug == component || components[i].appKey == component) {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * Replaces the current grid, if any, with a new one. Must be called
+         * on the UI thread.
+         */
+        bool Start(ReactTestApp::SurfaceStressOptions const &options)
+        {
+            auto index = FindComponent(options.component);
+            if (!index.has_value() || options.surfaces == 0) {
+                return false;
+            }
+
+            Stop();
+
+            auto component = presenter_.Components().Handle(*index);
+            auto columns = static_cast<int32_t>(
+                std::ceil(std::sqrt(static_cast<double>(options.surfaces))));
+            auto rows = (static_cast<int32_t>(options.surfaces) + columns - 1) / columns;
+
+            window_ = winrt::AppWindow::Create();
+            window_.Title(L"Surface stress: " + winrt::to_hstring(component->appKey));
+            window_.Resize({kCellSize * columns, kCellSize * rows});
+            window_.Show();
+            window_.Destroying([this](auto &&, auto &&) {
+                window_ = nullptr;
+                Stop();
+            });
+
+            auto hwnd = winrt::Microsoft::UI::GetWindowFromWindowId(window_.Id());
+            auto scaleFactor = ScaleFactor(hwnd);
+            auto cellSize = static_cast<float>(kCellSize) / scaleFactor;
+
+            // Create the tracker last so that window creation is not measured.
+            // It reports back through `status_`, which also tells the control
+            // server whether a run is in progress.
+            auto status = status_;
+            {
+                std::lock_guard<std::mutex> lock(status->mutex);
+                status->running = true;
+            }
+            tracker_ = std::make_shared<ReactTestApp::SurfaceStressTracker>(
+                component->slug.value_or(component->appKey),
+                options.surfaces,
+                [status](ReactTestApp::SurfaceStressResult const &result) {
+                    LogSurfaceStress(result);
+                    std::lock_guard<std::mutex> lock(status->mutex);
+                    status->running = false;
+                    status->lastResult = result.ToJSON();
+                });
+
+            surfaces_.reserve(options.surfaces);
+            for (size_t i = 0; i < options.surfaces; ++i) {
+                auto island = winrt::ReactNativeIsland{compositor_};
+                ApplyScaleFactor(island, scaleFactor);
+
+                // The island is resized once the component has been laid out
+                // for the first time
+                island.SizeChanged([tracker = std::weak_ptr{tracker_}, i](auto &&, auto &&) {
+                    if (auto t = tracker.lock()) {
+                        t->OnMounted(i);
+                    }
+                });
+                island.ReactViewHost(winrt::ReactCoreInjection::MakeViewHost(
+                    instance_.ReactHost(), MakeReactViewOptions(component)));
+
+                auto bridge = winrt::DesktopChildSiteBridge::Create(compositor_, window_.Id());
+                bridge.Connect(island.Island());
+                auto column = static_cast<int32_t>(i) % columns;
+                auto row = static_cast<int32_t>(i) / columns;
+                bridge.MoveAndResize(
+                    winrt::RectInt32{column * kCellSize, row * kCellSize, kCellSize, kCellSize});
+
+                winrt::Size size{cellSize, cellSize};
+                island.Arrange({size, size, winrt::LayoutDirection::Undefined}, {0, 0});
+                bridge.Show();
+
+                surfaces_.push_back({std::move(island), std::move(bridge)});
+            }
+
+            return true;
+        }
+
+        /**
+         * Ends the current run, if any, and closes the grid. Surfaces that
+         * have not mounted yet are reported as such. Must be called on the UI
+         * thread.
+         */
+        void Stop()
+        {
+            if (tracker_) {
+                tracker_->Finish();
+                tracker_ = nullptr;
+            }
+
+            for (auto &&surface : surfaces_) {
+                surface.bridge.Close();
+                surface.island.ReactViewHost(nullptr);
+            }
+            surfaces_.clear();
+
+            if (auto window = std::exchange(window_, nullptr)) {
+                window.Destroy();
+            }
+        }
+
+    private:
+        // Size of each surface, in physical pixels
+        static constexpr int32_t kCellSize = 200;
+
+        struct Surface {
+            winrt::ReactNativeIsland island;
+            winrt::DesktopChildSiteBridge bridge;
+        };
+
+        // Shared with the tracker's completion and read by the control
+        // server, which runs on threads of its own
+        struct Status {
+            std::mutex mutex;
+            bool running = false;
+            std::string lastResult = "null";
+        };
+
+        winrt::Compositor compositor_;
+        ReactTestApp::ReactInstance const &instance_;
+        ComponentPresenter const &presenter_;
+        winrt::AppWindow window_{nullptr};
+        std::vector<Surface> surfaces_;
+        std::shared_ptr<ReactTestApp::SurfaceStressTracker> tracker_;
+        std::shared_ptr<Status> status_ = std::make_shared<Status>();
+    };
+
+    /**
+     * Starts the additional instances of multi-instance mode. They load the
+     * same bundle as the main instance, but present nothing. Each one keeps
+     * its settings, including the dev server address, in a namespace of its
+     * own.
+     */
+    std::vector<std::unique_ptr<ReactTestApp::ReactInstance>>
+    StartAdditionalInstances(ReactTestApp::MultiInstanceOptions const &options,
+                             ReactTestApp::MultiInstanceTracker &tracker,
+                             ReactApp::Manifest const &manifest)
+    {
+        std::vector<std::unique_ptr<ReactTestApp::ReactInstance>> instances;
+        for (size_t i = 1; i < options.instances; ++i) {
+            auto &instance =
+                instances.emplace_back(std::make_unique<ReactTestApp::ReactInstance>());
+            instance->SettingsNamespace(L"Instance" + winrt::to_hstring(i));
+            if (manifest.bundleRoot.has_value()) {
+                instance->BundleRoot(std::make_optional(winrt::to_hstring(*manifest.bundleRoot)));
+            }
+            instance->EngineConfig(manifest.engine);
+
+            if (i <= options.bundlerPorts.size() && options.bundlerPorts[i - 1] > 0) {
+                auto [host, port] = instance->BundlerAddress();
+                instance->BundlerAddress(host, options.bundlerPorts[i - 1]);
+            }
+
+            instance->SetComponentsRegisteredDelegate(
+                [&tracker, i](std::vector<std::string> const &appKeys) {
+                    tracker.OnLoaded(i, appKeys);
+                });
+            if (!instance->LoadJSBundleFrom(kBundleSource)) {
+                tracker.OnFailed(i, "Failed to load the JS bundle");
+            }
+        }
+        return instances;
+    }
+
+    /**
+     * Starts the control channel if `REACT_TEST_APP_CONTROL_CHANNEL` is set to
+     * the name of a pipe, e.g. `\\.\pipe\ReactTestApp`.
+     */
+    std::unique_ptr<ReactTestApp::ControlServer>
+    StartControlServer(ReactTestApp::ReactInstance &instance,
+                       ComponentPresenter &presenter,
+                       SurfaceStressRunner &surfaceStress,
+                       winrt::DispatcherQueue const &dispatcherQueue)
+    {
+        char address[MAX_PATH];
+        auto length = GetEnvironmentVariableA("REACT_TEST_APP_CONTROL_CHANNEL", address, MAX_PATH);
+        if (length == 0 || length >= MAX_PATH) {
+            return nullptr;
+        }
+
+        using ReactTestApp::ControlRequest;
+        using ReactTestApp::ControlResponse;
+        using ReactTestApp::ReactInstance;
+
+        auto server = std::make_unique<ReactTestApp::ControlServer>(std::string{address, length});
+
+        server->On("components", [&presenter](ControlRequest const &) {
+            std::string result{"["};
+            for (auto &&component : presenter.Components()) {
+                if (result.size() > 1) {
+                    result += ',';
+                }
+                result += "{\"appKey\":";
+                ReactTestApp::AppendJSONString(result, component.appKey);
+                result += ",\"slug\":";
+                if (component.slug.has_value()) {
+                    ReactTestApp::AppendJSONString(result, *component.slug);
+                } else {
+                    result += "null";
+                }
+                result += '}';
+            }
+            result += ']';
+            return ControlResponse::Success(std::move(result));
+        });
+
+        server->On("load", [&presenter, dispatcherQueue](ControlRequest const &request) {
+            auto slug = std::string{request.Param("slug")};
+            auto &components = presenter.Components();
+            if (std::none_of(components.begin(), components.end(), [&slug](auto &&component) {
+                    return component.slug == slug;
+                })) {
+                return ControlResponse::Failure("No component with slug: " + slug);
+            }
+
+            dispatcherQueue.TryEnqueue([&presenter, slug]() { presenter.Present(slug); });
+            return ControlResponse::Success();
+        });
+
+        server->On("reload", [&instance, dispatcherQueue](ControlRequest const &) {
+            dispatcherQueue.TryEnqueue([&instance]() { instance.Reload(); });
+            return ControlResponse::Success();
+        });
+
+        using Setter = void (*)(ReactInstance &, bool);
+        static std::map<std::string_view, Setter> const setters = {
+            {"breakOnFirstLine", [](ReactInstance &i, bool value) { i.BreakOnFirstLine(value); }},
+            {"rememberLastComponent",
+             [](ReactInstance &, bool value) {
+                 ReactTestApp::Session::ShouldRememberLastComponent(value);
+             }},
+            {"useDirectDebugger", [](ReactInstance &i, bool value) { i.UseDirectDebugger(value); }},
+            {"useFastRefresh", [](ReactInstance &i, bool value) { i.UseFastRefresh(value); }},
+            {"useWebDebugger", [](ReactInstance &i, bool value) { i.UseWebDebugger(value); }},
+        };
+        server->On("setting", [&instance, dispatcherQueue](ControlRequest const &request) {
+            auto name = request.Param("name");
+            auto setter = setters.find(name);
+            if (setter == setters.end()) {
+                return ControlResponse::Failure("Unknown setting: " + std::string{name});
+            }
+
+            auto value = request.Param("value") == "true";
+            dispatcherQueue.TryEnqueue(
+                [&instance, set = setter->second, value]() { set(instance, value); });
+            return ControlResponse::Success();
+        });
+
+        server->On("profiler", [](ControlRequest const &request) {
+            auto &profiler = ReactTestApp::SamplingProfiler::Shared();
+            auto action = request.Param("action");
+            if (action == "start") {
+                if (!profiler.Start(request.Param("label"))) {
+                    return ControlResponse::Failure(profiler.IsRunning()
+                                                        ? "Sampling profiler is already running"
+                                                        : "Sampling profiler is unavailable");
+                }
+                return ControlResponse::Success();
+            }
+
+            if (action == "stop") {
+                auto path = profiler.Stop();
+                if (!path.has_value()) {
+                    return ControlResponse::Failure("Sampling profiler is not running");
+                }
+
+                std::string result = "{\"path\":";
+                ReactTestApp::AppendJSONString(result, *path);
+                result += ",\"sampled\":";
+                result += ReactTestApp::SamplingProfiler::HasSamples(*path) ? "true" : "false";
+                result += '}';
+                return ControlResponse::Success(std::move(result));
+            }
+
+            return ControlResponse::Failure("Unknown action: " + std::string{action});
+        });
+
+        struct ReloadStressStatus {
+            std::mutex mutex;
+            std::string lastResult = "null";
+        };
+        auto reloadStressStatus = std::make_shared<ReloadStressStatus>();
+        server->On("reloadStress", [&instance, dispatcherQueue, status = reloadStressStatus](
+                                       ControlRequest const &request) {
+            auto action = request.Param("action");
+            if (action == "start") {
+                ReactTestApp::ReloadStressOptions options;
+                auto parse = [&request](std::string_view name, long long fallback) {
+                    auto value = std::string{request.Param(name)};
+                    char *end = nullptr;
+                    auto number = std::strtoll(value.c_str(), &end, 10);
+                    return value.empty() || *end != '\0' || number < 0 ? fallback : number;
+                };
+                options.iterations = static_cast<int>(parse("iterations", options.iterations));
+                options.objectTolerance = parse("objects", options.objectTolerance);
+                options.memoryTolerance =
+                    static_cast<double>(parse(
+                        "memory", static_cast<long long>(options.memoryTolerance * 100))) /
+                    100.0;
+                if (options.iterations == 0) {
+                    return ControlResponse::Failure("Iterations must be greater than zero");
+                }
+
+                dispatcherQueue.TryEnqueue([&instance, options, status]() {
+                    instance.StartReloadStress(
+                        options, [status](ReactTestApp::ReloadStressResult const &result) {
+                            LogReloadStress(result);
+                            std::lock_guard<std::mutex> lock(status->mutex);
+                            status->lastResult = result.ToJSON();
+                        });
+                });
+                return ControlResponse::Success();
+            }
+
+            if (action == "status") {
+                std::lock_guard<std::mutex> lock(status->mutex);
+                return ControlResponse::Success(
+                    "{\"running\":" +
+                    std::string{instance.IsReloadStressRunning() ? "true" : "false"} +
+                    ",\"lastResult\":" + status->lastResult + "}");
+            }
+
+            return ControlResponse::Failure("Unknown action: " + std::string{action});
+        });
+
+        server->On("surfaceStress", [&surfaceStress, dispatcherQueue](
+                                        ControlRequest const &request) {
+            auto action = request.Param("action");
+            if (action == "start") {
+                ReactTestApp::SurfaceStressOptions options;
+                options.component = std::string{request.Param("component")};
+                if (auto surfaces = std::string{request.Param("surfaces")}; !surfaces.empty()) {
+                    char *end = nullptr;
+                    auto number = std::strtoll(surfaces.c_str(), &end, 10);
+                    if (*end != '\0' || number <= 0) {
+                        return ControlResponse::Failure("Surfaces must be greater than zero");
+                    }
+                    options.surfaces = static_cast<size_t>(number);
+                }
+                if (!surfaceStress.FindComponent(options.component).has_value()) {
+                    return ControlResponse::Failure("No component with slug or app key: " +
+                                                    options.component);
+                }
+
+                dispatcherQueue.TryEnqueue(
+                    [&surfaceStress, options]() { surfaceStress.Start(options); });
+                return ControlResponse::Success();
+            }
+
+            if (action == "stop") {
+                dispatcherQueue.TryEnqueue([&surfaceStress]() { surfaceStress.Stop(); });
+                return ControlResponse::Success();
+            }
+
+            if (action == "status") {
+                return ControlResponse::Success(
+                    "{\"running\":" +
+                    std::string{surfaceStress.IsRunning() ? "true" : "false"} +
+                    ",\"lastResult\":" + surfaceStress.LastResult() + "}");
+            }
+
+            return ControlResponse::Failure("Unknown action: " + std::string{action});
+        });
+
+        server->On("metrics", [&presenter](ControlRequest const &) {
+            return ControlResponse::Success(
+                "{\"componentSwitchMicroseconds\":" +
+                std::to_string(presenter.LastSwitchDuration().count()) +
+                ",\"registry\":" + ReactTestApp::Metrics::Shared().Snapshot().ToJSON() + "}");
+        });
+
+        if (!server->Start()) {
+            return nullptr;
+        }
+
+        return server;
+    }
 }  // namespace
 
 _Use_decl_annotations_ int CALLBACK WinMain(HINSTANCE /* instance */,
@@ -88,6 +814,8 @@ _Use_decl_annotations_ int CALLBACK WinMain(HINSTANCE /* instance */,
     // Initialize WinRT.
     winrt::init_apartment(winrt::apartment_type::single_threaded);
 
+    TraceLoggingRegister(g_traceProvider);
+
     // Enable per monitor DPI scaling
     SetProcessDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
 
@@ -111,45 +839,107 @@ _Use_decl_annotations_ int CALLBACK WinMain(HINSTANCE /* instance */,
         auto &bundleRoot = *manifest.bundleRoot;
         instance.BundleRoot(std::make_optional(winrt::to_hstring(bundleRoot)));
     }
+    instance.EngineConfig(manifest.engine);
+
+    // In multi-instance mode, measure how long it takes for all instances to
+    // load and how much memory each of them adds
+    std::unique_ptr<ReactTestApp::MultiInstanceTracker> multiInstance;
+    auto multiInstanceOptions = ReactTestApp::MultiInstanceOptions::FromEnvironment();
+    if (multiInstanceOptions.has_value()) {
+        multiInstance = std::make_unique<ReactTestApp::MultiInstanceTracker>(
+            multiInstanceOptions->instances, LogMultiInstance);
+        instance.SetComponentsRegisteredDelegate(
+            [tracker = multiInstance.get()](std::vector<std::string> const &appKeys) {
+                tracker->OnLoaded(0, appKeys);
+            });
+    }
 
     // Start the react-native instance, which will create a JavaScript runtime and load the
     // applications bundle
-    if constexpr (kDebug) {
-        instance.LoadJSBundleFrom(ReactTestApp::JSBundleSource::DevServer);
-    } else {
-        instance.LoadJSBundleFrom(ReactTestApp::JSBundleSource::Embedded);
+    if (!instance.LoadJSBundleFrom(kBundleSource) && multiInstance) {
+        multiInstance->OnFailed(0, "Failed to load the JS bundle");
+    }
+
+    std::vector<std::unique_ptr<ReactTestApp::ReactInstance>> additionalInstances;
+    if (multiInstance) {
+        additionalInstances =
+            StartAdditionalInstances(*multiInstanceOptions, *multiInstance, manifest);
     }
 
     // Create a RootView which will present a react-native component
-    winrt::ReactViewOptions viewOptions;
+    auto rootView = winrt::ReactNativeIsland{compositor};
+    auto presenter = ComponentPresenter{
+        rootView, instance, ReactTestApp::ComponentStore{std::move(*manifest.components)}};
     if constexpr (kSingleAppMode) {
         assert(manifest.singleApp.has_value() ||
                !"`ENABLE_SINGLE_APP_MODE` shouldn't have been true");
+        presenter.Present(*manifest.singleApp);
+    } else {
+        presenter.RestoreSession();
 
-        for (auto &component : *manifest.components) {
-            if (component.slug == *manifest.singleApp) {
-                viewOptions = MakeReactViewOptions(component);
-                break;
+        // Switch between the first nine components with Ctrl+Shift+[1-9]
+        auto keyboardSource = winrt::InputKeyboardSource::GetForIsland(rootView.Island());
+        keyboardSource.KeyDown([&presenter](winrt::InputKeyboardSource const &,
+                                            winrt::KeyEventArgs const &args) {
+            if (GetKeyState(VK_CONTROL) >= 0 || GetKeyState(VK_SHIFT) >= 0) {
+                return;
             }
-        }
-    } else {
-        // TODO: Implement session restoration
-        auto &component = (*manifest.components)[0];
-        viewOptions = MakeReactViewOptions(component);
+
+            auto const key = static_cast<int32_t>(args.VirtualKey());
+            if (key >= '1' && key <= '9') {
+                args.Handled(presenter.Present(static_cast<size_t>(key - '1')));
+            }
+        });
     }
 
-    auto rootView = winrt::ReactNativeIsland{compositor};
-    rootView.ReactViewHost(
-        winrt::ReactCoreInjection::MakeViewHost(instance.ReactHost(), viewOptions));
-
-    // Update the size of the RootView when the AppWindow changes size
-    window.Changed(
-        [wkRootView = winrt::make_weak(rootView)](winrt::AppWindow const &window,
-                                                  winrt::AppWindowChangedEventArgs const &args) {
-            if (args.DidSizeChange() || args.DidVisibilityChange()) {
-                if (auto rootView = wkRootView.get()) {
-                    UpdateRootViewSizeToAppWindow(rootView, window);
-                }
+    // Update the size of the RootView when the AppWindow changes size. Changes are coalesced so
+    // that the RootView is arranged at most once per compositor frame.
+    auto resizeCoalescer = ReactTestApp::ResizeCoalescer{scaleFactor};
+    auto requestArrange = [&resizeCoalescer,
+                           &compositor,
+                           &window,
+                           dispatcherQueue = dispatcherQueueController.DispatcherQueue(),
+                           wkRootView = winrt::make_weak(rootView)]() {
+        compositor.RequestCommitAsync().Completed([&resizeCoalescer,
+                                                   &window,
+                                                   dispatcherQueue,
+                                                   wkRootView](auto &&, auto &&) {
+            dispatcherQueue.TryEnqueue(winrt::DispatcherQueuePriority::High,
+                                       [&resizeCoalescer, &window, wkRootView]() {
+                                           if (auto rootView = wkRootView.get()) {
+                                               ArrangeRootView(rootView, window, resizeCoalescer);
+                                           }
+                                       });
+        });
+    };
+
+    window.Changed([&resizeCoalescer, requestArrange](
+                       winrt::AppWindow const &window,
+                       winrt::AppWindowChangedEventArgs const &args) {
+        if (args.DidSizeChange() || args.DidVisibilityChange()) {
+            auto clientSize = window.ClientSize();
+            if (resizeCoalescer.Resize(static_cast<float>(clientSize.Width),
+                                       static_cast<float>(clientSize.Height))) {
+                requestArrange();
+            }
+        }
+    });
+
+    // Only query the scale factor again when the DPI actually changes
+    rootView.Island().StateChanged(
+        [&resizeCoalescer, requestArrange, wkRootView = winrt::make_weak(rootView)](
+            winrt::ContentIsland const &island,
+            winrt::ContentIslandStateChangedEventArgs const &args) {
+            if (!args.DidRasterizationScaleChange()) {
+                return;
+            }
+
+            auto scaleFactor = island.RasterizationScale();
+            if (auto rootView = wkRootView.get()) {
+                ApplyScaleFactor(rootView, scaleFactor);
+            }
+            if (resizeCoalescer.Rescale(scaleFactor)) {
+                requestArrange();
             }
         });
 
@@ -170,26 +960,45 @@ _Use_decl_annotations_ int CALLBACK WinMain(HINSTANCE /* instance */,
     bridge.Connect(rootView.Island());
     bridge.ResizePolicy(winrt::ContentSizePolicy::ResizeContentToParentWindow);
 
-    auto invScale = 1.0f / scaleFactor;
-    rootView.RootVisual().Scale({invScale, invScale, invScale});
-    rootView.ScaleFactor(scaleFactor);
+    ApplyScaleFactor(rootView, scaleFactor);
 
     // Set the intialSize of the root view
-    UpdateRootViewSizeToAppWindow(rootView, window);
+    auto clientSize = window.ClientSize();
+    resizeCoalescer.Resize(static_cast<float>(clientSize.Width),
+                           static_cast<float>(clientSize.Height));
+    ArrangeRootView(rootView, window, resizeCoalescer);
 
     bridge.Show();
 
+    auto surfaceStress = SurfaceStressRunner{compositor, instance, presenter};
+    auto controlServer = StartControlServer(
+        instance, presenter, surfaceStress, dispatcherQueueController.DispatcherQueue());
+
+    if (auto options = ReactTestApp::SurfaceStressOptions::FromEnvironment()) {
+        surfaceStress.Start(*options);
+    }
+
+    if (auto options = ReactTestApp::ReloadStressOptions::FromEnvironment()) {
+        instance.StartReloadStress(*options, LogReloadStress);
+    }
+
     // Run the main application event loop
     dispatcherQueueController.DispatcherQueue().RunEventLoop();
 
+    // Stop accepting commands before tearing down the objects they operate on
+    controlServer = nullptr;
+
     // Rundown the DispatcherQueue. This drains the queue and raises events to let components
     // know the message loop has finished.
     dispatcherQueueController.ShutdownQueue();
 
+    surfaceStress.Stop();
     bridge.Close();
     bridge = nullptr;
 
     // Destroy all Composition objects
     compositor.Close();
     compositor = nullptr;
+
+    TraceLoggingUnregister(g_traceProvider);
 }